@@ -10,7 +10,11 @@
 #include "GameFramework/PlayerStart.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Components/SceneCaptureComponent2D.h"
+#include "Components/LineBatchComponent.h"
 #include "LevelStreaming/LevelStreamingProcedural.h"
+#include "Data/FunctionLibraries/LevelLayoutCacheLibrary.h"
+#include "Data/LevelGenerationTrace.h"
+#include "Subsystems/LevelPreGenerationSubsystem.h"
 #include "GameModes/SciFiGameModeBase.h"
 #include "Actors/ActorSlots/ActorSlot_Door.h"
 #include "Actors/Interactables/InteractableActor_Base.h"
@@ -44,6 +48,10 @@ AProceduralLevelGenerationActor::AProceduralLevelGenerationActor()
 	MinimapOpacityMaskSceneCapture->ProjectionType = ECameraProjectionMode::Orthographic;
 	MinimapOpacityMaskSceneCapture->OrthoWidth = 600.f;
 	MinimapOpacityMaskSceneCapture->PrimitiveRenderMode = ESceneCapturePrimitiveRenderMode::PRM_UseShowOnlyList;
+
+	DebugLineBatcher = CreateDefaultSubobject<ULineBatchComponent>(TEXT("Debug Line Batcher"));
+	DebugLineBatcher->SetupAttachment(RootComponent);
+	DebugLineBatcher->bHiddenInSceneCapture = true;
 }
 
 // Called when the game starts or when spawned
@@ -55,11 +63,28 @@ void AProceduralLevelGenerationActor::BeginPlay()
 
 	PreloadLevels();
 
-	ULevelGenerationLibrary::GenerateLevel(LevelGenerationSettings, GeneratedLevelData, GetWorld());
+	ULevelPreGenerationSubsystem* PreGenerationSubsystem = GetGameInstance() ? GetGameInstance()->GetSubsystem<ULevelPreGenerationSubsystem>() : nullptr;
 
-	PopulateLevel();
+	// A level generated in the background while the previous one was played skips straight to populating the level
+	if (PreGenerationSubsystem && PreGenerationSubsystem->TakePreGeneratedLevel(LevelGenerationSettings, GeneratedLevelData))
+	{
+		OnLevelGenerated();
+	}
+	else if (LevelGenerationSettings.bGenerateLevelAsync)
+	{
+		GenerateLevelAsync();
+	}
+	else if (LevelGenerationSettings.bTimeSliceGeneration)
+	{
+		GenerateLevelTimeSliced();
+	}
+	else
+	{
+		// A cached layout skips straight to populating the level
+		ULevelLayoutCacheLibrary::GenerateOrLoadLevel(LevelGenerationSettings, GeneratedLevelData, GetWorld());
 
-	SetupElevators();
+		OnLevelGenerated();
+	}
 	
 	MinimapSceneCapture->ShowOnlyActors.Add(this);
 	MinimapOpacityMaskSceneCapture->ShowOnlyActors.Add(this);
@@ -73,11 +98,27 @@ void AProceduralLevelGenerationActor::BeginPlay()
 	}
 }
 
+void AProceduralLevelGenerationActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// The task stops within a room or a few path nodes and keeps its data tables referenced until then, its result is ignored once the actor is gone
+	if (LevelGenerationTask.IsValid())
+	{
+		LevelGenerationTask->Cancel();
+		LevelGenerationTask.Reset();
+	}
+
+	LevelGenerationStepState.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 // Called every frame
 void AProceduralLevelGenerationActor::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	if (LevelGenerationStepState.IsValid()) { TickLevelGeneration(); }
+
 	// Update the transform of the minimap player marker
 	if (APlayerController* PC = GetWorld()->GetFirstPlayerController())
 	{
@@ -125,9 +166,27 @@ void AProceduralLevelGenerationActor::Tick(float DeltaTime)
 	}
 }
 
+void AProceduralLevelGenerationActor::CancelLevelGeneration()
+{
+	if (LevelGenerationTask.IsValid()) { LevelGenerationTask->Cancel(); }
+
+	// The time sliced generation stops on its next tick
+	if (LevelGenerationStepState.IsValid() && GeneratedLevelData.Progress.IsValid()) { GeneratedLevelData.Progress->Cancel(); }
+}
+
+float AProceduralLevelGenerationActor::GetLevelGenerationProgress() const
+{
+	if (LevelGenerationTask.IsValid()) { return LevelGenerationTask->GetProgress(); }
+	if (LevelGenerationStepState.IsValid() && GeneratedLevelData.Progress.IsValid()) { return GeneratedLevelData.Progress->GetProgress(); }
+
+	return bLevelGenerated ? 1.f : 0.f;
+}
+
 void AProceduralLevelGenerationActor::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
 	GetLevelGenerationSettings();
+
+	RefreshDebugDrawing();
 }
 
 TArray<FName> AProceduralLevelGenerationActor::GetSelectedLevelGenerationSettings() const
@@ -142,6 +201,21 @@ TArray<FName> AProceduralLevelGenerationActor::GetSelectedLevelGenerationSetting
 	return TArray<FName>();
 }
 
+void AProceduralLevelGenerationActor::SetDebugDrawingEnabled(bool bEnabled)
+{
+	bDebugDrawingEnabled = bEnabled;
+
+	if (bDebugDrawingEnabled) { RefreshDebugDrawing(); }
+	else { ULevelGenerationDebugLibrary::ClearDebugLines(DebugLineBatcher); }
+}
+
+void AProceduralLevelGenerationActor::RefreshDebugDrawing()
+{
+	if (!bDebugDrawingEnabled) { return; }
+
+	ULevelGenerationDebugLibrary::DrawDebugLines(DebugLineBatcher, LevelGenerationSettings, GeneratedLevelData, DebugDrawOptions);
+}
+
 void AProceduralLevelGenerationActor::GetLevelGenerationSettings()
 {
 	FLevelGenerationSettings* LevelGenerationSettingsPtr = nullptr;
@@ -342,34 +416,244 @@ void AProceduralLevelGenerationActor::PreloadLevels()
 	}
 }
 
-void AProceduralLevelGenerationActor::PopulateLevel()
+void AProceduralLevelGenerationActor::GenerateLevelAsync()
+{
+	// Levels with a random seed are never cached
+	const bool bUseLayoutCache = LevelGenerationSettings.bUseLayoutCache && LevelGenerationSettings.bUsePlayerSeed;
+
+	if (bUseLayoutCache && ULevelLayoutCacheLibrary::LoadCachedLayout(LevelGenerationSettings, GeneratedLevelData))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("AProceduralLevelGenerationActor::GenerateLevelAsync Level loaded from the layout cache!"));
+		OnLevelGenerated();
+		return;
+	}
+
+	LevelGenerationTask = MakeShared<FLevelGenerationTask>(LevelGenerationSettings);
+
+	// Stream the rooms in once they are placed and each corridor as it is added, instead of waiting for the whole level
+	if (LevelGenerationSettings.bPipelineLevelStreaming)
+	{
+		const FOnLevelGenerationTilesReady OnTilesReady = FOnLevelGenerationTilesReady::CreateUObject(this, &AProceduralLevelGenerationActor::OnPipelinedTilesReady);
+		LevelGenerationTask->SetOnTilesReady(OnTilesReady, OnTilesReady);
+	}
+
+	LevelGenerationTask->Start(FOnLevelGenerationTaskComplete::CreateUObject(this, &AProceduralLevelGenerationActor::OnLevelGenerationTaskComplete));
+}
+
+void AProceduralLevelGenerationActor::GenerateLevelTimeSliced()
+{
+	// Levels with a random seed are never cached
+	const bool bUseLayoutCache = LevelGenerationSettings.bUseLayoutCache && LevelGenerationSettings.bUsePlayerSeed;
+
+	if (bUseLayoutCache && ULevelLayoutCacheLibrary::LoadCachedLayout(LevelGenerationSettings, GeneratedLevelData))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("AProceduralLevelGenerationActor::GenerateLevelTimeSliced Level loaded from the layout cache!"));
+		OnLevelGenerated();
+		return;
+	}
+
+	GeneratedLevelData.Progress = MakeShared<FLevelGenerationProgress>();
+	LevelGenerationStepState = MakeUnique<FLevelGenerationStepState>();
+}
+
+void AProceduralLevelGenerationActor::TickLevelGeneration()
+{
+	const bool bLevelGenerated = ULevelGenerationLibrary::TickLevelGeneration(LevelGenerationSettings, GeneratedLevelData, *LevelGenerationStepState, LevelGenerationSettings.GenerationFrameBudgetMs, LevelGenerationSettings.PathExpansionsPerStep);
+
+	if (GeneratedLevelData.IsGenerationCancelled())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("AProceduralLevelGenerationActor::TickLevelGeneration Level generation cancelled!"));
+		LevelGenerationStepState.Reset();
+		GeneratedLevelData.Progress.Reset();
+		return;
+	}
+
+	if (!bLevelGenerated) { return; }
+
+	LevelGenerationStepState.Reset();
+	GeneratedLevelData.Progress.Reset();
+
+	if (LevelGenerationSettings.bUseLayoutCache && LevelGenerationSettings.bUsePlayerSeed) { ULevelLayoutCacheLibrary::SaveCachedLayout(LevelGenerationSettings, GeneratedLevelData); }
+
+	OnLevelGenerated();
+}
+
+void AProceduralLevelGenerationActor::OnLevelGenerationTaskComplete(TSharedRef<FLevelGenerationTask> CompletedTask)
+{
+	// Ignore tasks that were cancelled or replaced
+	if (LevelGenerationTask != CompletedTask) { return; }
+
+	LevelGenerationTask.Reset();
+
+	if (!CompletedTask->IsCompleted())
+	{
+		RemovePipelinedTiles();
+		return;
+	}
+
+	GeneratedLevelData = CompletedTask->TakeGeneratedLevelData();
+
+	if (LevelGenerationSettings.bUseLayoutCache && LevelGenerationSettings.bUsePlayerSeed) { ULevelLayoutCacheLibrary::SaveCachedLayout(LevelGenerationSettings, GeneratedLevelData); }
+
+	OnLevelGenerated();
+}
+
+void AProceduralLevelGenerationActor::OnPipelinedTilesReady(TSharedRef<FLevelGenerationTask> GeneratingTask, const FLevelGenerationTiles& Tiles)
+{
+	// Ignore tasks that were cancelled or replaced
+	if (LevelGenerationTask != GeneratingTask) { return; }
+
+	for (const TPair<FIntVector, FTileInstanceData>& CurrentTile : Tiles.Tiles)
+	{
+		StreamPipelinedTile(CurrentTile.Key, CurrentTile.Value, Tiles.TileTemplates);
+	}
+}
+
+void AProceduralLevelGenerationActor::StreamPipelinedTile(const FIntVector& Coordinate, FTileInstanceData TileInstance, const TSharedRef<FTileTemplateRegistry>& TileTemplates)
+{
+	const FTileTemplate* Template = TileTemplates->GetTemplate(TileInstance.TemplateId);
+	if (!Template) { return; }
+
+	if (const FPipelinedTileInstances* PipelinedTile = PipelinedTiles.Find(Coordinate))
+	{
+		// A later corridor joining this one can change its piece, otherwise the tile is already streaming
+		if (PipelinedTile->TileMap == Template->TileMap && PipelinedTile->TileSubMaps == Template->TileSubMaps && PipelinedTile->TileRotation.Equals(TileInstance.TileRotation)) { return; }
+
+		RemovePipelinedTile(Coordinate);
+	}
+
+	// Actor slot maps wait for the generated level, doors depend on which access points the corridors use
+	ULevelStreamingProcedural* BaseLevelInstance = CreateProceduralLevelInstance(Coordinate, TileInstance, TileTemplates, Template->TileMap);
+
+	// The tile is streamed in with the rest of the level once it is generated
+	if (!BaseLevelInstance) { return; }
+
+	FPipelinedTileInstances& NewPipelinedTile = PipelinedTiles.Add(Coordinate);
+	NewPipelinedTile.TileMap = Template->TileMap;
+	NewPipelinedTile.TileSubMaps = Template->TileSubMaps;
+	NewPipelinedTile.TileRotation = TileInstance.TileRotation;
+	NewPipelinedTile.BaseLevelInstance = BaseLevelInstance;
+	NewPipelinedTile.LevelInstances.Add(BaseLevelInstance);
+
+	for (TSoftObjectPtr<UWorld> CurrentSubMap : Template->TileSubMaps)
+	{
+		NewPipelinedTile.LevelInstances.Add(CreateProceduralLevelInstance(Coordinate, TileInstance, TileTemplates, CurrentSubMap));
+	}
+}
+
+bool AProceduralLevelGenerationActor::AdoptPipelinedTile(const FIntVector& Coordinate, FTileInstanceData& TileInstance)
+{
+	FPipelinedTileInstances* PipelinedTile = PipelinedTiles.Find(Coordinate);
+
+	if (!PipelinedTile) { return false; }
+
+	const FTileTemplate* Template = GeneratedLevelData.GetTileTemplate(TileInstance);
+
+	if (!Template || !PipelinedTile->BaseLevelInstance || PipelinedTile->TileMap != Template->TileMap || PipelinedTile->TileSubMaps != Template->TileSubMaps || !PipelinedTile->TileRotation.Equals(TileInstance.TileRotation))
+	{
+		RemovePipelinedTile(Coordinate);
+		return false;
+	}
+
+	TileInstance.LevelInstanceRef = PipelinedTile->BaseLevelInstance;
+
+	// The instances were streamed with the templates of the generating level, they now read the generated level's
+	for (ULevelStreamingProcedural* CurrentLevelInstance : PipelinedTile->LevelInstances)
+	{
+		if (!CurrentLevelInstance) { continue; }
+
+		CurrentLevelInstance->LevelTileInstance = TileInstance;
+		CurrentLevelInstance->TileTemplates = GeneratedLevelData.TileTemplates;
+	}
+
+	PipelinedTiles.Remove(Coordinate);
+	return true;
+}
+
+void AProceduralLevelGenerationActor::RemovePipelinedTile(const FIntVector& Coordinate)
+{
+	FPipelinedTileInstances PipelinedTile;
+
+	if (!PipelinedTiles.RemoveAndCopyValue(Coordinate, PipelinedTile)) { return; }
+
+	for (ULevelStreamingProcedural* CurrentLevelInstance : PipelinedTile.LevelInstances)
+	{
+		if (!CurrentLevelInstance) { continue; }
+
+		LevelsLeftToLoad.Remove(CurrentLevelInstance);
+		CurrentLevelInstance->OnProceduralLevelLoaded.RemoveAll(this);
+		CurrentLevelInstance->SetIsRequestingUnloadAndRemoval(true);
+	}
+}
+
+void AProceduralLevelGenerationActor::RemovePipelinedTiles()
 {
 	TArray<FIntVector> CoordinateArray;
-	GeneratedLevelData.LevelTileData.GenerateKeyArray(CoordinateArray);
+	PipelinedTiles.GenerateKeyArray(CoordinateArray);
+
+	for (const FIntVector& CurrentCoordinate : CoordinateArray)
+	{
+		RemovePipelinedTile(CurrentCoordinate);
+	}
+}
+
+void AProceduralLevelGenerationActor::OnLevelGenerated()
+{
+	bLevelGenerated = true;
+
+	PopulateLevel();
+
+	SetupElevators();
+
+	// Display the MST + extra paths in the game session
+	if (LevelGenerationSettings.bDrawMST) { SetDebugDrawingEnabled(true); }
 
-	for (FIntVector CurrentCoordinate : CoordinateArray)
+	// Generate the levels that follow this one while it is played
+	if (ULevelPreGenerationSubsystem* PreGenerationSubsystem = GetGameInstance() ? GetGameInstance()->GetSubsystem<ULevelPreGenerationSubsystem>() : nullptr)
 	{
-		if (GeneratedLevelData.LevelTileData[CurrentCoordinate].TileType == ETileType::Room_Section) { continue; }
+		PreGenerationSubsystem->PreGenerateNextLevels(LevelGenerationSettings);
+	}
+}
+
+void AProceduralLevelGenerationActor::PopulateLevel()
+{
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_PopulateLevel);
 
-		FTileData& RoomTileData = GeneratedLevelData.LevelTileData[CurrentCoordinate];
+	bool bAdoptedPipelinedTiles = false;
 
-		// Create instance for the base map
-		CreateProceduralLevelInstance(CurrentCoordinate, RoomTileData, RoomTileData.TileMap);
+	for (TPair<FIntVector, FTileInstanceData>& CurrentTile : GeneratedLevelData.LevelTileData)
+	{
+		const FIntVector CurrentCoordinate = CurrentTile.Key;
+		FTileInstanceData& RoomTileInstance = CurrentTile.Value;
 
-		// Create instances for submaps
-		for (TSoftObjectPtr<UWorld> CurrentSubMap : GeneratedLevelData.LevelTileData[CurrentCoordinate].TileSubMaps)
+		const FTileTemplate* RoomTemplate = GeneratedLevelData.GetTileTemplate(RoomTileInstance);
+		if (!RoomTemplate || RoomTemplate->TileType == ETileType::Room_Section) { continue; }
+
+		// Keep the instances streamed in while the level was generating if the tile has not changed since
+		if (AdoptPipelinedTile(CurrentCoordinate, RoomTileInstance))
 		{
-			CreateProceduralLevelInstance(CurrentCoordinate, RoomTileData, CurrentSubMap);
+			bAdoptedPipelinedTiles = true;
+		}
+		else
+		{
+			// Create instance for the base map
+			CreateProceduralLevelInstance(CurrentCoordinate, RoomTileInstance, GeneratedLevelData.TileTemplates, RoomTemplate->TileMap);
+
+			// Create instances for submaps
+			for (TSoftObjectPtr<UWorld> CurrentSubMap : RoomTemplate->TileSubMaps)
+			{
+				CreateProceduralLevelInstance(CurrentCoordinate, RoomTileInstance, GeneratedLevelData.TileTemplates, CurrentSubMap);
+			}
 		}
 
 		// Create instances for actor slot maps
 		TArray<EActorSlotType> ActorSlotTypeArray;
-		RoomTileData.TileActorSlotMaps.GenerateKeyArray(ActorSlotTypeArray);
+		RoomTemplate->TileActorSlotMaps.GenerateKeyArray(ActorSlotTypeArray);
 
 		for (EActorSlotType CurrentActorSlotType : ActorSlotTypeArray)
 		{
-			TSoftObjectPtr<UWorld> CurrentActorSlotMap = RoomTileData.TileActorSlotMaps[CurrentActorSlotType];
-			CreateProceduralLevelInstance(CurrentCoordinate, RoomTileData, CurrentActorSlotMap, CurrentActorSlotType);
+			TSoftObjectPtr<UWorld> CurrentActorSlotMap = RoomTemplate->TileActorSlotMaps[CurrentActorSlotType];
+			CreateProceduralLevelInstance(CurrentCoordinate, RoomTileInstance, GeneratedLevelData.TileTemplates, CurrentActorSlotMap, CurrentActorSlotType);
 		}
 
 		/*
@@ -411,34 +695,43 @@ void AProceduralLevelGenerationActor::PopulateLevel()
 		}
 		*/
 	}
+
+	// Tiles streamed in while the level was generating that are not part of the generated level
+	RemovePipelinedTiles();
+
 	bLevelWaitingToLoad = true;
+
+	// Every level streamed in while the level was generating may have finished loading already
+	if (bAdoptedPipelinedTiles && LevelsLeftToLoad.IsEmpty()) { OnProceduralLevelLoaded(nullptr); }
 }
 
 void AProceduralLevelGenerationActor::BuildMinimap()
 {
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_BuildMinimap);
+
 	float MinimapGridSize = LevelGenerationSettings.TileSize * LevelGenerationSettings.MinimapScale;
 
 	// Build the minimap in a location that won't collide with the generated level
 	MinimapLocation->SetWorldLocation(FVector(MinimapGridSize * .5f, MinimapGridSize * .5f, -(LevelGenerationSettings.TileSize* LevelGenerationSettings.GridSize.Z)));
 
-	TArray<FIntVector> CoordinateArray;
-	GeneratedLevelData.LevelTileData.GenerateKeyArray(CoordinateArray);
-
 	// Build minimap rooms
-	for (FIntVector CurrentCoordinate : CoordinateArray)
+	for (const TPair<FIntVector, FTileInstanceData>& CurrentTile : GeneratedLevelData.LevelTileData)
 	{
+		const FTileTemplate* RoomTemplate = GeneratedLevelData.GetTileTemplate(CurrentTile.Value);
+		if (!RoomTemplate) { continue; }
+
 		// Create static mesh component
 		const FString MeshString = "MinimapMesh_Room_" + FString::FromInt(LevelMinimap.Num());
 		
-		UStaticMeshComponent* CurrentMinimapMesh = CreateMinimapMesh(GeneratedLevelData.LevelTileData[CurrentCoordinate].MinimapMesh, MeshString);
+		UStaticMeshComponent* CurrentMinimapMesh = CreateMinimapMesh(RoomTemplate->MinimapMesh, MeshString);
 		if (!CurrentMinimapMesh) { continue; }
 
 		FMinimapInfo_Room CurrentMinimapRoomInfo;
 		CurrentMinimapRoomInfo.MinimapMesh = CurrentMinimapMesh;
-		CurrentMinimapRoomInfo.RoomRotation = GeneratedLevelData.LevelTileData[CurrentCoordinate].TileRotation;
+		CurrentMinimapRoomInfo.RoomRotation = CurrentTile.Value.TileRotation;
 
 		// Add to minimap room array
-		LevelMinimap.Add(CurrentCoordinate, CurrentMinimapRoomInfo);
+		LevelMinimap.Add(CurrentTile.Key, CurrentMinimapRoomInfo);
 	}
 
 	TArray<FIntVector> MinimapCoordinateArray;
@@ -493,22 +786,20 @@ void AProceduralLevelGenerationActor::SetupElevators()
 {
 	UWorld* WorldRef = GetWorld();
 
-	TArray<FIntVector> LevelPathDataKeyArray;
-	GeneratedLevelData.LevelPathData.GenerateKeyArray(LevelPathDataKeyArray);
-
 	TArray<FIntVector> ElevatorBottomArray;
 	TArray<FIntVector> ElevatorTopArray;
 
 	// Get All Elevator bottom pieces
-	for (FIntVector CurrentCoordinate : LevelPathDataKeyArray)
+	for (const TPair<FIntVector, FCorridorTileData>& CurrentPath : GeneratedLevelData.LevelPathData)
 	{
-		const FCorridorTileData CurrentData = GeneratedLevelData.LevelPathData[CurrentCoordinate];
+		const FIntVector CurrentCoordinate = CurrentPath.Key;
+		const FCorridorTileData& CurrentData = CurrentPath.Value;
 
 		if (((uint8)CurrentData.SpecialPathType >= (uint8)ESpecialPathType::Elevator_S2) && ((uint8)CurrentData.SpecialPathType < (uint8)ESpecialPathType::MAX))
 		{
 			const FIntVector ElevatorTopCoordinate = CurrentCoordinate + CurrentData.ParentPathNode.SpecialPathInfo.ExitVector;
 
-			if (LevelPathDataKeyArray.Contains(ElevatorTopCoordinate))
+			if (GeneratedLevelData.ContainsPath(ElevatorTopCoordinate))
 			{
 				ElevatorBottomArray.Add(CurrentCoordinate);
 				ElevatorTopArray.Add(ElevatorTopCoordinate);
@@ -521,10 +812,13 @@ void AProceduralLevelGenerationActor::SetupElevators()
 		const FIntVector BottomCoordinate = ElevatorBottomArray[i];
 		const FIntVector TopCoordinate = ElevatorTopArray[i];
 
-		if (ULevelStreamingProcedural* ElevatorBottomLevelInstance = GeneratedLevelData.LevelTileData[BottomCoordinate].LevelInstanceRef)
+		const FTileInstanceData* ElevatorBottomTileInstance = GeneratedLevelData.FindTile(BottomCoordinate);
+		if (!ElevatorBottomTileInstance || !GeneratedLevelData.FindTile(TopCoordinate)) { continue; }
+
+		if (ULevelStreamingProcedural* ElevatorBottomLevelInstance = ElevatorBottomTileInstance->LevelInstanceRef)
 		{
 			ElevatorBottomLevelInstance->ElevatorBottomInfo.ElevationLevels = TopCoordinate.Z - BottomCoordinate.Z;
-			ElevatorBottomLevelInstance->ElevatorBottomInfo.ElevatorTopTileData = GeneratedLevelData.LevelTileData[TopCoordinate];
+			GeneratedLevelData.GetTileData(TopCoordinate, ElevatorBottomLevelInstance->ElevatorBottomInfo.ElevatorTopTileData);
 			ElevatorBottomLevelInstance->OnElevatorBottomLoaded.AddDynamic(this, &AProceduralLevelGenerationActor::OnElevatorBottomLoaded);
 		}
 	}
@@ -532,6 +826,8 @@ void AProceduralLevelGenerationActor::SetupElevators()
 
 void AProceduralLevelGenerationActor::SetupDoors(ULevel* LoadedLevel, FTileData InLevelTileData)
 {
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_SetupDoors);
+
 	// Get all the door slots in the loaded level
 	TArray<AActorSlot_Door*> DoorSlots;
 	if (LoadedLevel)
@@ -725,11 +1021,11 @@ void AProceduralLevelGenerationActor::LoadLevel(const FName& LevelName)
 	}
 }
 
-void AProceduralLevelGenerationActor::CreateProceduralLevelInstance(FIntVector CurrentCoordinate, FTileData& RoomTileData, TSoftObjectPtr<UWorld> MapToInstance, EActorSlotType MapSlotType)
+ULevelStreamingProcedural* AProceduralLevelGenerationActor::CreateProceduralLevelInstance(FIntVector CurrentCoordinate, FTileInstanceData& RoomTileInstance, const TSharedPtr<const FTileTemplateRegistry>& TileTemplates, TSoftObjectPtr<UWorld> MapToInstance, EActorSlotType MapSlotType)
 {
 	const FName RoomName = FName(MapToInstance.GetAssetName());
 	const FName RoomFullPackageName = FName(MapToInstance.GetLongPackageName());
-	const FRotator RoomRotation = RoomTileData.TileRotation;
+	const FRotator RoomRotation = RoomTileInstance.TileRotation;
 	const FVector RoomLocation = (FVector)CurrentCoordinate * LevelGenerationSettings.TileSize;
 
 	ULevelStreaming* StreamingLevel = nullptr;
@@ -739,11 +1035,14 @@ void AProceduralLevelGenerationActor::CreateProceduralLevelInstance(FIntVector C
 		StreamingLevel = LoadedLevelMap[RoomFullPackageName];
 	}
 
-	if (!StreamingLevel) { return; }
+	if (!StreamingLevel) { return nullptr; }
 
 	FString InstanceName = "[" + FString::FromInt(CurrentCoordinate.X) + "x" + FString::FromInt(CurrentCoordinate.Y) + "x" + FString::FromInt(CurrentCoordinate.Z) + "] ";
 	InstanceName.Append(RoomName.ToString());
 
+	// A replaced instance keeps its name until the world removes it
+	if (LevelGenerationSettings.bPipelineLevelStreaming) { InstanceName.Append("_" + FString::FromInt(PipelinedInstanceCount++)); }
+
 	ULevelStreamingProcedural* ProceduralLevelInstance = nullptr;
 	ProceduralLevelInstance = ProceduralLevelInstance->CreateProceduralInstance(GetWorld(), StreamingLevel, InstanceName);
 
@@ -755,12 +1054,17 @@ void AProceduralLevelGenerationActor::CreateProceduralLevelInstance(FIntVector C
 		ProceduralLevelInstance->SetShouldBeLoaded(true);
 		ProceduralLevelInstance->SetShouldBeVisible(true);
 
-		if (MapToInstance == RoomTileData.TileMap)
+		const FTileTemplate* RoomTemplate = TileTemplates.IsValid() ? TileTemplates->GetTemplate(RoomTileInstance.TemplateId) : nullptr;
+
+		if (RoomTemplate && MapToInstance == RoomTemplate->TileMap)
 		{
-			RoomTileData.LevelInstanceRef = ProceduralLevelInstance;
+			RoomTileInstance.LevelInstanceRef = ProceduralLevelInstance;
 		}
 
-		ProceduralLevelInstance->LevelTileData = RoomTileData;
+		// The level only keeps the tile's own state, its shared data stays in the template registry
+		ProceduralLevelInstance->LevelTileInstance = RoomTileInstance;
+		ProceduralLevelInstance->TileTemplates = TileTemplates;
+
 		switch (MapSlotType)
 		{
 		case EActorSlotType::Door:
@@ -780,6 +1084,8 @@ void AProceduralLevelGenerationActor::CreateProceduralLevelInstance(FIntVector C
 	{
 		UE_LOG(LogTemp, Error, TEXT("ULevelGenerationLibrary::PopulateLevel LevelInstance is nullptr!"));
 	}
+
+	return ProceduralLevelInstance;
 }
 
 UStaticMeshComponent* AProceduralLevelGenerationActor::CreateMinimapMesh(UStaticMesh* MinimapMesh, const FString MeshName, const TArray<FName> MeshTags)
@@ -0,0 +1,212 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/LevelGenerationBatchCommandlet.h"
+#include "Data/FunctionLibraries/LevelGenerationLibrary.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+ULevelGenerationBatchCommandlet::ULevelGenerationBatchCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 ULevelGenerationBatchCommandlet::Main(const FString& Params)
+{
+	// Step 1. Read the settings and the seed range from the command line.
+	FString SettingsTablePath;
+	FString SettingsProfile;
+	int32 FirstSeed = 0;
+	int32 SeedCount = 100;
+	int32 WorkerCount = FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1);
+	FString ReportPath = FPaths::ProjectSavedDir() / TEXT("LevelGeneration") / TEXT("BatchReport");
+
+	FParse::Value(*Params, TEXT("Settings="), SettingsTablePath);
+	FParse::Value(*Params, TEXT("Profile="), SettingsProfile);
+	FParse::Value(*Params, TEXT("FirstSeed="), FirstSeed);
+	FParse::Value(*Params, TEXT("SeedCount="), SeedCount);
+	FParse::Value(*Params, TEXT("Workers="), WorkerCount);
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+	const UDataTable* SettingsTable = SettingsTablePath.IsEmpty() ? nullptr : LoadObject<UDataTable>(nullptr, *SettingsTablePath);
+	if (!SettingsTable)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ULevelGenerationBatchCommandlet::Main Could not load the settings data table '%s'! Usage: -run=LevelGenerationBatch -Settings=<DataTablePath> -Profile=<RowName> [-FirstSeed=0] [-SeedCount=100] [-Workers=N] [-Report=<PathWithoutExtension>]"), *SettingsTablePath);
+		return 1;
+	}
+
+	static const FString ContextString(TEXT("LevelGenerationBatchCommandlet"));
+	const FLevelGenerationSettings* SettingsRow = SettingsTable->FindRow<FLevelGenerationSettings>(FName(*SettingsProfile), ContextString, true);
+	if (!SettingsRow) { return 1; }
+
+	SeedCount = FMath::Max(SeedCount, 0);
+	WorkerCount = FMath::Max(WorkerCount, 1);
+
+	UE_LOG(LogTemp, Display, TEXT("ULevelGenerationBatchCommandlet::Main Generating %d levels from seed %d with %d workers"), SeedCount, FirstSeed, WorkerCount);
+
+	// Step 2. Generate the levels in batches of one level per worker.
+	TArray<FLevelGenerationBatchResult> Results;
+	Results.Reserve(SeedCount);
+
+	const double BatchStartTime = FPlatformTime::Seconds();
+
+	for (int32 BatchStart = 0; BatchStart < SeedCount; BatchStart += WorkerCount)
+	{
+		const int32 BatchSize = FMath::Min(WorkerCount, SeedCount - BatchStart);
+
+		TArray<FLevelGenerationSettings> BatchSettings;
+		BatchSettings.Init(*SettingsRow, BatchSize);
+
+		TArray<FGeneratedLevelData> BatchLevels;
+		BatchLevels.SetNum(BatchSize);
+
+		TArray<FLevelGenerationBatchResult> BatchResults;
+		BatchResults.SetNum(BatchSize);
+
+		// The special path data is loaded on the game thread
+		for (int32 i = 0; i < BatchSize; i++)
+		{
+			BatchSettings[i].bUsePlayerSeed = true;
+			BatchSettings[i].LevelUserSeed = FirstSeed + BatchStart + i;
+			BatchSettings[i].bUseLayoutCache = false;
+
+			const double PrepareStartTime = FPlatformTime::Seconds();
+			ULevelGenerationLibrary::PrepareLevelGeneration(BatchSettings[i], BatchLevels[i]);
+			BatchResults[i].PrepareTime = FPlatformTime::Seconds() - PrepareStartTime;
+		}
+
+		ParallelFor(BatchSize, [&](int32 i)
+			{
+				const double GenerationStartTime = FPlatformTime::Seconds();
+				const bool bCompleted = ULevelGenerationLibrary::RunLevelGeneration(BatchSettings[i], BatchLevels[i]);
+				const double GenerationTime = FPlatformTime::Seconds() - GenerationStartTime;
+
+				const double PrepareTime = BatchResults[i].PrepareTime;
+				BatchResults[i] = MakeResult(BatchSettings[i], BatchLevels[i], bCompleted);
+				BatchResults[i].PrepareTime = PrepareTime;
+				BatchResults[i].GenerationTime = GenerationTime;
+			});
+
+		Results.Append(MoveTemp(BatchResults));
+
+		UE_LOG(LogTemp, Display, TEXT("ULevelGenerationBatchCommandlet::Main %d of %d levels generated"), Results.Num(), SeedCount);
+	}
+
+	// Step 3. Write the reports and summarise the batch.
+	const bool bCsvWritten = WriteCsvReport(ReportPath + TEXT(".csv"), Results);
+	const bool bJsonWritten = WriteJsonReport(ReportPath + TEXT(".json"), Results);
+
+	if (!bCsvWritten || !bJsonWritten)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ULevelGenerationBatchCommandlet::Main Could not write the reports to '%s'!"), *ReportPath);
+		return 1;
+	}
+
+	int32 FailedSeeds = 0;
+	const FLevelGenerationBatchResult* SlowestResult = nullptr;
+
+	for (const FLevelGenerationBatchResult& CurrentResult : Results)
+	{
+		if (!CurrentResult.IsClean()) { FailedSeeds++; }
+		if (!SlowestResult || CurrentResult.GenerationTime > SlowestResult->GenerationTime) { SlowestResult = &CurrentResult; }
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("ULevelGenerationBatchCommandlet::Main %d levels generated in %.2fs, %d with unplaced rooms or unbuilt corridors. Reports written to %s.csv/.json"), Results.Num(), FPlatformTime::Seconds() - BatchStartTime, FailedSeeds, *ReportPath);
+
+	if (SlowestResult)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ULevelGenerationBatchCommandlet::Main Slowest seed %d took %.2fms"), SlowestResult->Seed, SlowestResult->GenerationTime * 1000.0);
+	}
+
+	return 0;
+}
+
+FLevelGenerationBatchResult ULevelGenerationBatchCommandlet::MakeResult(const FLevelGenerationSettings& LevelGenerationSettings, const FGeneratedLevelData& GeneratedLevelData, bool bCompleted)
+{
+	FLevelGenerationBatchResult Result;
+	Result.Seed = LevelGenerationSettings.LevelUserSeed;
+	Result.bCompleted = bCompleted;
+	Result.Stats = GeneratedLevelData.Stats;
+	Result.TileCount = GeneratedLevelData.GetTileCount();
+
+	for (const TPair<ETileType, FRoomPlacementStats>& CurrentStats : GeneratedLevelData.Stats.RoomPlacements)
+	{
+		Result.RoomCount += CurrentStats.Value.RoomsPlaced;
+		Result.PlacementFailures += CurrentStats.Value.RoomsRequested - CurrentStats.Value.RoomsPlaced;
+		Result.PlacementsTested += CurrentStats.Value.PlacementsTested;
+	}
+
+	for (const TPair<FIntVector, FCorridorTileData>& CurrentPath : GeneratedLevelData.LevelPathData)
+	{
+		switch (CurrentPath.Value.TileType)
+		{
+		case ETileType::Corridor:
+			Result.CorridorCount++;
+			break;
+
+		case ETileType::Corridor_Special:
+			Result.SpecialCorridorCount++;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	return Result;
+}
+
+bool ULevelGenerationBatchCommandlet::WriteCsvReport(const FString& FilePath, const TArray<FLevelGenerationBatchResult>& Results)
+{
+	FString Report = TEXT("Seed,Completed,PrepareMs,GenerationMs,RoomsMs,RoomGraphMs,CorridorsMs,Rooms,PlacementFailures,PlacementsTested,Corridors,SpecialCorridors,Tiles,CorridorsRequested,CorridorsBuilt,FailedEdges,PathExpansions\n");
+
+	for (const FLevelGenerationBatchResult& CurrentResult : Results)
+	{
+		Report += FString::Printf(TEXT("%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%d,%d,%d,%d,%d,%d,%d,%d,%d,%lld\n"),
+			CurrentResult.Seed, CurrentResult.bCompleted ? 1 : 0,
+			CurrentResult.PrepareTime * 1000.0, CurrentResult.GenerationTime * 1000.0,
+			CurrentResult.Stats.RoomsTime * 1000.0, CurrentResult.Stats.RoomGraphTime * 1000.0, CurrentResult.Stats.CorridorsTime * 1000.0,
+			CurrentResult.RoomCount, CurrentResult.PlacementFailures, CurrentResult.PlacementsTested,
+			CurrentResult.CorridorCount, CurrentResult.SpecialCorridorCount, CurrentResult.TileCount,
+			CurrentResult.Stats.CorridorsRequested, CurrentResult.Stats.CorridorsBuilt, CurrentResult.Stats.FailedEdges.Num(), CurrentResult.Stats.PathExpansions);
+	}
+
+	return FFileHelper::SaveStringToFile(Report, *FilePath);
+}
+
+bool ULevelGenerationBatchCommandlet::WriteJsonReport(const FString& FilePath, const TArray<FLevelGenerationBatchResult>& Results)
+{
+	FString Report = TEXT("[\n");
+
+	for (int32 i = 0; i < Results.Num(); i++)
+	{
+		const FLevelGenerationBatchResult& CurrentResult = Results[i];
+
+		FString FailedEdges;
+		for (const FEdgeInfo& CurrentEdge : CurrentResult.Stats.FailedEdges)
+		{
+			if (!FailedEdges.IsEmpty()) { FailedEdges += TEXT(", "); }
+			FailedEdges += FString::Printf(TEXT("{ \"origin\": [%d, %d, %d], \"destination\": [%d, %d, %d] }"), CurrentEdge.Origin.X, CurrentEdge.Origin.Y, CurrentEdge.Origin.Z, CurrentEdge.Destination.X, CurrentEdge.Destination.Y, CurrentEdge.Destination.Z);
+		}
+
+		Report += FString::Printf(TEXT("\t{ \"seed\": %d, \"completed\": %s, \"timingsMs\": { \"prepare\": %.3f, \"generation\": %.3f, \"rooms\": %.3f, \"roomGraph\": %.3f, \"corridors\": %.3f }, "),
+			CurrentResult.Seed, CurrentResult.bCompleted ? TEXT("true") : TEXT("false"),
+			CurrentResult.PrepareTime * 1000.0, CurrentResult.GenerationTime * 1000.0,
+			CurrentResult.Stats.RoomsTime * 1000.0, CurrentResult.Stats.RoomGraphTime * 1000.0, CurrentResult.Stats.CorridorsTime * 1000.0);
+
+		Report += FString::Printf(TEXT("\"rooms\": %d, \"placementFailures\": %d, \"placementsTested\": %d, \"corridors\": %d, \"specialCorridors\": %d, \"tiles\": %d, \"corridorsRequested\": %d, \"corridorsBuilt\": %d, \"pathExpansions\": %lld, \"failedEdges\": [%s] }%s\n"),
+			CurrentResult.RoomCount, CurrentResult.PlacementFailures, CurrentResult.PlacementsTested,
+			CurrentResult.CorridorCount, CurrentResult.SpecialCorridorCount, CurrentResult.TileCount,
+			CurrentResult.Stats.CorridorsRequested, CurrentResult.Stats.CorridorsBuilt, CurrentResult.Stats.PathExpansions,
+			*FailedEdges, i + 1 < Results.Num() ? TEXT(",") : TEXT(""));
+	}
+
+	Report += TEXT("]\n");
+
+	return FFileHelper::SaveStringToFile(Report, *FilePath);
+}
@@ -0,0 +1,437 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/LevelGenerationBenchmarkCommandlet.h"
+#include "Data/FunctionLibraries/LevelGenerationLibrary.h"
+#include "Data/FunctionLibraries/DelaunayTriangulationLibrary.h"
+#include "Data/FunctionLibraries/KruskalMSTLibrary.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static const TCHAR* RoomPlacementStage = TEXT("PlaceRoomInGrid");
+static const TCHAR* TetrahedralizationStage = TEXT("BuildTetrahedralization");
+static const TCHAR* RoomTetrahedralizationStage = TEXT("BuildRoomTetrahedralization");
+static const TCHAR* MinimumSpanningTreeStage = TEXT("GetMinimumSpanningTreeV2");
+static const TCHAR* PathfindingStage = TEXT("AdvancedAStarPathfinding");
+static const TCHAR* CorridorTilesStage = TEXT("GetTileDataFromCorridorTileData");
+
+// Returns the best time of Run over every repeat in milliseconds, Setup is run before each repeat and is not timed.
+static double MeasureBestTime(int32 Repeats, TFunctionRef<void()> Setup, TFunctionRef<void()> Run)
+{
+	double BestTime = MAX_dbl;
+
+	for (int32 i = 0; i < FMath::Max(Repeats, 1); i++)
+	{
+		Setup();
+
+		const double StartTime = FPlatformTime::Seconds();
+		Run();
+		BestTime = FMath::Min(BestTime, FPlatformTime::Seconds() - StartTime);
+	}
+
+	return BestTime * 1000.0;
+}
+
+// Reads a comma separated list of integers from the command line, keeps the defaults if the value is not set.
+static TArray<int32> ParseIntList(const FString& Params, const TCHAR* Key, const TArray<int32>& Defaults)
+{
+	FString ListString;
+	if (!FParse::Value(*Params, Key, ListString)) { return Defaults; }
+
+	TArray<FString> ListEntries;
+	ListString.ParseIntoArray(ListEntries, TEXT(","));
+
+	TArray<int32> OutList;
+	for (const FString& CurrentEntry : ListEntries)
+	{
+		OutList.Add(FCString::Atoi(*CurrentEntry));
+	}
+
+	return OutList;
+}
+
+ULevelGenerationBenchmarkCommandlet::ULevelGenerationBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 ULevelGenerationBenchmarkCommandlet::Main(const FString& Params)
+{
+	// Step 1. Read the sweep and the thresholds from the command line.
+	const TArray<int32> GridSizes = ParseIntList(Params, TEXT("GridSizes="), { 16, 32, 64, 128 });
+	const TArray<int32> RoomCounts = ParseIntList(Params, TEXT("RoomCounts="), { 10, 50, 100, 500, 1000, 5000 });
+
+	int32 Repeats = 3;
+	int32 Seed = 1337;
+	FString ReportPath = FPaths::ProjectSavedDir() / TEXT("LevelGeneration") / TEXT("Benchmark");
+	FString BaselinePath;
+	double ExponentTolerance = 0.3;
+	double TimeTolerance = 0.5;
+	double MinRegressionMs = 1.0;
+	double MaxExponent = 0.0;
+
+	FParse::Value(*Params, TEXT("Repeats="), Repeats);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+	FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+	FParse::Value(*Params, TEXT("ExponentTolerance="), ExponentTolerance);
+	FParse::Value(*Params, TEXT("TimeTolerance="), TimeTolerance);
+	FParse::Value(*Params, TEXT("MinRegressionMs="), MinRegressionMs);
+	FParse::Value(*Params, TEXT("MaxExponent="), MaxExponent);
+
+	// Step 2. Build the synthetic room and corridor data tables, a single 1x1x1 room and an empty map for every corridor piece.
+	UDataTable* RoomTable = NewObject<UDataTable>(GetTransientPackage(), NAME_None, RF_Transient);
+	RoomTable->RowStruct = FTileGenerationData::StaticStruct();
+	RoomTable->AddToRoot();
+
+	FTileGenerationData BenchmarkRoom;
+	BenchmarkRoom.TileData.TileType = ETileType::Room_Basic;
+	BenchmarkRoom.TileData.TileSize.Add(FIntVector::ZeroValue);
+	RoomTable->AddRow(TEXT("BenchmarkRoom"), BenchmarkRoom);
+
+	TMap<ECorridorType, UDataTable*> CorridorTables;
+	for (uint8 i = (uint8)ECorridorType::ZeroWay; i < (uint8)ECorridorType::MAX; i++)
+	{
+		UDataTable* CorridorTable = NewObject<UDataTable>(GetTransientPackage(), NAME_None, RF_Transient);
+		CorridorTable->RowStruct = FCorridorLevelData::StaticStruct();
+		CorridorTable->AddToRoot();
+		CorridorTable->AddRow(TEXT("BenchmarkCorridor"), FCorridorLevelData());
+
+		CorridorTables.Add((ECorridorType)i, CorridorTable);
+	}
+
+	// Step 3. Time every stage across the sweep.
+	TArray<FLevelGenerationBenchmarkSample> Samples;
+
+	for (const int32 CurrentGridSize : GridSizes)
+	{
+		for (const int32 CurrentRoomCount : RoomCounts)
+		{
+			// Leave at least half the grid free once every room and its buffer is placed
+			if ((int64)CurrentRoomCount * 27 * 2 > (int64)CurrentGridSize * CurrentGridSize * CurrentGridSize) { continue; }
+
+			const TArray<FIntVector> Points = MakeRandomPoints(CurrentGridSize, CurrentRoomCount, Seed);
+			FTetrahedralizationData Tetrahedralization;
+			UDelaunayTriangulationLibrary::BuildTetrahedralization(FIntVector(CurrentGridSize), Points, Tetrahedralization);
+			const TArray<FEdgeInfo> Edges = UDelaunayTriangulationLibrary::GetTetrahedralizationEdges(Tetrahedralization);
+
+			Samples.Add({ RoomPlacementStage, CurrentGridSize, CurrentRoomCount, BenchmarkRoomPlacement(RoomTable, CurrentGridSize, CurrentRoomCount, Seed, Repeats) });
+			Samples.Add({ TetrahedralizationStage, CurrentGridSize, CurrentRoomCount, BenchmarkTetrahedralization(CurrentGridSize, Points, Repeats) });
+			Samples.Add({ RoomTetrahedralizationStage, CurrentGridSize, CurrentRoomCount, BenchmarkRoomTetrahedralization(RoomTable, CurrentGridSize, CurrentRoomCount, Seed, Repeats) });
+			Samples.Add({ MinimumSpanningTreeStage, CurrentGridSize, CurrentRoomCount, BenchmarkMinimumSpanningTree(Points, Edges, Repeats) });
+
+			UE_LOG(LogTemp, Display, TEXT("ULevelGenerationBenchmarkCommandlet::Main Grid %d^3 with %d rooms timed"), CurrentGridSize, CurrentRoomCount);
+		}
+
+		// The corridor crosses the whole grid, so the pathfinding is swept across grid sizes
+		Samples.Add({ PathfindingStage, 0, CurrentGridSize, BenchmarkPathfinding(CurrentGridSize, Seed, Repeats) });
+	}
+
+	for (const int32 CurrentRoomCount : RoomCounts)
+	{
+		Samples.Add({ CorridorTilesStage, 0, CurrentRoomCount, BenchmarkCorridorTiles(CorridorTables, CurrentRoomCount, Seed, Repeats) });
+	}
+
+	RoomTable->RemoveFromRoot();
+	for (const TPair<ECorridorType, UDataTable*>& CurrentTable : CorridorTables)
+	{
+		CurrentTable.Value->RemoveFromRoot();
+	}
+
+	// Step 4. Fit the scaling curves and write the report.
+	const TArray<FLevelGenerationBenchmarkFit> Fits = FitScaling(Samples);
+
+	for (const FLevelGenerationBenchmarkFit& CurrentFit : Fits)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ULevelGenerationBenchmarkCommandlet::Main %s (grid %d): time ~ %.4fms * n^%.2f"), *CurrentFit.Stage, CurrentFit.GridSize, CurrentFit.Coefficient, CurrentFit.Exponent);
+	}
+
+	if (!WriteReport(ReportPath, Samples, Fits))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ULevelGenerationBenchmarkCommandlet::Main Could not write the report to '%s'!"), *ReportPath);
+		return 1;
+	}
+
+	// Step 5. Compare the curves and times against the thresholds and the baseline.
+	int32 Regressions = 0;
+
+	if (MaxExponent > 0.0)
+	{
+		for (const FLevelGenerationBenchmarkFit& CurrentFit : Fits)
+		{
+			if (CurrentFit.Exponent <= MaxExponent) { continue; }
+
+			UE_LOG(LogTemp, Error, TEXT("ULevelGenerationBenchmarkCommandlet::Main %s (grid %d) scales with n^%.2f, more than the maximum of n^%.2f!"), *CurrentFit.Stage, CurrentFit.GridSize, CurrentFit.Exponent, MaxExponent);
+			Regressions++;
+		}
+	}
+
+	if (!BaselinePath.IsEmpty())
+	{
+		TArray<FLevelGenerationBenchmarkSample> BaselineSamples;
+		if (!ReadSamples(BaselinePath, BaselineSamples))
+		{
+			UE_LOG(LogTemp, Error, TEXT("ULevelGenerationBenchmarkCommandlet::Main Could not read the baseline '%s'!"), *BaselinePath);
+			return 1;
+		}
+
+		const TArray<FLevelGenerationBenchmarkFit> BaselineFits = FitScaling(BaselineSamples);
+
+		for (const FLevelGenerationBenchmarkFit& CurrentFit : Fits)
+		{
+			const FLevelGenerationBenchmarkFit* BaselineFit = BaselineFits.FindByPredicate([&](const FLevelGenerationBenchmarkFit& Fit) { return Fit.Stage == CurrentFit.Stage && Fit.GridSize == CurrentFit.GridSize; });
+			if (!BaselineFit || CurrentFit.Exponent <= BaselineFit->Exponent + ExponentTolerance) { continue; }
+
+			UE_LOG(LogTemp, Error, TEXT("ULevelGenerationBenchmarkCommandlet::Main %s (grid %d) now scales with n^%.2f, the baseline scales with n^%.2f!"), *CurrentFit.Stage, CurrentFit.GridSize, CurrentFit.Exponent, BaselineFit->Exponent);
+			Regressions++;
+		}
+
+		for (const FLevelGenerationBenchmarkSample& CurrentSample : Samples)
+		{
+			const FLevelGenerationBenchmarkSample* BaselineSample = BaselineSamples.FindByPredicate([&](const FLevelGenerationBenchmarkSample& Sample) { return Sample.Stage == CurrentSample.Stage && Sample.GridSize == CurrentSample.GridSize && Sample.InputSize == CurrentSample.InputSize; });
+			if (!BaselineSample) { continue; }
+
+			// Small times are mostly noise, only differences above MinRegressionMs count
+			const double AllowedTime = BaselineSample->Milliseconds * (1.0 + TimeTolerance);
+			if (CurrentSample.Milliseconds <= AllowedTime || CurrentSample.Milliseconds - BaselineSample->Milliseconds < MinRegressionMs) { continue; }
+
+			UE_LOG(LogTemp, Error, TEXT("ULevelGenerationBenchmarkCommandlet::Main %s (grid %d, n = %d) took %.3fms, the baseline took %.3fms!"), *CurrentSample.Stage, CurrentSample.GridSize, CurrentSample.InputSize, CurrentSample.Milliseconds, BaselineSample->Milliseconds);
+			Regressions++;
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("ULevelGenerationBenchmarkCommandlet::Main %d samples timed, %d regressions. Report written to %s.csv"), Samples.Num(), Regressions, *ReportPath);
+
+	return Regressions > 0 ? 1 : 0;
+}
+
+FLevelGenerationSettings ULevelGenerationBenchmarkCommandlet::MakeBenchmarkSettings(int32 GridSize, int32 Seed, const TMap<ECorridorType, UDataTable*>& CorridorTables)
+{
+	FLevelGenerationSettings Settings;
+	Settings.bUsePlayerSeed = true;
+	Settings.LevelUserSeed = Seed;
+	Settings.TileSize = 1000;
+	Settings.GridSize = FIntVector(GridSize);
+	Settings.RoomBufferSize = 1;
+	Settings.CorridorLevelDataTableList = CorridorTables;
+	Settings.TileTypeWeight.Add(ETileType::Empty, 1.f);
+	Settings.TileTypeWeight.Add(ETileType::Corridor, 1.f);
+
+	return Settings;
+}
+
+TArray<FIntVector> ULevelGenerationBenchmarkCommandlet::MakeRandomPoints(int32 GridSize, int32 PointCount, int32 Seed)
+{
+	const FRandomStream PointStream(Seed);
+
+	TSet<FIntVector> Points;
+	Points.Reserve(PointCount);
+
+	while (Points.Num() < PointCount)
+	{
+		Points.Add(FIntVector(PointStream.RandRange(0, GridSize - 1), PointStream.RandRange(0, GridSize - 1), PointStream.RandRange(0, GridSize - 1)));
+	}
+
+	return Points.Array();
+}
+
+double ULevelGenerationBenchmarkCommandlet::BenchmarkRoomPlacement(UDataTable* RoomTable, int32 GridSize, int32 RoomCount, int32 Seed, int32 Repeats)
+{
+	FLevelGenerationSettings Settings = MakeBenchmarkSettings(GridSize, Seed, TMap<ECorridorType, UDataTable*>());
+	FGeneratedLevelData GeneratedLevelData;
+
+	return MeasureBestTime(Repeats,
+		[&]()
+		{
+			GeneratedLevelData = FGeneratedLevelData();
+			ULevelGenerationLibrary::PrepareLevelGeneration(Settings, GeneratedLevelData);
+		},
+		[&]()
+		{
+			for (int32 i = 0; i < RoomCount; i++)
+			{
+				ULevelGenerationLibrary::PlaceRoomInGrid(Settings, GeneratedLevelData, RoomTable, ETileType::Room_Basic);
+			}
+		});
+}
+
+double ULevelGenerationBenchmarkCommandlet::BenchmarkTetrahedralization(int32 GridSize, const TArray<FIntVector>& Points, int32 Repeats)
+{
+	FTetrahedralizationData Tetrahedralization;
+
+	return MeasureBestTime(Repeats, []() {}, [&]() { UDelaunayTriangulationLibrary::BuildTetrahedralization(FIntVector(GridSize), Points, Tetrahedralization); });
+}
+
+double ULevelGenerationBenchmarkCommandlet::BenchmarkRoomTetrahedralization(UDataTable* RoomTable, int32 GridSize, int32 RoomCount, int32 Seed, int32 Repeats)
+{
+	FLevelGenerationSettings Settings = MakeBenchmarkSettings(GridSize, Seed, TMap<ECorridorType, UDataTable*>());
+	FGeneratedLevelData GeneratedLevelData;
+	ULevelGenerationLibrary::PrepareLevelGeneration(Settings, GeneratedLevelData);
+
+	for (int32 i = 0; i < RoomCount; i++)
+	{
+		ULevelGenerationLibrary::PlaceRoomInGrid(Settings, GeneratedLevelData, RoomTable, ETileType::Room_Basic);
+	}
+
+	TArray<FIntVector> RoomCoordinates;
+	TArray<FEdgeInfo> GraphEdges;
+
+	return MeasureBestTime(Repeats,
+		[&]()
+		{
+			RoomCoordinates.Reset();
+			GraphEdges.Reset();
+		},
+		[&]() { ULevelGenerationLibrary::BuildRoomTetrahedralization(Settings, GeneratedLevelData, RoomCoordinates, GraphEdges); });
+}
+
+double ULevelGenerationBenchmarkCommandlet::BenchmarkMinimumSpanningTree(const TArray<FIntVector>& Points, const TArray<FEdgeInfo>& Edges, int32 Repeats)
+{
+	TArray<FEdgeInfo> DiscardedEdges;
+
+	return MeasureBestTime(Repeats, [&]() { DiscardedEdges.Reset(); }, [&]() { UKruskalMSTLibrary::GetMinimumSpanningTreeV2(Points, Edges, DiscardedEdges); });
+}
+
+double ULevelGenerationBenchmarkCommandlet::BenchmarkPathfinding(int32 GridSize, int32 Seed, int32 Repeats)
+{
+	FLevelGenerationSettings Settings = MakeBenchmarkSettings(GridSize, Seed, TMap<ECorridorType, UDataTable*>());
+	FGeneratedLevelData GeneratedLevelData;
+
+	TMap<FIntVector, FAdvancedPathNode> PathData;
+	const TArray<FPathGenerationData> PathGenerationDataArray;
+
+	// Straight across the middle of the bottom floor, special paths are disabled so the search stays on one floor
+	const FIntVector StartLocation(0, GridSize / 2, 0);
+	const FIntVector EndLocation(GridSize - 1, GridSize / 2, 0);
+
+	return MeasureBestTime(Repeats,
+		[&]()
+		{
+			GeneratedLevelData = FGeneratedLevelData();
+			ULevelGenerationLibrary::PrepareLevelGeneration(Settings, GeneratedLevelData);
+			PathData.Reset();
+		},
+		[&]() { ULevelGenerationLibrary::AdvancedAStarPathfinding(StartLocation, EndLocation, PathData, PathGenerationDataArray, Settings, GeneratedLevelData); });
+}
+
+double ULevelGenerationBenchmarkCommandlet::BenchmarkCorridorTiles(const TMap<ECorridorType, UDataTable*>& CorridorTables, int32 CorridorCount, int32 Seed, int32 Repeats)
+{
+	FLevelGenerationSettings Settings = MakeBenchmarkSettings(16, Seed, CorridorTables);
+	FGeneratedLevelData GeneratedLevelData;
+	ULevelGenerationLibrary::PrepareLevelGeneration(Settings, GeneratedLevelData);
+
+	// Random pieces connected on one to four sides
+	const FRandomStream CorridorStream(Seed);
+	const EDirections HorizontalDirections[4] = { EDirections::North, EDirections::East, EDirections::South, EDirections::West };
+
+	TArray<FCorridorTileData> Corridors;
+	Corridors.SetNum(CorridorCount);
+
+	for (FCorridorTileData& CurrentCorridor : Corridors)
+	{
+		CurrentCorridor.TileType = ETileType::Corridor;
+
+		for (const EDirections CurrentDirection : HorizontalDirections)
+		{
+			if (CorridorStream.FRand() < 0.5f) { CurrentCorridor.SetAdjacentAccessPoint(CurrentDirection, ETileType::Corridor); }
+		}
+
+		if (CurrentCorridor.AdjacentAccessPoints.IsEmpty()) { CurrentCorridor.SetAdjacentAccessPoint(EDirections::North, ETileType::Corridor); }
+	}
+
+	return MeasureBestTime(Repeats, []() {}, [&]()
+		{
+			for (const FCorridorTileData& CurrentCorridor : Corridors)
+			{
+				ULevelGenerationLibrary::GetTileDataFromCorridorTileData(CurrentCorridor, GeneratedLevelData.CompiledSettings, GeneratedLevelData.LevelStream, GeneratedLevelData.RandomSelectionCache);
+			}
+		});
+}
+
+TArray<FLevelGenerationBenchmarkFit> ULevelGenerationBenchmarkCommandlet::FitScaling(const TArray<FLevelGenerationBenchmarkSample>& Samples)
+{
+	TArray<FLevelGenerationBenchmarkFit> Fits;
+
+	// Group the samples by stage and grid size, in the order they were measured
+	TArray<TPair<FString, int32>> Groups;
+	for (const FLevelGenerationBenchmarkSample& CurrentSample : Samples)
+	{
+		Groups.AddUnique(TPair<FString, int32>(CurrentSample.Stage, CurrentSample.GridSize));
+	}
+
+	for (const TPair<FString, int32>& CurrentGroup : Groups)
+	{
+		double SumX = 0.0, SumY = 0.0, SumXX = 0.0, SumXY = 0.0;
+		int32 SampleCount = 0;
+
+		for (const FLevelGenerationBenchmarkSample& CurrentSample : Samples)
+		{
+			if (CurrentSample.Stage != CurrentGroup.Key || CurrentSample.GridSize != CurrentGroup.Value || CurrentSample.InputSize <= 0) { continue; }
+
+			// Times below the timer resolution are clamped so their log stays finite
+			const double X = FMath::Loge((double)CurrentSample.InputSize);
+			const double Y = FMath::Loge(FMath::Max(CurrentSample.Milliseconds, 0.001));
+
+			SumX += X;
+			SumY += Y;
+			SumXX += X * X;
+			SumXY += X * Y;
+			SampleCount++;
+		}
+
+		const double Denominator = SampleCount * SumXX - SumX * SumX;
+		if (SampleCount < 2 || FMath::IsNearlyZero(Denominator)) { continue; }
+
+		FLevelGenerationBenchmarkFit& NewFit = Fits.AddDefaulted_GetRef();
+		NewFit.Stage = CurrentGroup.Key;
+		NewFit.GridSize = CurrentGroup.Value;
+		NewFit.Exponent = (SampleCount * SumXY - SumX * SumY) / Denominator;
+		NewFit.Coefficient = FMath::Exp((SumY - NewFit.Exponent * SumX) / SampleCount);
+	}
+
+	return Fits;
+}
+
+bool ULevelGenerationBenchmarkCommandlet::WriteReport(const FString& ReportPath, const TArray<FLevelGenerationBenchmarkSample>& Samples, const TArray<FLevelGenerationBenchmarkFit>& Fits)
+{
+	FString SamplesReport = TEXT("Stage,GridSize,InputSize,Milliseconds\n");
+	for (const FLevelGenerationBenchmarkSample& CurrentSample : Samples)
+	{
+		SamplesReport += FString::Printf(TEXT("%s,%d,%d,%.4f\n"), *CurrentSample.Stage, CurrentSample.GridSize, CurrentSample.InputSize, CurrentSample.Milliseconds);
+	}
+
+	FString FitsReport = TEXT("Stage,GridSize,Exponent,CoefficientMs\n");
+	for (const FLevelGenerationBenchmarkFit& CurrentFit : Fits)
+	{
+		FitsReport += FString::Printf(TEXT("%s,%d,%.4f,%.6f\n"), *CurrentFit.Stage, CurrentFit.GridSize, CurrentFit.Exponent, CurrentFit.Coefficient);
+	}
+
+	return FFileHelper::SaveStringToFile(SamplesReport, *(ReportPath + TEXT(".csv"))) && FFileHelper::SaveStringToFile(FitsReport, *(ReportPath + TEXT("_Fits.csv")));
+}
+
+bool ULevelGenerationBenchmarkCommandlet::ReadSamples(const FString& FilePath, TArray<FLevelGenerationBenchmarkSample>& OutSamples)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath)) { return false; }
+
+	// Skip the header
+	for (int32 i = 1; i < Lines.Num(); i++)
+	{
+		TArray<FString> Values;
+		Lines[i].ParseIntoArray(Values, TEXT(","));
+
+		if (Values.Num() != 4) { continue; }
+
+		FLevelGenerationBenchmarkSample& NewSample = OutSamples.AddDefaulted_GetRef();
+		NewSample.Stage = Values[0];
+		NewSample.GridSize = FCString::Atoi(*Values[1]);
+		NewSample.InputSize = FCString::Atoi(*Values[2]);
+		NewSample.Milliseconds = FCString::Atod(*Values[3]);
+	}
+
+	return true;
+}
@@ -10,11 +10,24 @@
 
 TArray<FQuarterEdge> UDelaunayTriangulationLibrary::GuibasStolfi(FIntVector GridSize, TArray<FIntVector> PointArray, bool bRemoveBoundaryTriangle)
 {
+    FPointLocationStats PointLocationStats;
+
+    return GuibasStolfiWithStats(GridSize, MoveTemp(PointArray), bRemoveBoundaryTriangle, PointLocationStats);
+}
+
+TArray<FQuarterEdge> UDelaunayTriangulationLibrary::GuibasStolfiWithStats(FIntVector GridSize, TArray<FIntVector> PointArray, bool bRemoveBoundaryTriangle, FPointLocationStats& PointLocationStats)
+{
+    PointLocationStats = FPointLocationStats();
+
     if (GridSize.IsZero()) { return TArray<FQuarterEdge>(); }
 
     TArray<FQuarterEdge*> TriangulationArray;
     TArray<FVector> AddedPointsArray;
 
+    // The last edge inserted in each coarse grid bucket, used as a starting point when locating nearby points
+    TMap<FIntPoint, FQuarterEdge*> BucketCache;
+    const int32 BucketSize = FMath::Max(1, FMath::Max(GridSize.X, GridSize.Y) / 8);
+
     // Start with a single "infinitely large" triangle
     FVector BoundaryVertexLeft = { (-0.5f * (float)GridSize.X), ((float)-GridSize.Y), (0.f) };
     FVector BoundaryVertexRight = { (-0.5f * (float)GridSize.X), (2.f * (float)GridSize.Y), (0.f) };
@@ -30,29 +43,10 @@ TArray<FQuarterEdge> UDelaunayTriangulationLibrary::GuibasStolfi(FIntVector Grid
         FVector CurrentPoint = (FVector)ForPoint;
         AddedPointsArray.Add(CurrentPoint);
 
-        // Start search from wherever the previous point was inserted
-        FQuarterEdge* TriangleToCheckAB = TriangulationArray.Last();
+        const FIntPoint BucketKey(FMath::FloorToInt(CurrentPoint.X / BucketSize), FMath::FloorToInt(CurrentPoint.Y / BucketSize));
 
         // Find the triangle containing this point
-        FQuarterEdge* TriangleContainingPoint = nullptr;
-
-        do
-        {
-            FQuarterEdge* TriangleToCheckBC = LNext(TriangleToCheckAB);
-            FQuarterEdge* TriangleToCheckCA = LNext(TriangleToCheckBC);
-
-            FQuarterEdge* ClockwiseEdge = IsPointInTriangle((FVector3f)CurrentPoint, TriangleToCheckAB);
-
-            if (ClockwiseEdge == nullptr)
-            {
-                TriangleContainingPoint = TriangleToCheckAB;
-                break;
-            }
-            else
-            {
-                TriangleToCheckAB = Previous(ClockwiseEdge);
-            }
-        } while (true);
+        FQuarterEdge* TriangleContainingPoint = LocatePoint(CurrentPoint, TriangulationArray, BucketCache, BucketKey, PointLocationStats);
 
         TArray<FQuarterEdge*> NewTrianglesArray;
 
@@ -148,6 +142,9 @@ TArray<FQuarterEdge> UDelaunayTriangulationLibrary::GuibasStolfi(FIntVector Grid
         TriangulationArray.Add(SymmetricEdge(CP));
         if (DP) { TriangulationArray.Add(SymmetricEdge(DP)); }
 
+        // Cache an edge connected to the new point, LocatePoint skips it if a later insertion severs it
+        BucketCache.Add(BucketKey, SymmetricEdge(AP));
+
         //PA = nullptr;
 
         //for (FQuarterEdge CurrentTriangle : NewTrianglesArray)
@@ -395,6 +392,57 @@ TArray<FQuarterEdge> UDelaunayTriangulationLibrary::GuibasStolfi(FIntVector Grid
     return OutTriangulationArray;
 }
 
+FQuarterEdge* UDelaunayTriangulationLibrary::LocatePoint(FVector Point, const TArray<FQuarterEdge*>& TriangulationArray, const TMap<FIntPoint, FQuarterEdge*>& BucketCache, FIntPoint BucketKey, FPointLocationStats& PointLocationStats)
+{
+    // Jump: start from whichever candidate edge has its origin closest to the point
+    FQuarterEdge* TriangleToCheckAB = TriangulationArray.Last();
+    double ClosestDistanceSquared = FVector::DistSquared(TriangleToCheckAB->Data, Point);
+
+    auto ConsiderStartingEdge = [&](FQuarterEdge* CandidateEdge)
+    {
+        const double DistanceSquared = FVector::DistSquared(CandidateEdge->Data, Point);
+        if (DistanceSquared < ClosestDistanceSquared)
+        {
+            ClosestDistanceSquared = DistanceSquared;
+            TriangleToCheckAB = CandidateEdge;
+        }
+    };
+
+    // A severed edge is left on its own in its origin ring, so the cached edge is only used while it is still connected
+    FQuarterEdge* const* CachedEdge = BucketCache.Find(BucketKey);
+    if (CachedEdge && (*CachedEdge)->Next != *CachedEdge)
+    {
+        ConsiderStartingEdge(*CachedEdge);
+    }
+
+    // Sample roughly n^(1/3) edges spread evenly through the triangulation, keeping the result deterministic
+    const int32 SampleCount = FMath::CeilToInt(FMath::Pow((float)TriangulationArray.Num(), 1.f / 3.f));
+    for (int32 i = 0; i < SampleCount; i++)
+    {
+        ConsiderStartingEdge(TriangulationArray[(int64)i * TriangulationArray.Num() / SampleCount]);
+    }
+
+    // Walk: move towards the point until the triangle containing it is reached
+    int32 WalkLength = 0;
+
+    do
+    {
+        WalkLength++;
+
+        FQuarterEdge* ClockwiseEdge = IsPointInTriangle((FVector3f)Point, TriangleToCheckAB);
+
+        if (ClockwiseEdge == nullptr) { break; }
+
+        TriangleToCheckAB = Previous(ClockwiseEdge);
+    } while (true);
+
+    PointLocationStats.PointsLocated++;
+    PointLocationStats.TotalWalkLength += WalkLength;
+    PointLocationStats.LongestWalkLength = FMath::Max(PointLocationStats.LongestWalkLength, WalkLength);
+
+    return TriangleToCheckAB;
+}
+
 TArray<FEdgeInfo> UDelaunayTriangulationLibrary::DelaunayTetrahedralization(FIntVector GridSize, TArray<FIntVector> PointArray, bool bRemoveBoundaryTetrahedron)
 {
     if (GridSize.IsZero()) { return TArray<FEdgeInfo>(); }
@@ -415,16 +463,7 @@ TArray<FEdgeInfo> UDelaunayTriangulationLibrary::DelaunayTetrahedralization(FInt
     // Make TetrahedronFaces Tetrahedron
     TArray<FTetrahedron*> TetrahedraArray;
 
-    const float GridWidth = GridSize.X > GridSize.Y ? GridSize.X : GridSize.Y;
-
-    FTetrahedron* BoundaryTetrahedron = new FTetrahedron
-    {
-        FVector{ (GridWidth * .5f),     (GridWidth * .5f),      (GridSize.Z * 4.1f) },
-        FVector{ (GridWidth * -1.25f),  (GridWidth * -2.1f),    (GridSize.Z * -1.1f) },
-        FVector{ (GridWidth * 4.f),     (GridWidth * .5f),      (GridSize.Z * -1.1f) },
-        FVector{ (GridWidth * -1.25f),  (GridWidth * 3.1f),     (GridSize.Z * -1.1f) }
-    };
-    
+    FTetrahedron* BoundaryTetrahedron = new FTetrahedron(MakeBoundaryTetrahedron(GridSize));
 
     //FTetrahedron* BoundaryTetrahedron = GetSuperTetrahedron((TArray<FVector>)PointArray);
     TetrahedraArray.Add(BoundaryTetrahedron);
@@ -516,6 +555,285 @@ TArray<FEdgeInfo> UDelaunayTriangulationLibrary::DelaunayTetrahedralization(FInt
     return EdgeArray;
 }
 
+void UDelaunayTriangulationLibrary::BuildTetrahedralization(FIntVector GridSize, const TArray<FIntVector>& PointArray, FTetrahedralizationData& Tetrahedralization)
+{
+    Tetrahedralization = FTetrahedralizationData();
+
+    if (GridSize.IsZero()) { return; }
+
+    Tetrahedralization.GridSize = GridSize;
+    Tetrahedralization.BoundaryTetrahedron = MakeBoundaryTetrahedron(GridSize);
+    AddTetrahedron(Tetrahedralization, Tetrahedralization.BoundaryTetrahedron);
+
+    TArray<FTetrahedron> RemovedTetrahedra;
+    TArray<FTetrahedron> AddedTetrahedra;
+
+    for (const FIntVector& Point : PointArray)
+    {
+        if (Tetrahedralization.PointSet.Contains(Point)) { continue; }
+
+        Tetrahedralization.PointSet.Add(Point);
+
+        RemovedTetrahedra.Reset();
+        AddedTetrahedra.Reset();
+        InsertPointIntoTetrahedraArray(Tetrahedralization, (FVector)Point, RemovedTetrahedra, AddedTetrahedra);
+    }
+
+    // Count the edges once the tetrahedralization is complete rather than after every insertion
+    for (const FTetrahedron& CurrentTetrahedron : Tetrahedralization.TetrahedraArray)
+    {
+        UpdateEdgeReferenceCount(Tetrahedralization, CurrentTetrahedron, 1);
+    }
+}
+
+bool UDelaunayTriangulationLibrary::InsertPointIntoTetrahedralization(FTetrahedralizationData& Tetrahedralization, FIntVector Point, TArray<FEdgeInfo>& NewEdges)
+{
+    if (!Tetrahedralization.IsValid() || Tetrahedralization.PointSet.Contains(Point)) { return false; }
+
+    if (!IsPointInsideTetrahedron(Tetrahedralization.BoundaryTetrahedron, (FVector)Point))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UDelaunayTriangulationLibrary::InsertPointIntoTetrahedralization Point %s is outside of the boundary tetrahedron!"), *Point.ToString());
+        return false;
+    }
+
+    Tetrahedralization.PointSet.Add(Point);
+
+    TArray<FTetrahedron> RemovedTetrahedra;
+    TArray<FTetrahedron> AddedTetrahedra;
+    InsertPointIntoTetrahedraArray(Tetrahedralization, (FVector)Point, RemovedTetrahedra, AddedTetrahedra);
+
+    for (const FTetrahedron& RemovedTetrahedron : RemovedTetrahedra)
+    {
+        UpdateEdgeReferenceCount(Tetrahedralization, RemovedTetrahedron, -1);
+    }
+
+    for (const FTetrahedron& AddedTetrahedron : AddedTetrahedra)
+    {
+        UpdateEdgeReferenceCount(Tetrahedralization, AddedTetrahedron, 1);
+
+        // The inserted point is always the first vertex of the new tetrahedra
+        for (const FVector& Vertex : { AddedTetrahedron.B, AddedTetrahedron.C, AddedTetrahedron.D })
+        {
+            FIntVector ConnectedPoint;
+            if (GetInsertedPoint(Tetrahedralization, Vertex, ConnectedPoint))
+            {
+                NewEdges.AddUnique(GetOrderedEdge(Point, ConnectedPoint));
+            }
+        }
+    }
+
+    return true;
+}
+
+bool UDelaunayTriangulationLibrary::RemovePointFromTetrahedralization(FTetrahedralizationData& Tetrahedralization, FIntVector Point, TArray<FEdgeInfo>& NeighbourEdges)
+{
+    if (!Tetrahedralization.IsValid() || !Tetrahedralization.PointSet.Contains(Point)) { return false; }
+
+    const FVector RemovedVertex = (FVector)Point;
+
+    // Step 1. Remove the tetrahedra incident to the point, leaving a star-shaped cavity. Highest index first so the swapped tetrahedra are never incident to the point
+    TArray<int32> IncidentIndices = Tetrahedralization.PointTetrahedra.FindRef(Point);
+    IncidentIndices.Sort(TGreater<int32>());
+
+    TArray<FTetrahedron> CavityTetrahedra;
+    TArray<FVector> CavityVertices;
+    double CavityVolume = 0.0;
+
+    for (int32 TetrahedronIndex : IncidentIndices)
+    {
+        const FTetrahedron CurrentTetrahedron = Tetrahedralization.TetrahedraArray[TetrahedronIndex];
+
+        for (const FVector& Vertex : { CurrentTetrahedron.A, CurrentTetrahedron.B, CurrentTetrahedron.C, CurrentTetrahedron.D })
+        {
+            if (Vertex != RemovedVertex) { CavityVertices.AddUnique(Vertex); }
+        }
+
+        UpdateEdgeReferenceCount(Tetrahedralization, CurrentTetrahedron, -1);
+        CavityVolume += GetTetrahedronVolume(CurrentTetrahedron);
+        CavityTetrahedra.Add(CurrentTetrahedron);
+
+        RemoveTetrahedron(Tetrahedralization, TetrahedronIndex);
+    }
+
+    Tetrahedralization.PointSet.Remove(Point);
+    Tetrahedralization.PointTetrahedra.Remove(Point);
+
+    if (CavityTetrahedra.IsEmpty()) { return true; }
+
+    auto IsVertexLess = [](const FVector& VertexA, const FVector& VertexB) -> bool
+    {
+        return VertexA.X != VertexB.X ? VertexA.X < VertexB.X : (VertexA.Y != VertexB.Y ? VertexA.Y < VertexB.Y : VertexA.Z < VertexB.Z);
+    };
+
+    // Returns the face oriented so the vertex is behind it, the open side of a face is always in front of it
+    auto OrientFace = [](const FVector& A, const FVector& B, const FVector& C, const FVector& BehindVertex) -> FTriangle
+    {
+        return GetOrientation(A, B, C, BehindVertex) < 0.0 ? FTriangle{ A, B, C } : FTriangle{ A, C, B };
+    };
+
+    // Step 2. The boundary of the cavity is made of the faces opposite the removed point, facing into the cavity
+    TArray<FTriangle> FaceStack;
+    TSet<FTetrahedronFaceKey> OpenFaces;
+
+    for (const FTetrahedron& CavityTetrahedron : CavityTetrahedra)
+    {
+        FVector FaceVertices[3];
+        int32 FaceVertexCount = 0;
+
+        for (const FVector& Vertex : { CavityTetrahedron.A, CavityTetrahedron.B, CavityTetrahedron.C, CavityTetrahedron.D })
+        {
+            if (Vertex != RemovedVertex) { FaceVertices[FaceVertexCount++] = Vertex; }
+        }
+
+        // The removed point is inside the cavity, so the face is flipped to put it in front
+        const FTriangle OutwardFace = OrientFace(FaceVertices[0], FaceVertices[1], FaceVertices[2], RemovedVertex);
+        const FTriangle BoundaryFace{ OutwardFace.A, OutwardFace.C, OutwardFace.B };
+
+        FaceStack.Add(BoundaryFace);
+        OpenFaces.Add(GetFaceKey(BoundaryFace.A, BoundaryFace.B, BoundaryFace.C));
+    }
+
+    // Step 3. Fill the cavity inwards from its boundary, closing each open face with the cavity vertex whose circumsphere with the face contains no other cavity vertex
+    TSet<FEdgeInfo> FillEdges;
+    double FilledVolume = 0.0;
+    const int32 MaxFillTetrahedra = CavityVertices.Num() * CavityVertices.Num();
+    int32 FillTetrahedraCount = 0;
+
+    while (!FaceStack.IsEmpty() && FillTetrahedraCount < MaxFillTetrahedra)
+    {
+        const FTriangle CurrentFace = FaceStack.Pop();
+
+        // The face has already been closed from its other side
+        if (OpenFaces.Remove(GetFaceKey(CurrentFace.A, CurrentFace.B, CurrentFace.C)) == 0) { continue; }
+
+        const FVector* BestVertex = nullptr;
+        FVector BestCentre = FVector::ZeroVector;
+        double BestRadiusSquared = 0.0;
+
+        for (const FVector& Vertex : CavityVertices)
+        {
+            if (GetOrientation(CurrentFace.A, CurrentFace.B, CurrentFace.C, Vertex) <= KINDA_SMALL_NUMBER) { continue; }
+
+            if (BestVertex)
+            {
+                const double DistanceSquared = FVector::DistSquared(BestCentre, Vertex);
+                const double Tolerance = BestRadiusSquared * 1e-9;
+
+                if (DistanceSquared > BestRadiusSquared + Tolerance) { continue; }
+
+                // Co-spherical vertices are picked by their order, so every face on the same sphere picks the same vertex
+                if (DistanceSquared >= BestRadiusSquared - Tolerance && !IsVertexLess(Vertex, *BestVertex)) { continue; }
+            }
+
+            FVector Centre;
+            double RadiusSquared;
+            if (!GetCircumsphere(FTetrahedron{ CurrentFace.A, CurrentFace.B, CurrentFace.C, Vertex }, Centre, RadiusSquared)) { continue; }
+
+            BestVertex = &Vertex;
+            BestCentre = Centre;
+            BestRadiusSquared = RadiusSquared;
+        }
+
+        if (!BestVertex) { continue; }
+
+        const FVector NewVertex = *BestVertex;
+        const FTetrahedron NewTetrahedron{ NewVertex, CurrentFace.A, CurrentFace.B, CurrentFace.C };
+
+        AddTetrahedron(Tetrahedralization, NewTetrahedron);
+        UpdateEdgeReferenceCount(Tetrahedralization, NewTetrahedron, 1);
+        FilledVolume += GetTetrahedronVolume(NewTetrahedron);
+        FillTetrahedraCount++;
+
+        // Each new face either closes an open face or becomes open itself
+        const FTriangle NewFaces[3]
+        {
+            OrientFace(CurrentFace.A, CurrentFace.B, NewVertex, CurrentFace.C),
+            OrientFace(CurrentFace.B, CurrentFace.C, NewVertex, CurrentFace.A),
+            OrientFace(CurrentFace.C, CurrentFace.A, NewVertex, CurrentFace.B)
+        };
+
+        for (const FTriangle& NewFace : NewFaces)
+        {
+            const FTetrahedronFaceKey NewFaceKey = GetFaceKey(NewFace.A, NewFace.B, NewFace.C);
+
+            if (OpenFaces.Remove(NewFaceKey) == 0)
+            {
+                OpenFaces.Add(NewFaceKey);
+                FaceStack.Add(NewFace);
+            }
+        }
+
+        const FVector Vertices[4]{ NewTetrahedron.A, NewTetrahedron.B, NewTetrahedron.C, NewTetrahedron.D };
+        for (int32 i = 0; i < 4; i++)
+        {
+            FIntVector PointA;
+            if (!GetInsertedPoint(Tetrahedralization, Vertices[i], PointA)) { continue; }
+
+            for (int32 j = i + 1; j < 4; j++)
+            {
+                FIntVector PointB;
+                if (GetInsertedPoint(Tetrahedralization, Vertices[j], PointB)) { FillEdges.Add(GetOrderedEdge(PointA, PointB)); }
+            }
+        }
+    }
+
+    if (OpenFaces.IsEmpty() && FMath::IsNearlyEqual(FilledVolume, CavityVolume, CavityVolume * 0.001 + KINDA_SMALL_NUMBER))
+    {
+        NeighbourEdges = FillEdges.Array();
+        return true;
+    }
+
+    // Step 4. The cavity could not be filled exactly, so the tetrahedralization is rebuilt rather than left with holes or overlaps
+    UE_LOG(LogTemp, Warning, TEXT("UDelaunayTriangulationLibrary::RemovePointFromTetrahedralization Cavity of point %s could not be filled, rebuilding the tetrahedralization."), *Point.ToString());
+
+    TSet<FIntVector> NeighbourPoints;
+    for (const FVector& Vertex : CavityVertices)
+    {
+        FIntVector NeighbourPoint;
+        if (GetInsertedPoint(Tetrahedralization, Vertex, NeighbourPoint)) { NeighbourPoints.Add(NeighbourPoint); }
+    }
+
+    BuildTetrahedralization(Tetrahedralization.GridSize, Tetrahedralization.PointSet.Array(), Tetrahedralization);
+
+    // The edges between the former neighbours of the point are the edges that may have replaced the removed ones
+    TSet<FEdgeInfo> RebuiltEdges;
+    for (const FIntVector& NeighbourPoint : NeighbourPoints)
+    {
+        for (int32 TetrahedronIndex : Tetrahedralization.PointTetrahedra.FindRef(NeighbourPoint))
+        {
+            const FTetrahedron& CurrentTetrahedron = Tetrahedralization.TetrahedraArray[TetrahedronIndex];
+
+            for (const FVector& Vertex : { CurrentTetrahedron.A, CurrentTetrahedron.B, CurrentTetrahedron.C, CurrentTetrahedron.D })
+            {
+                FIntVector ConnectedPoint;
+                if (GetInsertedPoint(Tetrahedralization, Vertex, ConnectedPoint) && ConnectedPoint != NeighbourPoint && NeighbourPoints.Contains(ConnectedPoint))
+                {
+                    RebuiltEdges.Add(GetOrderedEdge(NeighbourPoint, ConnectedPoint));
+                }
+            }
+        }
+    }
+
+    NeighbourEdges = RebuiltEdges.Array();
+
+    return true;
+}
+
+TArray<FEdgeInfo> UDelaunayTriangulationLibrary::GetTetrahedralizationEdges(const FTetrahedralizationData& Tetrahedralization)
+{
+    TArray<FEdgeInfo> EdgeArray;
+    Tetrahedralization.EdgeReferenceCount.GenerateKeyArray(EdgeArray);
+
+    return EdgeArray;
+}
+
+FEdgeInfo UDelaunayTriangulationLibrary::GetOrderedEdge(FIntVector PointA, FIntVector PointB)
+{
+    const bool bIsPointAFirst = PointA.X != PointB.X ? PointA.X < PointB.X : (PointA.Y != PointB.Y ? PointA.Y < PointB.Y : PointA.Z < PointB.Z);
+
+    return bIsPointAFirst ? FEdgeInfo(PointA, PointB) : FEdgeInfo(PointB, PointA);
+}
+
 FQuarterEdge *UDelaunayTriangulationLibrary::MakeQuadEdge(FVector Start, FVector End)
 {
     FQuarterEdge *StartEnd = new FQuarterEdge();
@@ -1234,6 +1552,334 @@ void UDelaunayTriangulationLibrary::BowyerWatson3D(TArray<FTetrahedron*>& Tetrah
     }
 }
 
+FTetrahedron UDelaunayTriangulationLibrary::MakeBoundaryTetrahedron(FIntVector GridSize)
+{
+    const float GridWidth = GridSize.X > GridSize.Y ? GridSize.X : GridSize.Y;
+
+    return FTetrahedron
+    {
+        FVector{ (GridWidth * .5f),     (GridWidth * .5f),      (GridSize.Z * 4.1f) },
+        FVector{ (GridWidth * -1.25f),  (GridWidth * -2.1f),    (GridSize.Z * -1.1f) },
+        FVector{ (GridWidth * 4.f),     (GridWidth * .5f),      (GridSize.Z * -1.1f) },
+        FVector{ (GridWidth * -1.25f),  (GridWidth * 3.1f),     (GridSize.Z * -1.1f) }
+    };
+}
+
+void UDelaunayTriangulationLibrary::InsertPointIntoTetrahedraArray(FTetrahedralizationData& Tetrahedralization, FVector Point, TArray<FTetrahedron>& RemovedTetrahedra, TArray<FTetrahedron>& AddedTetrahedra)
+{
+    const TArray<FTetrahedron>& TetrahedraArray = Tetrahedralization.TetrahedraArray;
+
+    // Step 1. Find the tetrahedron containing the point, its circumsphere always contains the point
+    const int32 StartIndex = LocateTetrahedron(Tetrahedralization, Point);
+    if (StartIndex == INDEX_NONE)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UDelaunayTriangulationLibrary::InsertPointIntoTetrahedraArray Point %s is not inside any tetrahedron!"), *Point.ToString());
+        return;
+    }
+
+    // Step 2. Grow the cavity through the face neighbours whose circumsphere contains the point, the faces leading out of the cavity are its boundary
+    TArray<int32> CavityIndices{ StartIndex };
+    TSet<int32> VisitedIndices{ StartIndex };
+    TArray<FTriangle> BoundaryFaces;
+
+    for (int32 CavityIteration = 0; CavityIteration < CavityIndices.Num(); CavityIteration++)
+    {
+        const int32 CavityIndex = CavityIndices[CavityIteration];
+        const FTetrahedron& CavityTetrahedron = TetrahedraArray[CavityIndex];
+
+        const FTriangle TetrahedronFaces[4]
+        {
+            FTriangle{ CavityTetrahedron.B, CavityTetrahedron.A, CavityTetrahedron.C },
+            FTriangle{ CavityTetrahedron.C, CavityTetrahedron.A, CavityTetrahedron.D },
+            FTriangle{ CavityTetrahedron.D, CavityTetrahedron.A, CavityTetrahedron.B },
+            FTriangle{ CavityTetrahedron.D, CavityTetrahedron.B, CavityTetrahedron.C }
+        };
+
+        for (const FTriangle& CurrentFace : TetrahedronFaces)
+        {
+            const int32 NeighbourIndex = GetNeighbourTetrahedron(Tetrahedralization, CavityIndex, GetFaceKey(CurrentFace.A, CurrentFace.B, CurrentFace.C));
+
+            if (NeighbourIndex == INDEX_NONE)
+            {
+                BoundaryFaces.Add(CurrentFace);
+                continue;
+            }
+
+            bool bIsAlreadyVisited = false;
+            VisitedIndices.Add(NeighbourIndex, &bIsAlreadyVisited);
+
+            if (!bIsAlreadyVisited)
+            {
+                if (IsPointInsideCircumsphere(TetrahedraArray[NeighbourIndex], Point))
+                {
+                    CavityIndices.Add(NeighbourIndex);
+                    continue;
+                }
+            }
+            else if (CavityIndices.Contains(NeighbourIndex)) { continue; }
+
+            BoundaryFaces.Add(CurrentFace);
+        }
+    }
+
+    // Step 3. Remove the cavity, highest index first so the swapped tetrahedra are never part of the cavity
+    CavityIndices.Sort(TGreater<int32>());
+
+    for (int32 CavityIndex : CavityIndices)
+    {
+        RemovedTetrahedra.Add(TetrahedraArray[CavityIndex]);
+        RemoveTetrahedron(Tetrahedralization, CavityIndex);
+    }
+
+    // Step 4. Connect the point to each face of the cavity boundary
+    for (const FTriangle& CurrentFace : BoundaryFaces)
+    {
+        const FTetrahedron NewTetrahedron{ Point, CurrentFace.A, CurrentFace.B, CurrentFace.C };
+
+        AddTetrahedron(Tetrahedralization, NewTetrahedron);
+        AddedTetrahedra.Add(NewTetrahedron);
+    }
+}
+
+int32 UDelaunayTriangulationLibrary::LocateTetrahedron(const FTetrahedralizationData& Tetrahedralization, const FVector& Point)
+{
+    const TArray<FTetrahedron>& TetrahedraArray = Tetrahedralization.TetrahedraArray;
+
+    if (TetrahedraArray.IsEmpty()) { return INDEX_NONE; }
+
+    // Walk towards the point, crossing any face that has the point on the other side from the opposite vertex
+    int32 CurrentIndex = TetrahedraArray.Num() - 1;
+
+    for (int32 Step = 0; Step < TetrahedraArray.Num() && CurrentIndex != INDEX_NONE; Step++)
+    {
+        const FTetrahedron& CurrentTetrahedron = TetrahedraArray[CurrentIndex];
+
+        const FVector FaceVertices[4][4]
+        {
+            { CurrentTetrahedron.B, CurrentTetrahedron.C, CurrentTetrahedron.D, CurrentTetrahedron.A },
+            { CurrentTetrahedron.A, CurrentTetrahedron.C, CurrentTetrahedron.D, CurrentTetrahedron.B },
+            { CurrentTetrahedron.A, CurrentTetrahedron.B, CurrentTetrahedron.D, CurrentTetrahedron.C },
+            { CurrentTetrahedron.A, CurrentTetrahedron.B, CurrentTetrahedron.C, CurrentTetrahedron.D }
+        };
+
+        int32 NextIndex = CurrentIndex;
+
+        for (const FVector (&Face)[4] : FaceVertices)
+        {
+            const double OppositeSide = GetOrientation(Face[0], Face[1], Face[2], Face[3]);
+            const double PointSide = GetOrientation(Face[0], Face[1], Face[2], Point);
+
+            if (OppositeSide * PointSide < 0.0)
+            {
+                NextIndex = GetNeighbourTetrahedron(Tetrahedralization, CurrentIndex, GetFaceKey(Face[0], Face[1], Face[2]));
+                break;
+            }
+        }
+
+        if (NextIndex == CurrentIndex) { return CurrentIndex; }
+
+        CurrentIndex = NextIndex;
+    }
+
+    // The walk left the boundary tetrahedron or went round a degenerate cycle, so fall back to checking every tetrahedron
+    for (int32 i = 0; i < TetrahedraArray.Num(); i++)
+    {
+        if (IsPointInsideTetrahedron(TetrahedraArray[i], Point)) { return i; }
+    }
+
+    return INDEX_NONE;
+}
+
+int32 UDelaunayTriangulationLibrary::GetNeighbourTetrahedron(const FTetrahedralizationData& Tetrahedralization, int32 TetrahedronIndex, const FTetrahedronFaceKey& FaceKey)
+{
+    if (const TArray<int32, TInlineAllocator<2>>* FaceIndices = Tetrahedralization.FaceTetrahedra.Find(FaceKey))
+    {
+        for (int32 FaceIndex : *FaceIndices)
+        {
+            if (FaceIndex != TetrahedronIndex) { return FaceIndex; }
+        }
+    }
+
+    return INDEX_NONE;
+}
+
+FTetrahedronFaceKey UDelaunayTriangulationLibrary::GetFaceKey(const FVector& A, const FVector& B, const FVector& C)
+{
+    auto IsVertexLess = [](const FVector& VertexA, const FVector& VertexB) -> bool
+    {
+        return VertexA.X != VertexB.X ? VertexA.X < VertexB.X : (VertexA.Y != VertexB.Y ? VertexA.Y < VertexB.Y : VertexA.Z < VertexB.Z);
+    };
+
+    FVector Vertices[3]{ A, B, C };
+
+    if (IsVertexLess(Vertices[1], Vertices[0])) { Swap(Vertices[0], Vertices[1]); }
+    if (IsVertexLess(Vertices[2], Vertices[1])) { Swap(Vertices[1], Vertices[2]); }
+    if (IsVertexLess(Vertices[1], Vertices[0])) { Swap(Vertices[0], Vertices[1]); }
+
+    return FTetrahedronFaceKey(Vertices[0], Vertices[1], Vertices[2]);
+}
+
+bool UDelaunayTriangulationLibrary::IsPointInsideCircumsphere(const FTetrahedron& Tetrahedron, const FVector& Point)
+{
+    FVector Centre;
+    double RadiusSquared;
+    if (!GetCircumsphere(Tetrahedron, Centre, RadiusSquared)) { return false; }
+
+    return FVector::DistSquared(Centre, Point) < RadiusSquared - RadiusSquared * 1e-9;
+}
+
+void UDelaunayTriangulationLibrary::UpdateEdgeReferenceCount(FTetrahedralizationData& Tetrahedralization, const FTetrahedron& Tetrahedron, int32 Delta)
+{
+    const FVector Vertices[4]{ Tetrahedron.A, Tetrahedron.B, Tetrahedron.C, Tetrahedron.D };
+
+    for (int32 i = 0; i < 4; i++)
+    {
+        FIntVector PointA;
+        if (!GetInsertedPoint(Tetrahedralization, Vertices[i], PointA)) { continue; }
+
+        for (int32 j = i + 1; j < 4; j++)
+        {
+            FIntVector PointB;
+            if (!GetInsertedPoint(Tetrahedralization, Vertices[j], PointB)) { continue; }
+
+            const FEdgeInfo Edge = GetOrderedEdge(PointA, PointB);
+
+            int32& ReferenceCount = Tetrahedralization.EdgeReferenceCount.FindOrAdd(Edge);
+            ReferenceCount += Delta;
+
+            if (ReferenceCount <= 0) { Tetrahedralization.EdgeReferenceCount.Remove(Edge); }
+        }
+    }
+}
+
+bool UDelaunayTriangulationLibrary::GetInsertedPoint(const FTetrahedralizationData& Tetrahedralization, const FVector& Vertex, FIntVector& OutPoint)
+{
+    OutPoint = (FIntVector)Vertex;
+
+    return (FVector)OutPoint == Vertex && Tetrahedralization.PointSet.Contains(OutPoint);
+}
+
+void UDelaunayTriangulationLibrary::AddTetrahedron(FTetrahedralizationData& Tetrahedralization, const FTetrahedron& Tetrahedron)
+{
+    const int32 TetrahedronIndex = Tetrahedralization.TetrahedraArray.Add(Tetrahedron);
+
+    for (const FVector& Vertex : { Tetrahedron.A, Tetrahedron.B, Tetrahedron.C, Tetrahedron.D })
+    {
+        FIntVector VertexPoint;
+        if (GetInsertedPoint(Tetrahedralization, Vertex, VertexPoint))
+        {
+            Tetrahedralization.PointTetrahedra.FindOrAdd(VertexPoint).Add(TetrahedronIndex);
+        }
+    }
+
+    for (const FTetrahedronFaceKey& FaceKey : { GetFaceKey(Tetrahedron.A, Tetrahedron.B, Tetrahedron.C), GetFaceKey(Tetrahedron.A, Tetrahedron.B, Tetrahedron.D),
+        GetFaceKey(Tetrahedron.A, Tetrahedron.C, Tetrahedron.D), GetFaceKey(Tetrahedron.B, Tetrahedron.C, Tetrahedron.D) })
+    {
+        Tetrahedralization.FaceTetrahedra.FindOrAdd(FaceKey).Add(TetrahedronIndex);
+    }
+}
+
+void UDelaunayTriangulationLibrary::RemoveTetrahedron(FTetrahedralizationData& Tetrahedralization, int32 TetrahedronIndex)
+{
+    TArray<FTetrahedron>& TetrahedraArray = Tetrahedralization.TetrahedraArray;
+    const int32 LastIndex = TetrahedraArray.Num() - 1;
+
+    const FTetrahedron& RemovedTetrahedron = TetrahedraArray[TetrahedronIndex];
+    for (const FVector& Vertex : { RemovedTetrahedron.A, RemovedTetrahedron.B, RemovedTetrahedron.C, RemovedTetrahedron.D })
+    {
+        FIntVector VertexPoint;
+        if (!GetInsertedPoint(Tetrahedralization, Vertex, VertexPoint)) { continue; }
+
+        if (TArray<int32>* IncidentIndices = Tetrahedralization.PointTetrahedra.Find(VertexPoint)) { IncidentIndices->RemoveSingleSwap(TetrahedronIndex); }
+    }
+
+    for (const FTetrahedronFaceKey& FaceKey : { GetFaceKey(RemovedTetrahedron.A, RemovedTetrahedron.B, RemovedTetrahedron.C), GetFaceKey(RemovedTetrahedron.A, RemovedTetrahedron.B, RemovedTetrahedron.D),
+        GetFaceKey(RemovedTetrahedron.A, RemovedTetrahedron.C, RemovedTetrahedron.D), GetFaceKey(RemovedTetrahedron.B, RemovedTetrahedron.C, RemovedTetrahedron.D) })
+    {
+        if (TArray<int32, TInlineAllocator<2>>* FaceIndices = Tetrahedralization.FaceTetrahedra.Find(FaceKey))
+        {
+            FaceIndices->RemoveSingleSwap(TetrahedronIndex);
+            if (FaceIndices->IsEmpty()) { Tetrahedralization.FaceTetrahedra.Remove(FaceKey); }
+        }
+    }
+
+    // The last tetrahedron is moved into the removed tetrahedron's place
+    if (TetrahedronIndex != LastIndex)
+    {
+        const FTetrahedron& MovedTetrahedron = TetrahedraArray[LastIndex];
+        for (const FVector& Vertex : { MovedTetrahedron.A, MovedTetrahedron.B, MovedTetrahedron.C, MovedTetrahedron.D })
+        {
+            FIntVector VertexPoint;
+            if (!GetInsertedPoint(Tetrahedralization, Vertex, VertexPoint)) { continue; }
+
+            if (TArray<int32>* IncidentIndices = Tetrahedralization.PointTetrahedra.Find(VertexPoint))
+            {
+                const int32 IncidentIndex = IncidentIndices->Find(LastIndex);
+                if (IncidentIndex != INDEX_NONE) { (*IncidentIndices)[IncidentIndex] = TetrahedronIndex; }
+            }
+        }
+
+        for (const FTetrahedronFaceKey& FaceKey : { GetFaceKey(MovedTetrahedron.A, MovedTetrahedron.B, MovedTetrahedron.C), GetFaceKey(MovedTetrahedron.A, MovedTetrahedron.B, MovedTetrahedron.D),
+            GetFaceKey(MovedTetrahedron.A, MovedTetrahedron.C, MovedTetrahedron.D), GetFaceKey(MovedTetrahedron.B, MovedTetrahedron.C, MovedTetrahedron.D) })
+        {
+            if (TArray<int32, TInlineAllocator<2>>* FaceIndices = Tetrahedralization.FaceTetrahedra.Find(FaceKey))
+            {
+                const int32 FaceIndex = FaceIndices->Find(LastIndex);
+                if (FaceIndex != INDEX_NONE) { (*FaceIndices)[FaceIndex] = TetrahedronIndex; }
+            }
+        }
+    }
+
+    TetrahedraArray.RemoveAtSwap(TetrahedronIndex);
+}
+
+double UDelaunayTriangulationLibrary::GetOrientation(const FVector& A, const FVector& B, const FVector& C, const FVector& Point)
+{
+    return FVector::DotProduct(FVector::CrossProduct(B - A, C - A), Point - A);
+}
+
+bool UDelaunayTriangulationLibrary::GetCircumsphere(const FTetrahedron& Tetrahedron, FVector& OutCentre, double& OutRadiusSquared)
+{
+    const FVector EdgeB = Tetrahedron.B - Tetrahedron.A;
+    const FVector EdgeC = Tetrahedron.C - Tetrahedron.A;
+    const FVector EdgeD = Tetrahedron.D - Tetrahedron.A;
+
+    const double Denominator = 2.0 * FVector::DotProduct(EdgeB, FVector::CrossProduct(EdgeC, EdgeD));
+    if (FMath::IsNearlyZero(Denominator)) { return false; }
+
+    const FVector Offset = (EdgeB.SizeSquared() * FVector::CrossProduct(EdgeC, EdgeD) +
+        EdgeC.SizeSquared() * FVector::CrossProduct(EdgeD, EdgeB) +
+        EdgeD.SizeSquared() * FVector::CrossProduct(EdgeB, EdgeC)) / Denominator;
+
+    OutCentre = Tetrahedron.A + Offset;
+    OutRadiusSquared = Offset.SizeSquared();
+
+    return true;
+}
+
+bool UDelaunayTriangulationLibrary::IsPointInsideTetrahedron(const FTetrahedron& Tetrahedron, const FVector& Point)
+{
+    // The point is inside if it lies on the same side of every face as the opposite vertex
+    auto IsOnSameSide = [](const FVector& V1, const FVector& V2, const FVector& V3, const FVector& V4, const FVector& P) -> bool
+    {
+        const FVector Normal = FVector::CrossProduct(V2 - V1, V3 - V1);
+        const double DotV4 = FVector::DotProduct(Normal, V4 - V1);
+        const double DotP = FVector::DotProduct(Normal, P - V1);
+
+        return FMath::Sign(DotV4) == FMath::Sign(DotP) || FMath::IsNearlyZero(DotP);
+    };
+
+    return IsOnSameSide(Tetrahedron.A, Tetrahedron.B, Tetrahedron.C, Tetrahedron.D, Point) &&
+        IsOnSameSide(Tetrahedron.B, Tetrahedron.C, Tetrahedron.D, Tetrahedron.A, Point) &&
+        IsOnSameSide(Tetrahedron.C, Tetrahedron.D, Tetrahedron.A, Tetrahedron.B, Point) &&
+        IsOnSameSide(Tetrahedron.D, Tetrahedron.A, Tetrahedron.B, Tetrahedron.C, Point);
+}
+
+double UDelaunayTriangulationLibrary::GetTetrahedronVolume(const FTetrahedron& Tetrahedron)
+{
+    return FMath::Abs(FVector::DotProduct(Tetrahedron.A - Tetrahedron.D, FVector::CrossProduct(Tetrahedron.B - Tetrahedron.D, Tetrahedron.C - Tetrahedron.D))) / 6.0;
+}
+
 bool UDelaunayTriangulationLibrary::IsTetrahedronAlreadyInArray(TArray<FTetrahedron*> TetrahedraArray, FTetrahedron* InTetrahedron)
 {
     TSet<FVector> TetrahedronVertices{ InTetrahedron->A, InTetrahedron->B, InTetrahedron->C, InTetrahedron->D };
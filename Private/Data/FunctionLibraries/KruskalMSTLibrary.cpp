@@ -3,143 +3,331 @@
 
 #include "Data/FunctionLibraries/KruskalMSTLibrary.h"
 #include "Kismet/KismetMathLibrary.h"
-#include "Kismet/KismetSystemLibrary.h"
-#include "Runtime\MeshUtilitiesCommon\Public\DisjointSet.h"
-//#include "DisjointSet.h"
+#include "Async/ParallelFor.h"
+#include "Data/FunctionLibraries/LevelGenerationDebugLibrary.h"
+
+// Below this many edges the Filter-Kruskal algorithm sorts the edges instead of partitioning them
+static constexpr int32 FilterKruskalSortThreshold = 1024;
+
+// The number of edges each task handles when partitioning or filtering edges in parallel
+static constexpr int32 FilterKruskalChunkSize = 4096;
 
 TArray<FEdgeInfo> UKruskalMSTLibrary::GetMinimumSpanningTree(TArray<FIntVector> PointArray, TArray<FQuarterEdge> QuarterEdgeArray, TArray<FEdgeInfo>& DiscardedEdgesArray)
 {
-	const int TreeSize = PointArray.Num() - 1.f;
-
 	TArray<FEdgeInfo> ConvertedEdgesArray;
+	ConvertedEdgesArray.Reserve(QuarterEdgeArray.Num());
 
-	for (FQuarterEdge CurrentEdge : QuarterEdgeArray)
+	for (FQuarterEdge& CurrentEdge : QuarterEdgeArray)
 	{
-		FEdgeInfo NewEdgeInfo{ (FIntVector)CurrentEdge.Data, (FIntVector)UDelaunayTriangulationLibrary::Destination(&CurrentEdge) };
-		//{ (FIntVector)CurrentEdge.Data, (FIntVector)UDelaunayTriangulationLibrary::Destination(&CurrentEdge), (CurrentEdge.Data - UDelaunayTriangulationLibrary::Destination(&CurrentEdge)).Length()};
-		ConvertedEdgesArray.Add(NewEdgeInfo);
+		ConvertedEdgesArray.Add(FEdgeInfo{ (FIntVector)CurrentEdge.Data, (FIntVector)UDelaunayTriangulationLibrary::Destination(&CurrentEdge) });
 	}
 
-	if (ConvertedEdgesArray.IsEmpty()) { return TArray<FEdgeInfo>(); }
+	return BuildMinimumSpanningTree(PointArray, ConvertedEdgesArray, DiscardedEdgesArray);
+}
 
-	TArray<FEdgeInfo> MinimumSpanningTree;
-	//TArray<FEdgeInfo> DiscardedEdgeArray;
+TArray<FEdgeInfo> UKruskalMSTLibrary::GetMinimumSpanningTreeV2(TArray<FIntVector> PointArray, TArray<FEdgeInfo> EdgeArray, TArray<FEdgeInfo>& DiscardedEdgesArray, EMinimumSpanningTreeAlgorithm Algorithm)
+{
+	switch (Algorithm)
+	{
+	case EMinimumSpanningTreeAlgorithm::FilterKruskal:
+		return BuildMinimumSpanningTreeFilterKruskal(PointArray, EdgeArray, DiscardedEdgesArray);
 
-	// TotalPoints = Points in grid
-	// EdgeCount = Edges connecting the points together
+	default:
+		return BuildMinimumSpanningTree(PointArray, EdgeArray, DiscardedEdgesArray);
+	}
+}
 
-	
-	// Step 1. Sort all edges in increasing order of their CurrentEdge weights.
+TArray<FEdgeInfo> UKruskalMSTLibrary::BuildMinimumSpanningTree(const TArray<FIntVector>& PointArray, const TArray<FEdgeInfo>& EdgeArray, TArray<FEdgeInfo>& DiscardedEdgesArray)
+{
+	if (EdgeArray.IsEmpty()) { return TArray<FEdgeInfo>(); }
 
-	//ConvertedEdgesArray.Sort(FEdgeInfo::EdgeComparison);
+	const int32 TreeSize = PointArray.Num() - 1;
 
-	ConvertedEdgesArray.Sort([](const FEdgeInfo& EdgeA, const FEdgeInfo& EdgeB) -> bool {
-		// sort by weight
-		if (EdgeA.Weight < EdgeB.Weight) return true;
-		if (EdgeA.Weight > EdgeB.Weight) return false;
-		else { return false; }
-		});
+	TArray<FEdgeInfo> MinimumSpanningTree;
+	MinimumSpanningTree.Reserve(FMath::Max(TreeSize, 0));
 
-	FDisjointSet DisjointSet(PointArray.Num());
+	TArray<FIndexedEdge> IndexedEdges = GetIndexedEdges(PointArray, EdgeArray, DiscardedEdgesArray);
 
-	do
-	{
-		// Step 2. Pick the smallest CurrentEdge.
-		FEdgeInfo SmallestEdge = ConvertedEdgesArray[0];
+	// Step 1. Sort the edges by weight
+	IndexedEdges.Sort();
 
-		float EdgeWeight = SmallestEdge.Weight;
-		int32 Origin;
-		int32 Destination;
+	FEdgeDisjointSet DisjointSet(PointArray.Num());
 
-		PointArray.Find(SmallestEdge.Origin, Origin);
-		PointArray.Find(SmallestEdge.Destination, Destination);
+	// Step 2. Pick the edges from smallest to largest
+	int32 EdgeIndex = 0;
+	for (; EdgeIndex < IndexedEdges.Num() && MinimumSpanningTree.Num() < TreeSize; EdgeIndex++)
+	{
+		const FIndexedEdge& CurrentEdge = IndexedEdges[EdgeIndex];
 
-		// Step 3. Check if the new CurrentEdge creates a cycle or loop in a spanning tree.
-		if (DisjointSet.Find(Origin) != DisjointSet.Find(Destination))
+		// Step 3. Include the edge in the MST if it doesn't form a cycle, otherwise discard it
+		if (DisjointSet.Union(CurrentEdge.Origin, CurrentEdge.Destination))
 		{
-			DisjointSet.Union(Origin, Destination);
-			MinimumSpanningTree.Add(SmallestEdge);
-			ConvertedEdgesArray.RemoveAt(0);
+			MinimumSpanningTree.Add(EdgeArray[CurrentEdge.EdgeIndex]);
 		}
-		// Step 4. If it doesnt form the cycle, then include that CurrentEdge in MST.Otherwise, discard it.
 		else
 		{
-			DiscardedEdgesArray.Add(SmallestEdge);
-			ConvertedEdgesArray.RemoveAt(0);
+			DiscardedEdgesArray.Add(EdgeArray[CurrentEdge.EdgeIndex]);
 		}
+	}
 
-		// Step 5. Repeat from step 2 until it includes | TotalPoints | -1 edges in MST.
-		if (MinimumSpanningTree.Num() == TreeSize) { break; }
-	} while (true);
-
-	if (!ConvertedEdgesArray.IsEmpty())
+	// Step 4. Once the MST has | TotalPoints | - 1 edges, every remaining edge is discarded
+	for (; EdgeIndex < IndexedEdges.Num(); EdgeIndex++)
 	{
-		for (FEdgeInfo CurrentEdge : ConvertedEdgesArray)
-		{
-			DiscardedEdgesArray.Add(CurrentEdge);
-		}
+		DiscardedEdgesArray.Add(EdgeArray[IndexedEdges[EdgeIndex].EdgeIndex]);
 	}
 
 	return MinimumSpanningTree;
 }
 
-TArray<FEdgeInfo> UKruskalMSTLibrary::GetMinimumSpanningTreeV2(TArray<FIntVector> PointArray, TArray<FEdgeInfo> EdgeArray, TArray<FEdgeInfo>& DiscardedEdgesArray)
+TArray<FEdgeInfo> UKruskalMSTLibrary::BuildMinimumSpanningTreeFilterKruskal(const TArray<FIntVector>& PointArray, const TArray<FEdgeInfo>& EdgeArray, TArray<FEdgeInfo>& DiscardedEdgesArray)
 {
-	const int TreeSize = PointArray.Num() - 1.f;
+	if (EdgeArray.IsEmpty()) { return TArray<FEdgeInfo>(); }
 
+	TArray<FIndexedEdge> IndexedEdges = GetIndexedEdges(PointArray, EdgeArray, DiscardedEdgesArray);
 
-	if (EdgeArray.IsEmpty()) { return TArray<FEdgeInfo>(); }
+	FEdgeDisjointSet DisjointSet(PointArray.Num());
+
+	TArray<FIndexedEdge> TreeEdges;
+	TArray<FIndexedEdge> DiscardedEdges;
+	FilterKruskal(IndexedEdges, DisjointSet, PointArray.Num() - 1, TreeEdges, DiscardedEdges);
+
+	// The tree edges are found in order of weight, the discarded edges are sorted so they match the order Kruskal's algorithm discards them in
+	DiscardedEdges.Sort();
 
 	TArray<FEdgeInfo> MinimumSpanningTree;
+	MinimumSpanningTree.Reserve(TreeEdges.Num());
 
-	EdgeArray.Sort([](const FEdgeInfo& EdgeA, const FEdgeInfo& EdgeB) -> bool {
-		// Step 1. Sort the edges by weight
-		if (EdgeA.Weight < EdgeB.Weight) return true;
-		if (EdgeA.Weight > EdgeB.Weight) return false;
-		else { return false; }
-		});
+	for (const FIndexedEdge& CurrentEdge : TreeEdges)
+	{
+		MinimumSpanningTree.Add(EdgeArray[CurrentEdge.EdgeIndex]);
+	}
 
-	FDisjointSet DisjointSet(PointArray.Num());
+	DiscardedEdgesArray.Reserve(DiscardedEdgesArray.Num() + DiscardedEdges.Num());
 
-	do
+	for (const FIndexedEdge& CurrentEdge : DiscardedEdges)
 	{
-		// Step 2. Pick the smallest CurrentEdge.
-		FEdgeInfo SmallestEdge = EdgeArray[0];
+		DiscardedEdgesArray.Add(EdgeArray[CurrentEdge.EdgeIndex]);
+	}
+
+	return MinimumSpanningTree;
+}
 
-		float EdgeWeight = SmallestEdge.Weight;
-		int32 Origin;
-		int32 Destination;
+void UKruskalMSTLibrary::FilterKruskal(TArray<FIndexedEdge>& IndexedEdges, FEdgeDisjointSet& DisjointSet, int32 TreeSize, TArray<FIndexedEdge>& TreeEdges, TArray<FIndexedEdge>& DiscardedEdges)
+{
+	// Once the MST is complete every remaining edge is discarded
+	if (TreeEdges.Num() >= TreeSize)
+	{
+		DiscardedEdges.Append(IndexedEdges);
+		return;
+	}
 
-		PointArray.Find(SmallestEdge.Origin, Origin);
-		PointArray.Find(SmallestEdge.Destination, Destination);
+	auto SortAndScan = [&]()
+	{
+		IndexedEdges.Sort();
 
-		// Step 3. Check if the new CurrentEdge creates a cycle or loop in a spanning tree.
-		if (DisjointSet.Find(Origin) != DisjointSet.Find(Destination))
+		for (const FIndexedEdge& CurrentEdge : IndexedEdges)
 		{
-			DisjointSet.Union(Origin, Destination);
-			MinimumSpanningTree.Add(SmallestEdge);
-			EdgeArray.RemoveAt(0);
+			if (TreeEdges.Num() < TreeSize && DisjointSet.Union(CurrentEdge.Origin, CurrentEdge.Destination)) { TreeEdges.Add(CurrentEdge); }
+			else { DiscardedEdges.Add(CurrentEdge); }
 		}
-		// Step 4. If it doesnt form the cycle, then include that CurrentEdge in MST.Otherwise, discard it.
-		else
+	};
+
+	if (IndexedEdges.Num() <= FilterKruskalSortThreshold)
+	{
+		SortAndScan();
+		return;
+	}
+
+	// Step 1. Pick the median of the first, middle and last edges as the pivot
+	FIndexedEdge Pivot[3]{ IndexedEdges[0], IndexedEdges[IndexedEdges.Num() / 2], IndexedEdges.Last() };
+	if (Pivot[1] < Pivot[0]) { Swap(Pivot[0], Pivot[1]); }
+	if (Pivot[2] < Pivot[1]) { Swap(Pivot[1], Pivot[2]); }
+	if (Pivot[1] < Pivot[0]) { Swap(Pivot[0], Pivot[1]); }
+	const FIndexedEdge& PivotEdge = Pivot[1];
+
+	// Step 2. Partition the edges into light and heavy edges in parallel, the chunks are joined in order so the result never depends on thread timing
+	const int32 ChunkCount = FMath::DivideAndRoundUp(IndexedEdges.Num(), FilterKruskalChunkSize);
+
+	TArray<TArray<FIndexedEdge>> LightChunks;
+	TArray<TArray<FIndexedEdge>> HeavyChunks;
+	LightChunks.SetNum(ChunkCount);
+	HeavyChunks.SetNum(ChunkCount);
+
+	ParallelFor(ChunkCount, [&](int32 ChunkIndex)
+		{
+			const int32 ChunkStart = ChunkIndex * FilterKruskalChunkSize;
+			const int32 ChunkEnd = FMath::Min(ChunkStart + FilterKruskalChunkSize, IndexedEdges.Num());
+
+			for (int32 i = ChunkStart; i < ChunkEnd; i++)
+			{
+				if (PivotEdge < IndexedEdges[i]) { HeavyChunks[ChunkIndex].Add(IndexedEdges[i]); }
+				else { LightChunks[ChunkIndex].Add(IndexedEdges[i]); }
+			}
+		});
+
+	TArray<FIndexedEdge> LightEdges;
+	TArray<FIndexedEdge> HeavyEdges;
+
+	for (int32 ChunkIndex = 0; ChunkIndex < ChunkCount; ChunkIndex++)
+	{
+		LightEdges.Append(LightChunks[ChunkIndex]);
+		HeavyEdges.Append(HeavyChunks[ChunkIndex]);
+	}
+
+	// Every edge is equal to the pivot, partitioning further would not make progress
+	if (HeavyEdges.IsEmpty())
+	{
+		SortAndScan();
+		return;
+	}
+
+	// Step 3. Solve the light edges
+	FilterKruskal(LightEdges, DisjointSet, TreeSize, TreeEdges, DiscardedEdges);
+
+	if (TreeEdges.Num() >= TreeSize)
+	{
+		DiscardedEdges.Append(HeavyEdges);
+		return;
+	}
+
+	// Step 4. Filter out the heavy edges whose points are already connected, no unions happen during the filter so the set can be read in parallel
+	TArray<TArray<FIndexedEdge>> RemainingChunks;
+	TArray<TArray<FIndexedEdge>> FilteredChunks;
+	const int32 HeavyChunkCount = FMath::DivideAndRoundUp(HeavyEdges.Num(), FilterKruskalChunkSize);
+	RemainingChunks.SetNum(HeavyChunkCount);
+	FilteredChunks.SetNum(HeavyChunkCount);
+
+	const FEdgeDisjointSet& ConstDisjointSet = DisjointSet;
+
+	ParallelFor(HeavyChunkCount, [&](int32 ChunkIndex)
 		{
-			DiscardedEdgesArray.Add(SmallestEdge);
-			EdgeArray.RemoveAt(0);
+			const int32 ChunkStart = ChunkIndex * FilterKruskalChunkSize;
+			const int32 ChunkEnd = FMath::Min(ChunkStart + FilterKruskalChunkSize, HeavyEdges.Num());
+
+			for (int32 i = ChunkStart; i < ChunkEnd; i++)
+			{
+				const FIndexedEdge& CurrentEdge = HeavyEdges[i];
+
+				if (ConstDisjointSet.FindWithoutCompression(CurrentEdge.Origin) == ConstDisjointSet.FindWithoutCompression(CurrentEdge.Destination)) { FilteredChunks[ChunkIndex].Add(CurrentEdge); }
+				else { RemainingChunks[ChunkIndex].Add(CurrentEdge); }
+			}
+		});
+
+	TArray<FIndexedEdge> RemainingEdges;
+
+	for (int32 ChunkIndex = 0; ChunkIndex < HeavyChunkCount; ChunkIndex++)
+	{
+		RemainingEdges.Append(RemainingChunks[ChunkIndex]);
+		DiscardedEdges.Append(FilteredChunks[ChunkIndex]);
+	}
+
+	// Step 5. Solve the remaining heavy edges
+	FilterKruskal(RemainingEdges, DisjointSet, TreeSize, TreeEdges, DiscardedEdges);
+}
+
+TArray<FIndexedEdge> UKruskalMSTLibrary::GetIndexedEdges(const TArray<FIntVector>& PointArray, const TArray<FEdgeInfo>& EdgeArray, TArray<FEdgeInfo>& DiscardedEdgesArray)
+{
+	TMap<FIntVector, int32> PointIndexMap;
+	PointIndexMap.Reserve(PointArray.Num());
+
+	for (int32 i = 0; i < PointArray.Num(); i++)
+	{
+		PointIndexMap.Add(PointArray[i], i);
+	}
+
+	TArray<FIndexedEdge> IndexedEdges;
+	IndexedEdges.Reserve(EdgeArray.Num());
+
+	for (int32 i = 0; i < EdgeArray.Num(); i++)
+	{
+		const int32* Origin = PointIndexMap.Find(EdgeArray[i].Origin);
+		const int32* Destination = PointIndexMap.Find(EdgeArray[i].Destination);
+
+		if (!Origin || !Destination)
+		{
+			DiscardedEdgesArray.Add(EdgeArray[i]);
+			continue;
 		}
 
-		// Step 5. Repeat from step 2 until it includes | TotalPoints | -1 edges in MST.
-		if (MinimumSpanningTree.Num() == TreeSize) { break; }
-	} while (true);
+		IndexedEdges.Add(FIndexedEdge{ *Origin, *Destination, EdgeArray[i].Weight, i });
+	}
+
+	return IndexedEdges;
+}
+
+void UKruskalMSTLibrary::AddPointToMinimumSpanningTree(TArray<FEdgeInfo>& MinimumSpanningTree, const TArray<FEdgeInfo>& NewPointEdges, TArray<FEdgeInfo>& DiscardedEdgesArray)
+{
+	if (NewPointEdges.IsEmpty()) { return; }
+
+	// Any edge that was not in the old tree is still not needed, so only the old tree and the new edges have to be considered
+	TArray<FEdgeInfo> CandidateEdges = MinimumSpanningTree;
+	CandidateEdges.Append(NewPointEdges);
+
+	TSet<FIntVector> PointSet;
+	for (const FEdgeInfo& CurrentEdge : CandidateEdges)
+	{
+		PointSet.Add(CurrentEdge.Origin);
+		PointSet.Add(CurrentEdge.Destination);
+	}
+
+	TArray<FEdgeInfo> CandidateDiscardedEdges;
+	MinimumSpanningTree = GetMinimumSpanningTreeV2(PointSet.Array(), CandidateEdges, CandidateDiscardedEdges);
+
+	DiscardedEdgesArray.Append(CandidateDiscardedEdges);
+}
+
+void UKruskalMSTLibrary::RemovePointFromMinimumSpanningTree(TArray<FEdgeInfo>& MinimumSpanningTree, FIntVector RemovedPoint, const TArray<FEdgeInfo>& NeighbourEdges)
+{
+	// Step 1. Remove the tree edges connected to the removed point, which splits the tree into one piece per removed edge
+	const int32 PieceCount = MinimumSpanningTree.RemoveAll([&RemovedPoint](const FEdgeInfo& CurrentEdge) {
+		return CurrentEdge.Origin == RemovedPoint || CurrentEdge.Destination == RemovedPoint;
+		});
+
+	// Removing a leaf leaves the rest of the tree connected
+	if (PieceCount < 2) { return; }
+
+	// Step 2. Find the piece each point belongs to from the remaining tree edges, the rest of the graph is not needed
+	TMap<FIntVector, int32> PointIndexMap;
+	PointIndexMap.Reserve(MinimumSpanningTree.Num() + 1);
+
+	for (const FEdgeInfo& CurrentEdge : MinimumSpanningTree)
+	{
+		PointIndexMap.FindOrAdd(CurrentEdge.Origin, PointIndexMap.Num());
+		PointIndexMap.FindOrAdd(CurrentEdge.Destination, PointIndexMap.Num());
+	}
+
+	for (const FEdgeInfo& CurrentEdge : NeighbourEdges)
+	{
+		PointIndexMap.FindOrAdd(CurrentEdge.Origin, PointIndexMap.Num());
+		PointIndexMap.FindOrAdd(CurrentEdge.Destination, PointIndexMap.Num());
+	}
+
+	FEdgeDisjointSet DisjointSet(PointIndexMap.Num());
 
-	if (!EdgeArray.IsEmpty())
+	for (const FEdgeInfo& CurrentEdge : MinimumSpanningTree)
 	{
-		for (FEdgeInfo CurrentEdge : EdgeArray)
+		DisjointSet.Union(PointIndexMap[CurrentEdge.Origin], PointIndexMap[CurrentEdge.Destination]);
+	}
+
+	// Step 3. Every piece contains a neighbour of the removed point, so they are reconnected using only the shortest edges between the neighbours
+	TArray<FEdgeInfo> SortedNeighbourEdges = NeighbourEdges;
+	SortedNeighbourEdges.StableSort([](const FEdgeInfo& EdgeA, const FEdgeInfo& EdgeB) -> bool {
+		return EdgeA.Weight < EdgeB.Weight;
+		});
+
+	int32 RemainingPieces = PieceCount;
+
+	for (const FEdgeInfo& CurrentEdge : SortedNeighbourEdges)
+	{
+		if (DisjointSet.Union(PointIndexMap[CurrentEdge.Origin], PointIndexMap[CurrentEdge.Destination]))
 		{
-			DiscardedEdgesArray.Add(CurrentEdge);
+			MinimumSpanningTree.Add(CurrentEdge);
+
+			if (--RemainingPieces == 1) { return; }
 		}
 	}
 
-	return MinimumSpanningTree;
+	UE_LOG(LogTemp, Warning, TEXT("UKruskalMSTLibrary::RemovePointFromMinimumSpanningTree %d pieces of the tree could not be reconnected after removing %s!"), RemainingPieces, *RemovedPoint.ToString());
 }
 
 bool UKruskalMSTLibrary::EdgeComparison(const FEdgeInfo& EdgeA, const FEdgeInfo& EdgeB)
@@ -154,17 +342,7 @@ bool UKruskalMSTLibrary::EdgeComparison(const FEdgeInfo& EdgeA, const FEdgeInfo&
 
 void UKruskalMSTLibrary::DrawMST(TArray<FEdgeInfo> EdgeArray, UObject* WorldRef, int TileSize, FLinearColor TraceColour)
 {
-	if (!WorldRef) { return; }
-
-	for (FEdgeInfo CurrentEdge : EdgeArray)
-	{
-		FVector Start = (FVector)CurrentEdge.Origin * TileSize;
-		FVector End = (FVector)CurrentEdge.Destination * TileSize;
-
-		TArray<FHitResult> HitResults;
-
-		UKismetSystemLibrary::LineTraceMulti(WorldRef, Start + FVector(0.f, 0.f, 1000.f), End + FVector(0.f, 0.f, 1000.f), ETraceTypeQuery::TraceTypeQuery1, false, TArray<AActor*>(), EDrawDebugTrace::Persistent, HitResults, false, TraceColour);
-	}
+	ULevelGenerationDebugLibrary::DrawEdgeLines(WorldRef, EdgeArray, TileSize, FLevelGenerationDebugDrawOptions(), TraceColour);
 }
 
 void UKruskalMSTLibrary::RandomlyAddEdgesToMST(TArray<FEdgeInfo>& MinimumSpanningTree, TArray<FEdgeInfo> DiscardedEdgesArray, FRandomStream Stream, float AddToMSTChance)
@@ -0,0 +1,153 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/FunctionLibraries/LevelGenerationDebugLibrary.h"
+#include "Components/LineBatchComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+void ULevelGenerationDebugLibrary::BuildDebugLines(const FLevelGenerationSettings& LevelGenerationSettings, const FGeneratedLevelData& GeneratedLevelData, const FLevelGenerationDebugDrawOptions& DrawOptions, TArray<FBatchedLine>& OutLines)
+{
+	const int32 TileSize = LevelGenerationSettings.TileSize;
+
+	// Step 1. Corridors of the level
+	if (DrawOptions.bDrawMinimumSpanningTree)
+	{
+		AddEdgeLines(GeneratedLevelData.MinimumSpanningTree, TileSize, DrawOptions, DrawOptions.MinimumSpanningTreeColour, OutLines);
+	}
+
+	// Step 2. Edges of the room graph that were not used
+	if (DrawOptions.bDrawDiscardedEdges)
+	{
+		AddEdgeLines(GeneratedLevelData.DebugData.DiscardedEdges, TileSize, DrawOptions, DrawOptions.DiscardedEdgeColour, OutLines);
+	}
+
+	// Step 3. Nodes explored by each A* Pathfinding search
+	if (DrawOptions.bDrawExploredNodes)
+	{
+		for (const FCorridorSearchDebugData& CorridorSearch : GeneratedLevelData.DebugData.CorridorSearches)
+		{
+			const FLinearColor& SearchColour = CorridorSearch.bPathFound ? DrawOptions.ExploredNodeColour : DrawOptions.FailedSearchColour;
+
+			for (const FIntVector& ExploredNode : CorridorSearch.ExploredNodes)
+			{
+				AddTileCross(ExploredNode, TileSize, DrawOptions, SearchColour, OutLines);
+			}
+		}
+	}
+
+	// Step 4. Occupied tiles on a single floor of the level grid
+	if (DrawOptions.bDrawOccupancySlice)
+	{
+		for (const TPair<FIntVector, FTileInstanceData>& CurrentTile : GeneratedLevelData.LevelTileData)
+		{
+			if (CurrentTile.Key.Z != DrawOptions.OccupancySliceZ) { continue; }
+
+			const FTileTemplate* CurrentTemplate = GeneratedLevelData.GetTileTemplate(CurrentTile.Value);
+			if (!CurrentTemplate) { continue; }
+
+			switch (CurrentTemplate->TileType)
+			{
+			case ETileType::Room_Basic:
+			case ETileType::Room_Key:
+			case ETileType::Room_Special:
+			case ETileType::Room_Section:
+				AddTileOutline(CurrentTile.Key, TileSize, DrawOptions, DrawOptions.RoomTileColour, OutLines);
+				break;
+			case ETileType::Corridor:
+			case ETileType::Corridor_Section:
+			case ETileType::Corridor_Special:
+				AddTileOutline(CurrentTile.Key, TileSize, DrawOptions, DrawOptions.CorridorTileColour, OutLines);
+				break;
+			default:
+				break;
+			}
+		}
+
+		for (const TPair<FIntVector, FTileSectionData>& CurrentSection : GeneratedLevelData.LevelSectionData)
+		{
+			if (CurrentSection.Key.Z != DrawOptions.OccupancySliceZ) { continue; }
+
+			const FLinearColor& SectionColour = CurrentSection.Value.TileType == ETileType::Room_Section ? DrawOptions.RoomTileColour : DrawOptions.CorridorTileColour;
+			AddTileOutline(CurrentSection.Key, TileSize, DrawOptions, SectionColour, OutLines);
+		}
+	}
+}
+
+void ULevelGenerationDebugLibrary::DrawDebugLines(ULineBatchComponent* LineBatcher, const FLevelGenerationSettings& LevelGenerationSettings, const FGeneratedLevelData& GeneratedLevelData, const FLevelGenerationDebugDrawOptions& DrawOptions)
+{
+	if (!LineBatcher)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ULevelGenerationDebugLibrary::DrawDebugLines LineBatcher is invalid!"));
+		return;
+	}
+
+	TArray<FBatchedLine> Lines;
+	BuildDebugLines(LevelGenerationSettings, GeneratedLevelData, DrawOptions, Lines);
+
+	LineBatcher->Flush();
+	LineBatcher->DrawLines(Lines);
+}
+
+void ULevelGenerationDebugLibrary::DrawEdgeLines(UObject* WorldContextObject, const TArray<FEdgeInfo>& EdgeArray, int32 TileSize, const FLevelGenerationDebugDrawOptions& DrawOptions, const FLinearColor& Colour)
+{
+	if (!WorldContextObject) { return; }
+
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World || !World->PersistentLineBatcher) { return; }
+
+	TArray<FBatchedLine> Lines;
+	AddEdgeLines(EdgeArray, TileSize, DrawOptions, Colour, Lines);
+
+	World->PersistentLineBatcher->DrawLines(Lines);
+}
+
+void ULevelGenerationDebugLibrary::ClearDebugLines(ULineBatchComponent* LineBatcher)
+{
+	if (!LineBatcher) { return; }
+
+	LineBatcher->Flush();
+}
+
+void ULevelGenerationDebugLibrary::AddEdgeLines(const TArray<FEdgeInfo>& EdgeArray, int32 TileSize, const FLevelGenerationDebugDrawOptions& DrawOptions, const FLinearColor& Colour, TArray<FBatchedLine>& OutLines)
+{
+	OutLines.Reserve(OutLines.Num() + EdgeArray.Num());
+
+	for (const FEdgeInfo& CurrentEdge : EdgeArray)
+	{
+		OutLines.Emplace(GetDebugLocation(CurrentEdge.Origin, TileSize, DrawOptions), GetDebugLocation(CurrentEdge.Destination, TileSize, DrawOptions), Colour, 0.f, DrawOptions.LineThickness, SDPG_World);
+	}
+}
+
+void ULevelGenerationDebugLibrary::AddTileCross(const FIntVector& Coordinate, int32 TileSize, const FLevelGenerationDebugDrawOptions& DrawOptions, const FLinearColor& Colour, TArray<FBatchedLine>& OutLines)
+{
+	const FVector Centre = GetDebugLocation(Coordinate, TileSize, DrawOptions);
+	const float HalfExtent = TileSize * 0.25f;
+
+	OutLines.Emplace(Centre - FVector(HalfExtent, HalfExtent, 0.f), Centre + FVector(HalfExtent, HalfExtent, 0.f), Colour, 0.f, DrawOptions.LineThickness, SDPG_World);
+	OutLines.Emplace(Centre - FVector(HalfExtent, -HalfExtent, 0.f), Centre + FVector(HalfExtent, -HalfExtent, 0.f), Colour, 0.f, DrawOptions.LineThickness, SDPG_World);
+}
+
+void ULevelGenerationDebugLibrary::AddTileOutline(const FIntVector& Coordinate, int32 TileSize, const FLevelGenerationDebugDrawOptions& DrawOptions, const FLinearColor& Colour, TArray<FBatchedLine>& OutLines)
+{
+	const FVector Centre = GetDebugLocation(Coordinate, TileSize, DrawOptions);
+	const float HalfExtent = TileSize * 0.5f;
+
+	const FVector Corners[4]
+	{
+		Centre + FVector(-HalfExtent, -HalfExtent, 0.f),
+		Centre + FVector(HalfExtent, -HalfExtent, 0.f),
+		Centre + FVector(HalfExtent, HalfExtent, 0.f),
+		Centre + FVector(-HalfExtent, HalfExtent, 0.f)
+	};
+
+	for (int32 i = 0; i < 4; i++)
+	{
+		OutLines.Emplace(Corners[i], Corners[(i + 1) % 4], Colour, 0.f, DrawOptions.LineThickness, SDPG_World);
+	}
+}
+
+FVector ULevelGenerationDebugLibrary::GetDebugLocation(const FIntVector& Coordinate, int32 TileSize, const FLevelGenerationDebugDrawOptions& DrawOptions)
+{
+	return (FVector)Coordinate * TileSize + FVector(0.f, 0.f, DrawOptions.HeightOffset);
+}
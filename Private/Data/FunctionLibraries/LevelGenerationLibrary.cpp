@@ -9,9 +9,12 @@
 #include "Engine/LevelStreaming.h"
 #include "Engine/LevelStreamingDynamic.h"
 #include "Engine/StreamableManager.h"
+#include "Async/ParallelFor.h"
 #include "Data/FunctionLibraries/DelaunayTriangulationLibrary.h"
 #include "Data/FunctionLibraries/KruskalMSTLibrary.h"
+#include "Data/FunctionLibraries/LevelGenerationDebugLibrary.h"
 #include "Data/LevelGenerationData.h"
+#include "Data/LevelGenerationTrace.h"
 
 // TMap containing the coordinates for each cardinal direction.
 static TMap<EDirections, FIntVector> DirectionCoordinates
@@ -25,6 +28,52 @@ static TMap<EDirections, FIntVector> DirectionCoordinates
 	{EDirections::Below,	FIntVector(0,0,-1)}
 };
 
+// Number of A* Pathfinding nodes expanded between each check for a cancelled generation.
+static constexpr int32 PathExpansionsPerCancellationCheck = 64;
+
+// Bits of the horizontal directions a corridor can connect to.
+static constexpr uint8 CorridorConnectionNorth = 1 << 0;
+static constexpr uint8 CorridorConnectionEast = 1 << 1;
+static constexpr uint8 CorridorConnectionSouth = 1 << 2;
+static constexpr uint8 CorridorConnectionWest = 1 << 3;
+
+// The basic corridor section and its yaw for a set of connections.
+struct FCorridorPiece
+{
+	ECorridorType CorridorType;
+	float Yaw;
+};
+
+// Table of the basic corridor section for each combination of connections, indexed by the connection mask (North = 1, East = 2, South = 4, West = 8).
+static constexpr FCorridorPiece CorridorPieceTable[16]
+{
+	{ ECorridorType::ZeroWay,	0.f },		// None
+	{ ECorridorType::OneWay,	0.f },		// N
+	{ ECorridorType::OneWay,	90.f },		// E
+	{ ECorridorType::Corner,	0.f },		// N E
+	{ ECorridorType::OneWay,	180.f },	// S
+	{ ECorridorType::TwoWay,	0.f },		// N S
+	{ ECorridorType::Corner,	90.f },		// E S
+	{ ECorridorType::ThreeWay,	0.f },		// N E S
+	{ ECorridorType::OneWay,	270.f },	// W
+	{ ECorridorType::Corner,	270.f },	// N W
+	{ ECorridorType::TwoWay,	90.f },		// E W
+	{ ECorridorType::ThreeWay,	270.f },	// N E W
+	{ ECorridorType::Corner,	180.f },	// S W
+	{ ECorridorType::ThreeWay,	180.f },	// N S W
+	{ ECorridorType::ThreeWay,	90.f },		// E S W
+	{ ECorridorType::FourWay,	0.f },		// N E S W
+};
+
+// Returns the connection mask of the horizontal directions the corridor connects to.
+static uint8 GetCorridorConnectionMask(const FCorridorTileData& CorridorTileData)
+{
+	// North, East, South and West are direction values 1 to 4, so their mask bits only need shifting down
+	static_assert((uint8)EDirections::North == 1 && (uint8)EDirections::East == 2 && (uint8)EDirections::South == 3 && (uint8)EDirections::West == 4, "Corridor connection bits expect the horizontal directions to be 1 to 4.");
+
+	return (CorridorTileData.AdjacentMask.Bits >> 1) & (CorridorConnectionNorth | CorridorConnectionEast | CorridorConnectionSouth | CorridorConnectionWest);
+}
+
 // Set of coordinates to check the buffer around a room.
 static 	TSet<FIntVector> CoordinateChecklist
 {
@@ -56,36 +105,281 @@ static 	TSet<FIntVector> CoordinateChecklist
 	{ 1, -1, -1 },
 };
 
+// Randomly picks a row from the data table, weighted by the row's RandomSelectionChance. The rows are only looked up the first time the data table is used in the level generation.
+template<typename RowType>
+static RowType* GetRandomRowFromDataTable(UDataTable* DataTable, const FRandomStream& LevelStream, FRandomSelectionCache& SelectionCache)
+{
+	if (!DataTable) { return nullptr; }
+
+	FDataTableSelection* DataTableSelection = SelectionCache.DataTables.Find(DataTable);
+
+	if (!DataTableSelection)
+	{
+		DataTableSelection = &SelectionCache.DataTables.Add(DataTable);
+
+		TArray<double> ProbabilityArray;
+
+		for (FName CurrentRowName : DataTable->GetRowNames())
+		{
+			if (RowType* Row = DataTable->FindRow<RowType>(CurrentRowName, ""))
+			{
+				DataTableSelection->Rows.Add(reinterpret_cast<uint8*>(Row));
+				ProbabilityArray.Add(Row->RandomSelectionChance);
+			}
+		}
+
+		DataTableSelection->Selector.Initialize(ProbabilityArray);
+	}
+
+	const int32 RowIndex = DataTableSelection->Selector.Pick(LevelStream, SelectionCache.SelectionMethod);
+
+	return RowIndex != INDEX_NONE ? reinterpret_cast<RowType*>(DataTableSelection->Rows[RowIndex]) : nullptr;
+}
+
 void ULevelGenerationLibrary::GenerateLevel(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UObject* WorldRef)
 {
+	PrepareLevelGeneration(LevelGenerationSettings, GeneratedLevelData);
+
+	RunLevelGeneration(LevelGenerationSettings, GeneratedLevelData);
+}
+
+void ULevelGenerationLibrary::PrepareLevelGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
+{
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_Prepare);
+
 	// Set the level seed
 	if (LevelGenerationSettings.bUsePlayerSeed) { GeneratedLevelData.LevelStream = LevelGenerationSettings.LevelUserSeed; }
 	else { GeneratedLevelData.LevelStream.GenerateNewSeed(); }
 
 	LevelGenerationSettings.SpecialPathData.LoadSynchronous();
 
+	// Every stage reads the compiled settings instead of looking up the settings maps
+	GeneratedLevelData.CompiledSettings.Compile(LevelGenerationSettings);
+
+	GeneratedLevelData.DebugData.Reset();
+	GeneratedLevelData.Stats.Reset();
+	GeneratedLevelData.CompiledRoomFootprints.Reset();
+	GeneratedLevelData.TileTemplates = MakeShared<FTileTemplateRegistry>();
+	GeneratedLevelData.BuildTileGrid(LevelGenerationSettings.GridSize, LevelGenerationSettings.TileStorageType);
+	GeneratedLevelData.RandomSelectionCache.Reset(LevelGenerationSettings.RandomSelectionMethod);
+
 	UE_LOG(LogTemp, Warning, TEXT("ULevelGenerationLibrary::GenerateLevel Level Seed = %s"), *FString::FromInt(GeneratedLevelData.LevelStream.GetCurrentSeed()));
 
-	if (LevelGenerationSettings.bGenerateKeyRooms)
+	FLevelGenerationTrace::OutputGenerationStart(GeneratedLevelData.LevelStream.GetInitialSeed(), LevelGenerationSettings.GridSize);
+}
+
+bool ULevelGenerationLibrary::RunLevelGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
+{
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_Run);
+
+	GeneratedLevelData.SetGenerationStage(ELevelGenerationStage::Rooms, 0.f);
+
+	const double RoomsStartTime = FPlatformTime::Seconds();
+
+	if (LevelGenerationSettings.bGenerateKeyRooms && !GeneratedLevelData.IsGenerationCancelled())
 	{
 		GenerateKeyRooms(LevelGenerationSettings, GeneratedLevelData);
 		UE_LOG(LogTemp, Warning, TEXT("ULevelGenerationLibrary::GenerateLevel Key Rooms Generated!"));
 	}
 
-	if (LevelGenerationSettings.bGenerateSpecialRooms)
+	if (LevelGenerationSettings.bGenerateSpecialRooms && !GeneratedLevelData.IsGenerationCancelled())
 	{
 		GenerateSpecialRooms(LevelGenerationSettings, GeneratedLevelData);
 		UE_LOG(LogTemp, Warning, TEXT("ULevelGenerationLibrary::GenerateLevel Special Rooms Generated!"));
 	}
 
-	if (LevelGenerationSettings.bGenerateBasicRooms)
+	if (LevelGenerationSettings.bGenerateBasicRooms && !GeneratedLevelData.IsGenerationCancelled())
 	{
 		GenerateBasicRooms(LevelGenerationSettings, GeneratedLevelData);
 		UE_LOG(LogTemp, Warning, TEXT("ULevelGenerationLibrary::GenerateLevel Basic Rooms Generated!"));
 	}
 
-	GenerateCorridors3D(LevelGenerationSettings, GeneratedLevelData, WorldRef);
+	GeneratedLevelData.Stats.RoomsTime = FPlatformTime::Seconds() - RoomsStartTime;
+
+	if (GeneratedLevelData.IsGenerationCancelled())
+	{
+		GeneratedLevelData.SetGenerationStage(ELevelGenerationStage::Cancelled, GeneratedLevelData.Progress->GetProgress());
+		return false;
+	}
+
+	for (const TPair<ETileType, FRoomPlacementStats>& CurrentStats : GeneratedLevelData.Stats.RoomPlacements)
+	{
+		UE_LOG(LogTemp, Log, TEXT("ULevelGenerationLibrary::GenerateLevel %s placement: %d of %d placed (%.1f%%), %d placements tested"), *UEnum::GetDisplayValueAsText(CurrentStats.Key).ToString(), CurrentStats.Value.RoomsPlaced, CurrentStats.Value.RoomsRequested, CurrentStats.Value.GetSuccessRate() * 100.f, CurrentStats.Value.PlacementsTested);
+	}
+
+	GeneratedLevelData.NotifyRoomsGenerated();
+
+	GenerateCorridors3D(LevelGenerationSettings, GeneratedLevelData);
+
+	if (GeneratedLevelData.IsGenerationCancelled())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ULevelGenerationLibrary::GenerateLevel Level generation cancelled!"));
+		GeneratedLevelData.SetGenerationStage(ELevelGenerationStage::Cancelled, GeneratedLevelData.Progress->GetProgress());
+		return false;
+	}
+
 	UE_LOG(LogTemp, Warning, TEXT("ULevelGenerationLibrary::GenerateLevel Corridors Generated!"));
+
+	UE_LOG(LogTemp, Log, TEXT("ULevelGenerationLibrary::GenerateLevel %d tiles share %d tile templates"), GeneratedLevelData.LevelTileData.Num(), GeneratedLevelData.TileTemplates->Num());
+
+	GeneratedLevelData.SetGenerationStage(ELevelGenerationStage::Finished, 1.f);
+	return true;
+}
+
+bool ULevelGenerationLibrary::RunLevelGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UObject* WorldRef)
+{
+	const bool bCompleted = RunLevelGeneration(LevelGenerationSettings, GeneratedLevelData);
+
+	if (bCompleted && LevelGenerationSettings.bDrawMST)
+	{
+		const FLevelGenerationDebugDrawOptions DrawOptions;
+		ULevelGenerationDebugLibrary::DrawEdgeLines(WorldRef, GeneratedLevelData.MinimumSpanningTree, LevelGenerationSettings.TileSize, DrawOptions, DrawOptions.MinimumSpanningTreeColour);
+	}
+
+	return bCompleted;
+}
+
+TSharedRef<FLevelGenerationTask> ULevelGenerationLibrary::GenerateLevelAsync(const FLevelGenerationSettings& LevelGenerationSettings, FOnLevelGenerationTaskComplete OnComplete)
+{
+	TSharedRef<FLevelGenerationTask> LevelGenerationTask = MakeShared<FLevelGenerationTask>(LevelGenerationSettings);
+	LevelGenerationTask->Start(MoveTemp(OnComplete));
+
+	return LevelGenerationTask;
+}
+
+// Adds the time spent in a step of the level generation to the stage the step belongs to.
+static void RecordStepTime(FLevelGenerationStats& Stats, ELevelGenerationStep Step, double StepTime)
+{
+	switch (Step)
+	{
+	case ELevelGenerationStep::KeyRooms:
+	case ELevelGenerationStep::SpecialRooms:
+	case ELevelGenerationStep::BasicRooms:
+		Stats.RoomsTime += StepTime;
+		break;
+
+	case ELevelGenerationStep::RoomTetrahedralization:
+	case ELevelGenerationStep::RoomMinimumSpanningTree:
+		Stats.RoomGraphTime += StepTime;
+		break;
+
+	case ELevelGenerationStep::CorridorSetup:
+	case ELevelGenerationStep::Corridors:
+	case ELevelGenerationStep::CorridorTiles:
+		Stats.CorridorsTime += StepTime;
+		break;
+
+	default:
+		break;
+	}
+}
+
+bool ULevelGenerationLibrary::StepLevelGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, FLevelGenerationStepState& StepState, int32 MaxPathExpansions)
+{
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_Step);
+
+	const ELevelGenerationStep CurrentStep = StepState.Step;
+	const double StepStartTime = FPlatformTime::Seconds();
+
+	switch (StepState.Step)
+	{
+	case ELevelGenerationStep::Prepare:
+		PrepareLevelGeneration(LevelGenerationSettings, GeneratedLevelData);
+		GeneratedLevelData.SetGenerationStage(ELevelGenerationStage::Rooms, 0.f);
+		StepState.Step = ELevelGenerationStep::KeyRooms;
+		break;
+
+	case ELevelGenerationStep::KeyRooms:
+		// One room is placed each step
+		if (!LevelGenerationSettings.bGenerateKeyRooms || StepKeyRooms(LevelGenerationSettings, GeneratedLevelData, StepState.Rooms))
+		{
+			if (LevelGenerationSettings.bGenerateKeyRooms) { UE_LOG(LogTemp, Warning, TEXT("ULevelGenerationLibrary::StepLevelGeneration Key Rooms Generated!")); }
+			StepState.Rooms = FRoomGenerationState();
+			StepState.Step = ELevelGenerationStep::SpecialRooms;
+		}
+		break;
+
+	case ELevelGenerationStep::SpecialRooms:
+		if (!LevelGenerationSettings.bGenerateSpecialRooms || StepSpecialRooms(LevelGenerationSettings, GeneratedLevelData, StepState.Rooms))
+		{
+			if (LevelGenerationSettings.bGenerateSpecialRooms) { UE_LOG(LogTemp, Warning, TEXT("ULevelGenerationLibrary::StepLevelGeneration Special Rooms Generated!")); }
+			StepState.Rooms = FRoomGenerationState();
+			StepState.Step = ELevelGenerationStep::BasicRooms;
+		}
+		break;
+
+	case ELevelGenerationStep::BasicRooms:
+		if (!LevelGenerationSettings.bGenerateBasicRooms || StepBasicRooms(LevelGenerationSettings, GeneratedLevelData, StepState.Rooms))
+		{
+			if (LevelGenerationSettings.bGenerateBasicRooms) { UE_LOG(LogTemp, Warning, TEXT("ULevelGenerationLibrary::StepLevelGeneration Basic Rooms Generated!")); }
+			StepState.Rooms = FRoomGenerationState();
+			StepState.Step = ELevelGenerationStep::RoomTetrahedralization;
+		}
+		break;
+
+	case ELevelGenerationStep::RoomTetrahedralization:
+		GeneratedLevelData.NotifyRoomsGenerated();
+		GeneratedLevelData.SetGenerationStage(ELevelGenerationStage::RoomGraph, 0.2f);
+		BuildRoomTetrahedralization(LevelGenerationSettings, GeneratedLevelData, StepState.RoomCoordinates, StepState.RoomGraphEdges);
+		StepState.Step = ELevelGenerationStep::RoomMinimumSpanningTree;
+		break;
+
+	case ELevelGenerationStep::RoomMinimumSpanningTree:
+		BuildRoomMinimumSpanningTree(LevelGenerationSettings, GeneratedLevelData, StepState.RoomCoordinates, StepState.RoomGraphEdges);
+		StepState.RoomCoordinates.Empty();
+		StepState.RoomGraphEdges.Empty();
+		StepState.Step = ELevelGenerationStep::CorridorSetup;
+		break;
+
+	case ELevelGenerationStep::CorridorSetup:
+		StepState.Step = BeginCorridorGeneration(LevelGenerationSettings, GeneratedLevelData, StepState.Corridors) ? ELevelGenerationStep::Corridors : ELevelGenerationStep::CorridorTiles;
+		break;
+
+	case ELevelGenerationStep::Corridors:
+	{
+		int32 ExpansionBudget = FMath::Max(MaxPathExpansions, 1);
+		if (StepCorridorGeneration(LevelGenerationSettings, GeneratedLevelData, StepState.Corridors, ExpansionBudget))
+		{
+			StepState.Corridors = FCorridorGenerationState();
+			StepState.Step = ELevelGenerationStep::CorridorTiles;
+		}
+		break;
+	}
+
+	case ELevelGenerationStep::CorridorTiles:
+		FinishCorridorGeneration(LevelGenerationSettings, GeneratedLevelData);
+		UE_LOG(LogTemp, Warning, TEXT("ULevelGenerationLibrary::StepLevelGeneration Corridors Generated!"));
+		UE_LOG(LogTemp, Log, TEXT("ULevelGenerationLibrary::StepLevelGeneration %d tiles share %d tile templates"), GeneratedLevelData.LevelTileData.Num(), GeneratedLevelData.TileTemplates->Num());
+
+		GeneratedLevelData.SetGenerationStage(ELevelGenerationStage::Finished, 1.f);
+		StepState.Step = ELevelGenerationStep::Done;
+		break;
+
+	default:
+		break;
+	}
+
+	RecordStepTime(GeneratedLevelData.Stats, CurrentStep, FPlatformTime::Seconds() - StepStartTime);
+
+	return StepState.IsDone();
+}
+
+bool ULevelGenerationLibrary::TickLevelGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, FLevelGenerationStepState& StepState, float TimeBudgetMs, int32 MaxPathExpansions)
+{
+	const double EndTime = FPlatformTime::Seconds() + TimeBudgetMs * 0.001;
+
+	do
+	{
+		if (GeneratedLevelData.IsGenerationCancelled())
+		{
+			GeneratedLevelData.SetGenerationStage(ELevelGenerationStage::Cancelled, GeneratedLevelData.Progress->GetProgress());
+			return false;
+		}
+
+		if (StepLevelGeneration(LevelGenerationSettings, GeneratedLevelData, StepState, MaxPathExpansions)) { return true; }
+	} while (FPlatformTime::Seconds() < EndTime);
+
+	return false;
 }
 
 FIntVector ULevelGenerationLibrary::RotateIntVectorCoordinatefromOrigin(FIntVector InCoordinate, FRotator TileRotation)
@@ -191,100 +485,291 @@ EDirections ULevelGenerationLibrary::RotateDirection(EDirections InDirection, FR
 }
 
 void ULevelGenerationLibrary::GenerateKeyRooms(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
+{
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_KeyRooms);
+
+	// A cancelled generation stops between rooms
+	FRoomGenerationState RoomState;
+	while (!GeneratedLevelData.IsGenerationCancelled() && !StepKeyRooms(LevelGenerationSettings, GeneratedLevelData, RoomState)) {}
+}
+
+void ULevelGenerationLibrary::GenerateSpecialRooms(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
+{
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_SpecialRooms);
+
+	// A cancelled generation stops between rooms
+	FRoomGenerationState RoomState;
+	while (!GeneratedLevelData.IsGenerationCancelled() && !StepSpecialRooms(LevelGenerationSettings, GeneratedLevelData, RoomState)) {}
+}
+
+void ULevelGenerationLibrary::GenerateBasicRooms(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
+{
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_BasicRooms);
+
+	// A cancelled generation stops between rooms
+	FRoomGenerationState RoomState;
+	while (!GeneratedLevelData.IsGenerationCancelled() && !StepBasicRooms(LevelGenerationSettings, GeneratedLevelData, RoomState)) {}
+}
+
+bool ULevelGenerationLibrary::StepKeyRooms(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, FRoomGenerationState& RoomState)
 {
 	TArray<FKeyTileData> KeyTileDataArray;
 	LevelGenerationSettings.KeyRooms.GenerateValueArray(KeyTileDataArray);
 
-	for (FKeyTileData KeyTileData : KeyTileDataArray)
+	while (RoomState.EntryIndex < KeyTileDataArray.Num())
 	{
-		int RoomsToCreate = FMath::Clamp(KeyTileData.Quantity, 0, ((LevelGenerationSettings.GridSize.X * LevelGenerationSettings.GridSize.Y * LevelGenerationSettings.GridSize.Z) - GeneratedLevelData.LevelTileData.Num()));
+		const FKeyTileData& KeyTileData = KeyTileDataArray[RoomState.EntryIndex];
 
-		if (RoomsToCreate > 0)
+		if (RoomState.RoomsToPlace == INDEX_NONE)
 		{
-			for (int i = 0; i < RoomsToCreate; i++)
-			{
-				PlaceRoomInGrid(LevelGenerationSettings, GeneratedLevelData, KeyTileData.KeyRoomList);
-			}
+			RoomState.RoomsToPlace = FMath::Clamp(KeyTileData.Quantity, 0, ((LevelGenerationSettings.GridSize.X * LevelGenerationSettings.GridSize.Y * LevelGenerationSettings.GridSize.Z) - GeneratedLevelData.GetTileCount()));
+		}
+
+		if (RoomState.RoomIndex < RoomState.RoomsToPlace)
+		{
+			LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_PlaceKeyRoom);
+			PlaceRoomInGrid(LevelGenerationSettings, GeneratedLevelData, KeyTileData.KeyRoomList, ETileType::Room_Key);
+			RoomState.RoomIndex++;
+			return false;
 		}
+
+		// Move on to the next kind of key room
+		RoomState.EntryIndex++;
+		RoomState.RoomIndex = 0;
+		RoomState.RoomsToPlace = INDEX_NONE;
 	}
+
+	return true;
 }
 
-void ULevelGenerationLibrary::GenerateSpecialRooms(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
+bool ULevelGenerationLibrary::StepSpecialRooms(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, FRoomGenerationState& RoomState)
 {
 	TArray<FSpecialTileData> SpecialTileDataArray;
 	LevelGenerationSettings.SpecialRooms.GenerateValueArray(SpecialTileDataArray);
 
-	for (FSpecialTileData SpecialTileData : SpecialTileDataArray)
+	while (RoomState.EntryIndex < SpecialTileDataArray.Num())
 	{
-		const bool bIsThereSpaceToSpawnRoom = (LevelGenerationSettings.GridSize.X * LevelGenerationSettings.GridSize.Y * LevelGenerationSettings.GridSize.Z) - GeneratedLevelData.LevelTileData.Num() > 0.f;
+		const FSpecialTileData& SpecialTileData = SpecialTileDataArray[RoomState.EntryIndex];
+		RoomState.EntryIndex++;
+
+		const bool bIsThereSpaceToSpawnRoom = (LevelGenerationSettings.GridSize.X * LevelGenerationSettings.GridSize.Y * LevelGenerationSettings.GridSize.Z) - GeneratedLevelData.GetTileCount() > 0.f;
 
 		if (bIsThereSpaceToSpawnRoom && UKismetMathLibrary::RandomFloatInRangeFromStream(0.f, 1.f, GeneratedLevelData.LevelStream) <= SpecialTileData.ChanceToGenerate)
 		{
-			PlaceRoomInGrid(LevelGenerationSettings, GeneratedLevelData, SpecialTileData.SpecialRoomList);
+			LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_PlaceSpecialRoom);
+			PlaceRoomInGrid(LevelGenerationSettings, GeneratedLevelData, SpecialTileData.SpecialRoomList, ETileType::Room_Special);
+			return false;
 		}
 	}
+
+	return true;
 }
 
-void ULevelGenerationLibrary::GenerateBasicRooms(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
+bool ULevelGenerationLibrary::StepBasicRooms(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, FRoomGenerationState& RoomState)
 {
-	const int RoomMaximum = (LevelGenerationSettings.GridSize.X * LevelGenerationSettings.GridSize.Y * LevelGenerationSettings.GridSize.Z) - GeneratedLevelData.LevelTileData.Num();
+	if (RoomState.RoomsToPlace == INDEX_NONE)
+	{
+		const int RoomMaximum = (LevelGenerationSettings.GridSize.X * LevelGenerationSettings.GridSize.Y * LevelGenerationSettings.GridSize.Z) - GeneratedLevelData.GetTileCount();
 
-	const int BasicRoomQuantity = UKismetMathLibrary::RandomFloatInRangeFromStream(FMath::Clamp(LevelGenerationSettings.BasicRoomsMinimum, 0, RoomMaximum), FMath::Clamp(LevelGenerationSettings.BasicRoomsMaximum, 0, RoomMaximum), GeneratedLevelData.LevelStream);
-	
+		RoomState.RoomsToPlace = UKismetMathLibrary::RandomFloatInRangeFromStream(FMath::Clamp(LevelGenerationSettings.BasicRoomsMinimum, 0, RoomMaximum), FMath::Clamp(LevelGenerationSettings.BasicRoomsMaximum, 0, RoomMaximum), GeneratedLevelData.LevelStream);
+	}
+
+	if (RoomState.RoomIndex >= RoomState.RoomsToPlace) { return true; }
+
+	// A room list is drawn again next step if none was picked
+	if (UDataTable* RoomDataTable = GetRandomRoomListFromDataTable(LevelGenerationSettings.BasicRoomList, GeneratedLevelData.LevelStream, GeneratedLevelData.RandomSelectionCache))
+	{
+		LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_PlaceBasicRoom);
+		PlaceRoomInGrid(LevelGenerationSettings, GeneratedLevelData, RoomDataTable, ETileType::Room_Basic);
+		RoomState.RoomIndex++;
+	}
+
+	return RoomState.RoomIndex >= RoomState.RoomsToPlace;
+}
+
+void ULevelGenerationLibrary::UpdateRoomGraph(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, const TArray<FIntVector>& AddedRoomCoordinates, const TArray<FIntVector>& RemovedRoomCoordinates)
+{
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_UpdateRoomGraph);
+
+	FTetrahedralizationData& RoomTetrahedralization = GeneratedLevelData.RoomTetrahedralization;
+
+	// Build the whole graph if it has not been built yet
+	if (!RoomTetrahedralization.IsValid())
+	{
+		BuildRoomGraph(LevelGenerationSettings, GeneratedLevelData);
+		return;
+	}
+
+	// Remember which edges were added as extra corridors so they can be kept
+	TSet<FEdgeInfo> ExtraEdges(GeneratedLevelData.MinimumSpanningTree);
+	for (const FEdgeInfo& CurrentEdge : GeneratedLevelData.RoomMinimumSpanningTree)
+	{
+		ExtraEdges.Remove(CurrentEdge);
+	}
+
+	for (const FIntVector& RoomCoordinate : RemovedRoomCoordinates)
+	{
+		TArray<FEdgeInfo> NeighbourEdges;
+		if (UDelaunayTriangulationLibrary::RemovePointFromTetrahedralization(RoomTetrahedralization, RoomCoordinate, NeighbourEdges))
+		{
+			UKruskalMSTLibrary::RemovePointFromMinimumSpanningTree(GeneratedLevelData.RoomMinimumSpanningTree, RoomCoordinate, NeighbourEdges);
+		}
+	}
+
+	TArray<FEdgeInfo> DiscardedEdgesArray;
+	for (const FIntVector& RoomCoordinate : AddedRoomCoordinates)
+	{
+		TArray<FEdgeInfo> NewEdges;
+		if (UDelaunayTriangulationLibrary::InsertPointIntoTetrahedralization(RoomTetrahedralization, RoomCoordinate, NewEdges))
+		{
+			UKruskalMSTLibrary::AddPointToMinimumSpanningTree(GeneratedLevelData.RoomMinimumSpanningTree, NewEdges, DiscardedEdgesArray);
+		}
+	}
+
+	const TSet<FEdgeInfo> RoomMinimumSpanningTreeSet(GeneratedLevelData.RoomMinimumSpanningTree);
+
+	GeneratedLevelData.MinimumSpanningTree = GeneratedLevelData.RoomMinimumSpanningTree;
 
-	if (BasicRoomQuantity == 0) { return; }
+	// Keep the extra corridors that are still part of the graph
+	for (const FEdgeInfo& CurrentEdge : ExtraEdges)
+	{
+		if (RoomTetrahedralization.EdgeReferenceCount.Contains(CurrentEdge) && !RoomMinimumSpanningTreeSet.Contains(CurrentEdge))
+		{
+			GeneratedLevelData.MinimumSpanningTree.Add(CurrentEdge);
+		}
+	}
 
-	int RoomsGenerated = 0;
-	while (RoomsGenerated < BasicRoomQuantity)
+	// Only the newly discarded edges get a chance to become extra corridors
+	TSet<FEdgeInfo> NewExtraEdgeCandidates;
+	for (const FEdgeInfo& CurrentEdge : DiscardedEdgesArray)
 	{
-		if (UDataTable* RoomDataTable = GetRandomRoomListFromDataTable(LevelGenerationSettings.BasicRoomList, GeneratedLevelData.LevelStream))
+		if (RoomTetrahedralization.EdgeReferenceCount.Contains(CurrentEdge) && !RoomMinimumSpanningTreeSet.Contains(CurrentEdge) && !ExtraEdges.Contains(CurrentEdge))
 		{
-			PlaceRoomInGrid(LevelGenerationSettings, GeneratedLevelData, RoomDataTable);
-			RoomsGenerated++;
+			NewExtraEdgeCandidates.Add(CurrentEdge);
 		}
 	}
+
+	UKruskalMSTLibrary::RandomlyAddEdgesToMST(GeneratedLevelData.MinimumSpanningTree, NewExtraEdgeCandidates.Array(), GeneratedLevelData.LevelStream, LevelGenerationSettings.ExtraCorridorChance);
+
+	if (LevelGenerationSettings.bRecordDebugData) { RecordDiscardedEdges(UDelaunayTriangulationLibrary::GetTetrahedralizationEdges(RoomTetrahedralization), GeneratedLevelData); }
 }
 
-void ULevelGenerationLibrary::GenerateCorridors3D(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UObject* WorldRef)
+void ULevelGenerationLibrary::BuildRoomGraph(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
 {
-	// Store room coordinate data 
-	TArray<FIntVector> LevelTileDataKeys;
-	GeneratedLevelData.LevelTileData.GetKeys(LevelTileDataKeys);
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_RoomGraph);
+
+	TArray<FIntVector> RoomCoordinates;
+	TArray<FEdgeInfo> DelaunayArray;
+
+	BuildRoomTetrahedralization(LevelGenerationSettings, GeneratedLevelData, RoomCoordinates, DelaunayArray);
+	BuildRoomMinimumSpanningTree(LevelGenerationSettings, GeneratedLevelData, RoomCoordinates, DelaunayArray);
+}
+
+void ULevelGenerationLibrary::BuildRoomTetrahedralization(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, TArray<FIntVector>& OutRoomCoordinates, TArray<FEdgeInfo>& OutGraphEdges)
+{
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_Triangulation);
 
-	TArray<FIntVector>RoomCoordinates;
+	// Store room coordinate data 
+	OutRoomCoordinates.Reset();
 
-	for (FIntVector CurrentVector : LevelTileDataKeys)
+	for (const TPair<FIntVector, FTileInstanceData>& CurrentTile : GeneratedLevelData.LevelTileData)
 	{
-		switch (GeneratedLevelData.LevelTileData[CurrentVector].TileType)
+		const FIntVector CurrentVector = CurrentTile.Key;
+
+		const FTileTemplate* CurrentTemplate = GeneratedLevelData.GetTileTemplate(CurrentTile.Value);
+		if (!CurrentTemplate) { continue; }
+
+		switch (CurrentTemplate->TileType)
 		{
 		case ETileType::Room_Basic:
-			RoomCoordinates.Add(CurrentVector);
+			OutRoomCoordinates.Add(CurrentVector);
 			break;
 		case ETileType::Room_Key:
-			RoomCoordinates.Add(CurrentVector);
+			OutRoomCoordinates.Add(CurrentVector);
 			break;
 		case ETileType::Room_Special:
-			RoomCoordinates.Add(CurrentVector);
+			OutRoomCoordinates.Add(CurrentVector);
 			break;
 		default:
 			break;
 		}
 	}
 
-	// Get all possible connections between rooms
-	TArray<FEdgeInfo> DelaunayArray = UDelaunayTriangulationLibrary::DelaunayTetrahedralization(LevelGenerationSettings.GridSize, RoomCoordinates, true);
+	// Get all possible connections between rooms, keeping the tetrahedralization so it can be updated later
+	UDelaunayTriangulationLibrary::BuildTetrahedralization(LevelGenerationSettings.GridSize, OutRoomCoordinates, GeneratedLevelData.RoomTetrahedralization);
+	OutGraphEdges = UDelaunayTriangulationLibrary::GetTetrahedralizationEdges(GeneratedLevelData.RoomTetrahedralization);
+}
+
+void ULevelGenerationLibrary::BuildRoomMinimumSpanningTree(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, const TArray<FIntVector>& RoomCoordinates, const TArray<FEdgeInfo>& GraphEdges)
+{
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_MinimumSpanningTree);
 
 	// Find the minimum spanning tree for all the rooms in the level (minimum paths needed for all rooms to be reachable in gameplay)
 	TArray<FEdgeInfo> DiscardedEdgesArray;
-	GeneratedLevelData.MinimumSpanningTree = UKruskalMSTLibrary::GetMinimumSpanningTreeV2(RoomCoordinates, DelaunayArray, DiscardedEdgesArray);
+	GeneratedLevelData.RoomMinimumSpanningTree = UKruskalMSTLibrary::GetMinimumSpanningTreeV2(RoomCoordinates, GraphEdges, DiscardedEdgesArray, LevelGenerationSettings.MinimumSpanningTreeAlgorithm);
+	GeneratedLevelData.MinimumSpanningTree = GeneratedLevelData.RoomMinimumSpanningTree;
 
 	// Randomly add some extra paths
 	UKruskalMSTLibrary::RandomlyAddEdgesToMST(GeneratedLevelData.MinimumSpanningTree, DiscardedEdgesArray, GeneratedLevelData.LevelStream, LevelGenerationSettings.ExtraCorridorChance);
 
-	// Display the MST + extra paths in the game session
-	if (LevelGenerationSettings.bDrawMST) { UKruskalMSTLibrary::DrawMST(GeneratedLevelData.MinimumSpanningTree, WorldRef, LevelGenerationSettings.TileSize, FLinearColor::Green); }
+	if (LevelGenerationSettings.bRecordDebugData) { RecordDiscardedEdges(GraphEdges, GeneratedLevelData); }
+}
+
+void ULevelGenerationLibrary::RecordDiscardedEdges(const TArray<FEdgeInfo>& GraphEdges, FGeneratedLevelData& GeneratedLevelData)
+{
+	const TSet<FEdgeInfo> CorridorEdges(GeneratedLevelData.MinimumSpanningTree);
+
+	GeneratedLevelData.DebugData.DiscardedEdges.Reset();
+
+	for (const FEdgeInfo& CurrentEdge : GraphEdges)
+	{
+		if (!CorridorEdges.Contains(CurrentEdge)) { GeneratedLevelData.DebugData.DiscardedEdges.Add(CurrentEdge); }
+	}
+}
+
+void ULevelGenerationLibrary::GenerateCorridors3D(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
+{
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_Corridors);
+
+	GeneratedLevelData.SetGenerationStage(ELevelGenerationStage::RoomGraph, 0.2f);
+
+	const double RoomGraphStartTime = FPlatformTime::Seconds();
+
+	BuildRoomGraph(LevelGenerationSettings, GeneratedLevelData);
+
+	const double CorridorsStartTime = FPlatformTime::Seconds();
+	GeneratedLevelData.Stats.RoomGraphTime = CorridorsStartTime - RoomGraphStartTime;
+
+	FCorridorGenerationState CorridorState;
+	if (!BeginCorridorGeneration(LevelGenerationSettings, GeneratedLevelData, CorridorState)) { return; }
+
+	// Without a budget the corridors are only left unfinished if the generation is cancelled
+	int32 ExpansionBudget = MAX_int32;
+	const bool bCorridorsFinished = StepCorridorGeneration(LevelGenerationSettings, GeneratedLevelData, CorridorState, ExpansionBudget);
+
+	if (bCorridorsFinished) { FinishCorridorGeneration(LevelGenerationSettings, GeneratedLevelData); }
+
+	GeneratedLevelData.Stats.CorridorsTime = FPlatformTime::Seconds() - CorridorsStartTime;
+}
+
+void ULevelGenerationLibrary::GenerateCorridors3D(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UObject* WorldRef)
+{
+	GenerateCorridors3D(LevelGenerationSettings, GeneratedLevelData);
+
+	if (LevelGenerationSettings.bDrawMST && !GeneratedLevelData.IsGenerationCancelled())
+	{
+		const FLevelGenerationDebugDrawOptions DrawOptions;
+		ULevelGenerationDebugLibrary::DrawEdgeLines(WorldRef, GeneratedLevelData.MinimumSpanningTree, LevelGenerationSettings.TileSize, DrawOptions, DrawOptions.MinimumSpanningTreeColour);
+	}
+}
+
+bool ULevelGenerationLibrary::BeginCorridorGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, FCorridorGenerationState& CorridorState)
+{
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_CorridorSetup);
+
+	if (!LevelGenerationSettings.bGenerateCorridors || GeneratedLevelData.IsGenerationCancelled()) { return false; }
 
-	if (!LevelGenerationSettings.bGenerateCorridors) { return; }
+	GeneratedLevelData.SetGenerationStage(ELevelGenerationStage::Corridors, 0.3f);
 
 	// Sort the MST + extra paths from shortest to longest path
 	GeneratedLevelData.MinimumSpanningTree.Sort([](const FEdgeInfo& EdgeA, const FEdgeInfo& EdgeB) -> bool {
@@ -295,47 +780,44 @@ void ULevelGenerationLibrary::GenerateCorridors3D(FLevelGenerationSettings& Leve
 		});
 
 	// Array containing all the paths that need to be built
-	TArray<FPathGenerationData> PathGenerationDataArray;
+	CorridorState = FCorridorGenerationState();
+	TArray<FPathGenerationData>& PathGenerationDataArray = CorridorState.PathGenerationDataArray;
 
 	// Get the data needed for all paths to be built
 	for (FEdgeInfo CurrentPath : GeneratedLevelData.MinimumSpanningTree)
 	{
 		FPathGenerationData PathGenerationData;
 		PathGenerationData.PathData = CurrentPath;
-		PathGenerationData.OriginTile = GeneratedLevelData.LevelTileData.Find(CurrentPath.Origin);
-		PathGenerationData.DestinationTile = GeneratedLevelData.LevelTileData.Find(CurrentPath.Destination);
+		PathGenerationData.OriginTile = GeneratedLevelData.FindTile(CurrentPath.Origin);
+		PathGenerationData.OriginTemplate = PathGenerationData.OriginTile ? GeneratedLevelData.GetTileTemplate(*PathGenerationData.OriginTile) : nullptr;
+		PathGenerationData.DestinationTile = GeneratedLevelData.FindTile(CurrentPath.Destination);
+		PathGenerationData.DestinationTemplate = PathGenerationData.DestinationTile ? GeneratedLevelData.GetTileTemplate(*PathGenerationData.DestinationTile) : nullptr;
 
-		if (PathGenerationData.OriginTile && PathGenerationData.DestinationTile)
+		if (PathGenerationData.OriginTemplate && PathGenerationData.DestinationTemplate)
 		{
-			// Find the best access point to use for the starting location and end location
-			TArray<FIntVector> OriginTileAccessPoints;
-			PathGenerationData.OriginTile->TileAccessPoints.GetKeys(OriginTileAccessPoints);
-
-			TArray<FIntVector> DestinationTileAccessPoints;
-			PathGenerationData.DestinationTile->TileAccessPoints.GetKeys(DestinationTileAccessPoints);
-
+			// Find the best access point to use for the starting location and end location, walking the maps and sets in place so nothing is copied
 			// Check every access point the destination tile has
-			for (FIntVector CurrentDestinationAP : DestinationTileAccessPoints)
+			for (const TPair<FIntVector, FTileAccessData>& DestinationAccessPoint : PathGenerationData.DestinationTemplate->TileAccessPoints)
 			{
-				TArray<EDirections> DestinationDirectionsArray = PathGenerationData.DestinationTile->TileAccessPoints[CurrentDestinationAP].AccessibleDirections.Array();
-				for (EDirections DestinationDirection : DestinationDirectionsArray)
+				const FIntVector CurrentDestinationAP = DestinationAccessPoint.Key;
+				for (const EDirections DestinationDirection : DestinationAccessPoint.Value.AccessibleDirections)
 				{
-					const FIntVector PotentialPathEnd = CurrentPath.Destination + RotateIntVectorCoordinatefromOrigin(CurrentDestinationAP + DirectionCoordinates[DestinationDirection], GeneratedLevelData.LevelTileData[CurrentPath.Destination].TileRotation);
+					const FIntVector PotentialPathEnd = CurrentPath.Destination + RotateIntVectorCoordinatefromOrigin(CurrentDestinationAP + DirectionCoordinates[DestinationDirection], PathGenerationData.DestinationTile->TileRotation);
 
-					if (GeneratedLevelData.LevelTileData.Contains(PotentialPathEnd))
+					if (GeneratedLevelData.ContainsTile(PotentialPathEnd))
 					{
 						continue;
 					}
 
 					// Check every access point the origin tile has		
-					for (FIntVector CurrentOriginAP : OriginTileAccessPoints)
+					for (const TPair<FIntVector, FTileAccessData>& OriginAccessPoint : PathGenerationData.OriginTemplate->TileAccessPoints)
 					{
-						TArray<EDirections> OriginDirectionsArray = PathGenerationData.OriginTile->TileAccessPoints[CurrentOriginAP].AccessibleDirections.Array();
-						for (EDirections OriginDirection : OriginDirectionsArray)
+						const FIntVector CurrentOriginAP = OriginAccessPoint.Key;
+						for (const EDirections OriginDirection : OriginAccessPoint.Value.AccessibleDirections)
 						{
-							const FIntVector PotentialPathStart = CurrentPath.Origin + RotateIntVectorCoordinatefromOrigin(CurrentOriginAP + DirectionCoordinates[OriginDirection], GeneratedLevelData.LevelTileData[CurrentPath.Origin].TileRotation);
+							const FIntVector PotentialPathStart = CurrentPath.Origin + RotateIntVectorCoordinatefromOrigin(CurrentOriginAP + DirectionCoordinates[OriginDirection], PathGenerationData.OriginTile->TileRotation);
 
-							if (GeneratedLevelData.LevelTileData.Contains(PotentialPathEnd))
+							if (GeneratedLevelData.ContainsTile(PotentialPathEnd))
 							{
 								continue;
 							}
@@ -347,11 +829,11 @@ void ULevelGenerationLibrary::GenerateCorridors3D(FLevelGenerationSettings& Leve
 							if (PotentialShortestDistance < PathGenerationData.PathDistance)
 							{
 								PathGenerationData.OriginAccessPoint = CurrentOriginAP;
-								PathGenerationData.OriginAccessPointLocation = CurrentPath.Origin + RotateIntVectorCoordinatefromOrigin(CurrentOriginAP, GeneratedLevelData.LevelTileData[CurrentPath.Origin].TileRotation);
+								PathGenerationData.OriginAccessPointLocation = CurrentPath.Origin + RotateIntVectorCoordinatefromOrigin(CurrentOriginAP, PathGenerationData.OriginTile->TileRotation);
 								PathGenerationData.OriginPathDirection = OriginDirection;
 
 								PathGenerationData.DestinationAccessPoint = CurrentDestinationAP;
-								PathGenerationData.DestinationAccessPointLocation = CurrentPath.Destination + RotateIntVectorCoordinatefromOrigin(CurrentDestinationAP, GeneratedLevelData.LevelTileData[CurrentPath.Destination].TileRotation);
+								PathGenerationData.DestinationAccessPointLocation = CurrentPath.Destination + RotateIntVectorCoordinatefromOrigin(CurrentDestinationAP, PathGenerationData.DestinationTile->TileRotation);
 								PathGenerationData.DestinationPathDirection = DestinationDirection;
 
 								PathGenerationData.PathEnd = PotentialPathEnd;
@@ -373,370 +855,601 @@ void ULevelGenerationLibrary::GenerateCorridors3D(FLevelGenerationSettings& Leve
 		}
 	}
 
+	GeneratedLevelData.Stats.CorridorsRequested = PathGenerationDataArray.Num();
+
+	return true;
+}
+
+bool ULevelGenerationLibrary::StepCorridorGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, FCorridorGenerationState& CorridorState, int32& ExpansionBudget)
+{
+	const TArray<FPathGenerationData>& PathGenerationDataArray = CorridorState.PathGenerationDataArray;
+
 	// Use A* pathfinding to generate optimal paths
-	for (FPathGenerationData CurrentPathGenData : PathGenerationDataArray)
+	while (CorridorState.PathIndex < PathGenerationDataArray.Num())
 	{
-		// If ShortestDistance is 0 then no pathfinding is needed, room is adjacent
-		if (CurrentPathGenData.PathDistance != 0.f)
+		LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_CorridorEdge);
+
+		// Step 1. Set up the next path.
+		if (!CorridorState.bPathStarted)
 		{
-			FPathGenerationData PathGenerationData = CurrentPathGenData;
-			TArray<FIntVector> ExcludedOriginAPs;
-			TArray<FIntVector> ExcludedDestinationAPs;
+			if (GeneratedLevelData.IsGenerationCancelled()) { return false; }
 
-			int MaxOriginStartingLocations = 0;
-			int MaxDestinationEndLocations = 0;
+			GeneratedLevelData.SetGenerationProgress(0.3f + 0.7f * CorridorState.PathIndex / PathGenerationDataArray.Num());
 
-			TArray<FTileAccessData> TileAccessDataArray;
-			PathGenerationData.OriginTile->TileAccessPoints.GenerateValueArray(TileAccessDataArray);
+			const FPathGenerationData& CurrentPathGenData = PathGenerationDataArray[CorridorState.PathIndex];
 
-			for (FTileAccessData CurrentAccessData : TileAccessDataArray)
+			// If ShortestDistance is 0 then no pathfinding is needed, room is adjacent
+			if (CurrentPathGenData.PathDistance == 0.f)
 			{
-				MaxOriginStartingLocations += CurrentAccessData.AccessibleDirections.Num();
+				CommitAdjacentCorridor(CurrentPathGenData, GeneratedLevelData);
+				GeneratedLevelData.Stats.CorridorsBuilt++;
+				GeneratedLevelData.NotifyCorridorCommitted({ CurrentPathGenData.PathStart });
+				FLevelGenerationTrace::OutputCorridorEdge(GeneratedLevelData.LevelStream.GetInitialSeed(), CorridorState.PathIndex, CurrentPathGenData.PathData.Origin, CurrentPathGenData.PathData.Destination, 0, 1, true);
+				CorridorState.PathIndex++;
+				continue;
 			}
 
-			PathGenerationData.DestinationTile->TileAccessPoints.GenerateValueArray(TileAccessDataArray);
+			CorridorState.PathGenerationData = CurrentPathGenData;
+			CorridorState.ExcludedOriginAPs.Reset();
+			CorridorState.ExcludedDestinationAPs.Reset();
+			CorridorState.MaxOriginStartingLocations = 0;
+			CorridorState.MaxDestinationEndLocations = 0;
+			CorridorState.PathExpansions = 0;
 
-			for (FTileAccessData CurrentAccessData : TileAccessDataArray)
+			for (const TPair<FIntVector, FTileAccessData>& CurrentAccessPoint : CorridorState.PathGenerationData.OriginTemplate->TileAccessPoints)
 			{
-				MaxDestinationEndLocations += CurrentAccessData.AccessibleDirections.Num();
+				CorridorState.MaxOriginStartingLocations += CurrentAccessPoint.Value.AccessibleMask.Num();
 			}
 
-			do
+			for (const TPair<FIntVector, FTileAccessData>& CurrentAccessPoint : CorridorState.PathGenerationData.DestinationTemplate->TileAccessPoints)
 			{
-				TMap<FIntVector, FAdvancedPathNode> PathData;
-				if (AdvancedAStarPathfinding(PathGenerationData.PathStart, PathGenerationData.PathEnd, PathData, PathGenerationDataArray, LevelGenerationSettings, GeneratedLevelData))
-				{
-					// Add the path to the generated level data
+				CorridorState.MaxDestinationEndLocations += CurrentAccessPoint.Value.AccessibleMask.Num();
+			}
 
-					PathGenerationData.OriginTile->TileAccessPoints[PathGenerationData.OriginAccessPoint].DirectionsInUse.Add(PathGenerationData.OriginPathDirection);
+			CorridorState.bPathStarted = true;
+		}
 
-					PathGenerationData.DestinationTile->TileAccessPoints[PathGenerationData.DestinationAccessPoint].DirectionsInUse.Add(PathGenerationData.DestinationPathDirection);
+		FPathGenerationData& PathGenerationData = CorridorState.PathGenerationData;
 
-					TArray<FIntVector> PathDataVectors;
-					PathData.GenerateKeyArray(PathDataVectors);
+		// Step 2. Search for the path until it is found, fails, or the budget runs out.
+		if (!CorridorState.bSearchStarted)
+		{
+			BeginAdvancedAStarPathfinding(CorridorState.Search, PathGenerationData.PathStart, PathGenerationData.PathEnd, LevelGenerationSettings, GeneratedLevelData);
+			CorridorState.bSearchStarted = true;
+		}
 
-					FIntVector PreviousPathVector = FIntVector{ -1, -1, -1 };
-					ETileType PreviousPathTileType = ETileType::Corridor;
+		const int32 Expansions = StepAdvancedAStarPathfinding(CorridorState.Search, ExpansionBudget, PathGenerationDataArray, LevelGenerationSettings, GeneratedLevelData);
+		ExpansionBudget -= Expansions;
+		GeneratedLevelData.Stats.PathExpansions += Expansions;
+		CorridorState.PathExpansions += Expansions;
 
-					for (FIntVector CurrentPathVector : PathDataVectors)
-					{
-						switch (PathData[CurrentPathVector].SpecialPathType)
-						{
-						case ESpecialPathType::None:
-							// Normal Corridor
-							GenerateNormalPathData(CurrentPathVector, PathData, PathGenerationData, PreviousPathVector, PreviousPathTileType, GeneratedLevelData);
-							break;
-
-						case ESpecialPathType::SpecialPathSection:
-							PreviousPathVector = CurrentPathVector;
-							PreviousPathTileType = ETileType::Corridor_Section;
-							break;
-
-						default:
-							GenerateSpecialPathData(CurrentPathVector, PathData, PathGenerationData, PreviousPathVector, PreviousPathTileType, GeneratedLevelData);
-							break;
-						}
-					}
+		if (CorridorState.Search.Result == EPathSearchResult::InProgress) { return false; }
 
-					break;
-				}
-				// Try building a path using different access points
-				else
-				{
-					if (ExcludedOriginAPs.Num() < MaxOriginStartingLocations)
-					{
-						ExcludedOriginAPs.Add(PathGenerationData.PathStart);
-						PathGenerationData = GetShortestPathToTargetRoom(GeneratedLevelData, PathGenerationData.PathData, ExcludedOriginAPs, TArray<FIntVector>());
-					}
-					else
-					{
-						ExcludedDestinationAPs.Add(PathGenerationData.PathEnd);
+		CorridorState.bSearchStarted = false;
 
-						if (ExcludedDestinationAPs.Num() == MaxDestinationEndLocations) { break; }
+		// Step 3. Add the path to the generated level data, or try building it using different access points.
+		bool bPathFinished = true;
 
-						PathGenerationData = GetShortestPathToTargetRoom(GeneratedLevelData, PathGenerationData.PathData, TArray<FIntVector>(), ExcludedDestinationAPs);
-					}
-				}
-			} while (true);
-			
+		if (CorridorState.Search.Result == EPathSearchResult::PathFound)
+		{
+			CommitCorridorPath(PathGenerationData, CorridorState.Search.PathData, GeneratedLevelData);
+			GeneratedLevelData.Stats.CorridorsBuilt++;
+
+			if (GeneratedLevelData.IsCorridorCommitObserved())
+			{
+				TArray<FIntVector> CommittedCoordinates;
+				CorridorState.Search.PathData.GenerateKeyArray(CommittedCoordinates);
+				GeneratedLevelData.NotifyCorridorCommitted(CommittedCoordinates);
+			}
+		}
+		else if (CorridorState.ExcludedOriginAPs.Num() < CorridorState.MaxOriginStartingLocations)
+		{
+			CorridorState.ExcludedOriginAPs.Add(PathGenerationData.PathStart);
+			PathGenerationData = GetShortestPathToTargetRoom(GeneratedLevelData, PathGenerationData.PathData, CorridorState.ExcludedOriginAPs, TArray<FIntVector>());
+			bPathFinished = false;
 		}
 		else
 		{
-			FCorridorTileData CorridorTileData;
-			CorridorTileData.TileType = ETileType::Corridor;
+			CorridorState.ExcludedDestinationAPs.Add(PathGenerationData.PathEnd);
+
+			if (CorridorState.ExcludedDestinationAPs.Num() != CorridorState.MaxDestinationEndLocations)
+			{
+				PathGenerationData = GetShortestPathToTargetRoom(GeneratedLevelData, PathGenerationData.PathData, TArray<FIntVector>(), CorridorState.ExcludedDestinationAPs);
+				bPathFinished = false;
+			}
+			else
+			{
+				// Every access point has been tried, the rooms are left unconnected
+				GeneratedLevelData.Stats.FailedEdges.Add(PathGenerationData.PathData);
+			}
+		}
+
+		if (bPathFinished)
+		{
+			const int32 AccessPointsTried = CorridorState.ExcludedOriginAPs.Num() + CorridorState.ExcludedDestinationAPs.Num() + (CorridorState.Search.Result == EPathSearchResult::PathFound ? 1 : 0);
+			FLevelGenerationTrace::OutputCorridorEdge(GeneratedLevelData.LevelStream.GetInitialSeed(), CorridorState.PathIndex, PathGenerationData.PathData.Origin, PathGenerationData.PathData.Destination, CorridorState.PathExpansions, AccessPointsTried, CorridorState.Search.Result == EPathSearchResult::PathFound);
 
-			const EDirections DirectionToDestination = GetDirectionForIntVectors(CurrentPathGenData.PathStart, CurrentPathGenData.DestinationAccessPointLocation);
-			const EDirections DirectionToOrigin = GetDirectionForIntVectors(CurrentPathGenData.PathStart, CurrentPathGenData.OriginAccessPointLocation);
+			CorridorState.bPathStarted = false;
+			CorridorState.PathIndex++;
+		}
+	}
 
-			CorridorTileData.AdjacentAccessPoints.Add(DirectionToDestination, CurrentPathGenData.DestinationTile->TileType);
-			CorridorTileData.AdjacentAccessPoints.Add(DirectionToOrigin, CurrentPathGenData.OriginTile->TileType);
+	return true;
+}
 
-			CurrentPathGenData.OriginTile->TileAccessPoints[CurrentPathGenData.OriginAccessPoint].DirectionsInUse.Add(RotateDirection(DirectionToDestination, CurrentPathGenData.OriginTile->TileRotation.GetInverse()));
-			CurrentPathGenData.DestinationTile->TileAccessPoints[CurrentPathGenData.DestinationAccessPoint].DirectionsInUse.Add(RotateDirection(DirectionToOrigin, CurrentPathGenData.DestinationTile->TileRotation.GetInverse()));
+void ULevelGenerationLibrary::FinishCorridorGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
+{
+	LEVEL_GENERATION_TRACE_SCOPE(LevelGeneration_CorridorTiles);
 
-			if (!GeneratedLevelData.LevelPathData.Contains(CurrentPathGenData.PathStart))
+	// Insert path data into GeneratedLevelData
+	for (const TPair<FIntVector, FCorridorTileData>& CurrentPath : GeneratedLevelData.LevelPathData)
+	{
+		switch(CurrentPath.Value.TileType)
+		{
+		case ETileType::Corridor:
+			// Pipelined levels keep the corridor map picked when the corridor was streamed in, which only happens on the async path
+			if (LevelGenerationSettings.bPipelineLevelStreaming && GeneratedLevelData.IsCorridorCommitObserved())
+			{
+				GeneratedLevelData.AddTile(CurrentPath.Key, GetCorridorTileDataAtCoordinate(CurrentPath.Key, CurrentPath.Value, GeneratedLevelData));
+			}
+			else
 			{
-				GeneratedLevelData.LevelPathData.Add(CurrentPathGenData.PathStart, CorridorTileData);
+				GeneratedLevelData.AddTile(CurrentPath.Key, GetTileDataFromCorridorTileData(CurrentPath.Value, GeneratedLevelData.CompiledSettings, GeneratedLevelData.LevelStream, GeneratedLevelData.RandomSelectionCache));
 			}
+			break;
+
+		case ETileType::Corridor_Special:
+			AddTileDataFromSpecialCorridorTileData(CurrentPath.Key, CurrentPath.Value, LevelGenerationSettings, GeneratedLevelData);
+			break;
+
+		default:
+			break;
 		}
 	}
+}
 
-	// Insert path data into GeneratedLevelData
-	TArray<FIntVector> PathDataKeys;
-	GeneratedLevelData.LevelPathData.GenerateKeyArray(PathDataKeys);
+void ULevelGenerationLibrary::CommitCorridorPath(const FPathGenerationData& PathGenerationData, const TMap<FIntVector, FAdvancedPathNode>& PathData, FGeneratedLevelData& GeneratedLevelData)
+{
+	PathGenerationData.OriginTile->AddDirectionInUse(*PathGenerationData.OriginTemplate, PathGenerationData.OriginAccessPoint, PathGenerationData.OriginPathDirection);
+
+	PathGenerationData.DestinationTile->AddDirectionInUse(*PathGenerationData.DestinationTemplate, PathGenerationData.DestinationAccessPoint, PathGenerationData.DestinationPathDirection);
 
-	for (FIntVector CurrentKey : PathDataKeys)
+	TArray<FIntVector> PathDataVectors;
+	PathData.GenerateKeyArray(PathDataVectors);
+
+	FIntVector PreviousPathVector = FIntVector{ -1, -1, -1 };
+	ETileType PreviousPathTileType = ETileType::Corridor;
+
+	for (FIntVector CurrentPathVector : PathDataVectors)
 	{
-		FTileData TileData;
-		switch(GeneratedLevelData.LevelPathData[CurrentKey].TileType)
+		switch (PathData[CurrentPathVector].SpecialPathType)
 		{
-		case ETileType::Corridor:
-			TileData = GetTileDataFromCorridorTileData(GeneratedLevelData.LevelPathData[CurrentKey], LevelGenerationSettings, GeneratedLevelData.LevelStream);
-			GeneratedLevelData.LevelTileData.Add(CurrentKey, TileData);
+		case ESpecialPathType::None:
+			// Normal Corridor
+			GenerateNormalPathData(CurrentPathVector, PathData, PathGenerationData, PreviousPathVector, PreviousPathTileType, GeneratedLevelData);
 			break;
 
-		case ETileType::Corridor_Special:
-			AddTileDataFromSpecialCorridorTileData(CurrentKey, GeneratedLevelData.LevelPathData[CurrentKey], LevelGenerationSettings, GeneratedLevelData);
+		case ESpecialPathType::SpecialPathSection:
+			PreviousPathVector = CurrentPathVector;
+			PreviousPathTileType = ETileType::Corridor_Section;
 			break;
 
 		default:
+			GenerateSpecialPathData(CurrentPathVector, PathData, PathGenerationData, PreviousPathVector, PreviousPathTileType, GeneratedLevelData);
 			break;
 		}
 	}
 }
 
-void ULevelGenerationLibrary::PlaceRoomInGrid(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UDataTable* RoomList)
+void ULevelGenerationLibrary::CommitAdjacentCorridor(const FPathGenerationData& PathGenerationData, FGeneratedLevelData& GeneratedLevelData)
+{
+	FCorridorTileData CorridorTileData;
+	CorridorTileData.TileType = ETileType::Corridor;
+
+	const EDirections DirectionToDestination = GetDirectionForIntVectors(PathGenerationData.PathStart, PathGenerationData.DestinationAccessPointLocation);
+	const EDirections DirectionToOrigin = GetDirectionForIntVectors(PathGenerationData.PathStart, PathGenerationData.OriginAccessPointLocation);
+
+	CorridorTileData.SetAdjacentAccessPoint(DirectionToDestination, PathGenerationData.DestinationTemplate->TileType);
+	CorridorTileData.SetAdjacentAccessPoint(DirectionToOrigin, PathGenerationData.OriginTemplate->TileType);
+
+	PathGenerationData.OriginTile->AddDirectionInUse(*PathGenerationData.OriginTemplate, PathGenerationData.OriginAccessPoint, RotateDirection(DirectionToDestination, PathGenerationData.OriginTile->TileRotation.GetInverse()));
+	PathGenerationData.DestinationTile->AddDirectionInUse(*PathGenerationData.DestinationTemplate, PathGenerationData.DestinationAccessPoint, RotateDirection(DirectionToOrigin, PathGenerationData.DestinationTile->TileRotation.GetInverse()));
+
+	if (!GeneratedLevelData.ContainsPath(PathGenerationData.PathStart))
+	{
+		GeneratedLevelData.AddPath(PathGenerationData.PathStart, CorridorTileData);
+	}
+}
+
+void ULevelGenerationLibrary::PlaceRoomInGrid(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UDataTable* RoomList, ETileType RoomType)
 {
-	int32 FailCounter = 0.f;
+	if (!GeneratedLevelData.Occupancy.IsInitializedFor(LevelGenerationSettings.GridSize, LevelGenerationSettings.TileStorageType))
+	{
+		GeneratedLevelData.Occupancy.Initialize(LevelGenerationSettings.GridSize, LevelGenerationSettings.TileStorageType, GeneratedLevelData);
+	}
 
-	while (true)
+	if (LevelGenerationSettings.RoomBufferShape == ERoomBufferShape::Box && !GeneratedLevelData.OccupancyTree.IsInitializedFor(LevelGenerationSettings.GridSize, LevelGenerationSettings.TileStorageType))
 	{
-		// Randomly select a room from the room data table
-		const FTileGenerationData* TileGenerationData = GetRandomRoomFromRoomList(RoomList, GeneratedLevelData.LevelStream);
-		if (!TileGenerationData) { continue; }
+		GeneratedLevelData.OccupancyTree.Initialize(LevelGenerationSettings.GridSize, LevelGenerationSettings.TileStorageType, GeneratedLevelData);
+	}
+
+	FRoomPlacementStats& RoomPlacementStats = GeneratedLevelData.Stats.RoomPlacements.FindOrAdd(RoomType);
+	RoomPlacementStats.RoomsRequested++;
+
+	FRoomPlacementCandidate Placement;
+	int32 PlacementsTested = 0;
+
+	const bool bPlacementFound = LevelGenerationSettings.RoomPlacementMethod == ERoomPlacementMethod::CandidateBatch
+		? FindRoomPlacementInBatches(LevelGenerationSettings, GeneratedLevelData, RoomList, Placement, PlacementsTested)
+		: FindRoomPlacement(LevelGenerationSettings, GeneratedLevelData, RoomList, Placement, PlacementsTested);
+
+	RoomPlacementStats.PlacementsTested += PlacementsTested;
+
+	FLevelGenerationTrace::OutputRoomPlacement(GeneratedLevelData.LevelStream.GetInitialSeed(), RoomType, PlacementsTested, bPlacementFound);
 
-		// Set the room's rotation
-		FRotator RoomRotation = FRotator::ZeroRotator;
-		if (TileGenerationData->bTileHasSetRotation) { RoomRotation = TileGenerationData->TileSetRotation; }
-		else { RoomRotation = GetRandomRoomRotation(GeneratedLevelData.LevelStream); }
+	if (!bPlacementFound) { return; }
 
-		// Set the room's location in the level
-		FIntVector TileCoordinate = FIntVector::ZeroValue;
-		bool bEmptyCoordinateFound = false;
+	RoomPlacementStats.RoomsPlaced++;
+	AddRoomToLevel(GeneratedLevelData, Placement);
+}
+
+FRoomPlacementCandidate ULevelGenerationLibrary::DrawRoomPlacementCandidate(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UDataTable* RoomList, const FRandomStream& Stream)
+{
+	FRoomPlacementCandidate Candidate;
 
-		if (TileGenerationData->bTileHasSetCoordinate && !GeneratedLevelData.LevelTileData.Contains(TileGenerationData->TileSetGridCoordinate)) { TileCoordinate = TileGenerationData->TileSetGridCoordinate; }
-		else { TileCoordinate = GetRandomEmptyCoordinate(LevelGenerationSettings, GeneratedLevelData.LevelStream, GeneratedLevelData.LevelTileData, bEmptyCoordinateFound); }
+	// Randomly select a room from the room data table
+	Candidate.TileGenerationData = GetRandomRoomFromRoomList(RoomList, Stream, GeneratedLevelData.RandomSelectionCache);
+	if (!Candidate.TileGenerationData) { return Candidate; }
+
+	// Set the room's rotation
+	if (Candidate.TileGenerationData->bTileHasSetRotation) { Candidate.RoomRotation = Candidate.TileGenerationData->TileSetRotation; }
+	else { Candidate.RoomRotation = GetRandomRoomRotation(Stream); }
+
+	// Set the room's location in the level
+	if (Candidate.TileGenerationData->bTileHasSetCoordinate && !GeneratedLevelData.ContainsTile(Candidate.TileGenerationData->TileSetGridCoordinate)) { Candidate.TileCoordinate = Candidate.TileGenerationData->TileSetGridCoordinate; }
+	else { Candidate.TileCoordinate = GetRandomEmptyCoordinate(LevelGenerationSettings, Stream, GeneratedLevelData, Candidate.bEmptyCoordinateFound); }
+
+	return Candidate;
+}
+
+bool ULevelGenerationLibrary::FindRoomPlacement(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UDataTable* RoomList, FRoomPlacementCandidate& OutPlacement, int32& PlacementsTested)
+{
+	const int32 MaximumFailures = FMath::RoundToInt((LevelGenerationSettings.GridSize.X * LevelGenerationSettings.GridSize.Y * LevelGenerationSettings.GridSize.Z) * 0.25f);
+	int32 FailCounter = 0;
+
+	while (true)
+	{
+		FRoomPlacementCandidate Candidate = DrawRoomPlacementCandidate(LevelGenerationSettings, GeneratedLevelData, RoomList, GeneratedLevelData.LevelStream);
+		if (!Candidate.TileGenerationData) { continue; }
+
+		PlacementsTested++;
 
 		// Check if the room's placement is valid
-		if (!bEmptyCoordinateFound || !RoomPlacementIsValid(LevelGenerationSettings, GeneratedLevelData, TileGenerationData->TileData.TileAccessPoints, TileCoordinate, RoomRotation, TileGenerationData->TileData.TileSize))
+		Candidate.RoomFootprint = &GetCompiledRoomFootprint(LevelGenerationSettings, GeneratedLevelData, Candidate.TileGenerationData, Candidate.RoomRotation);
+		if (Candidate.bEmptyCoordinateFound && RoomPlacementIsValid(LevelGenerationSettings, GeneratedLevelData, *Candidate.RoomFootprint, Candidate.TileCoordinate))
 		{
-			FailCounter++;
+			OutPlacement = Candidate;
+			return true;
+		}
 
-			// Return if the function has failed too often when trying to place the room
-			if (FailCounter > FMath::RoundToInt((LevelGenerationSettings.GridSize.X * LevelGenerationSettings.GridSize.Y * LevelGenerationSettings.GridSize.Z) * 0.25f))
-			{
-				return;
-			}
-			else { continue; }
+		// Return if the function has failed too often when trying to place the room
+		FailCounter++;
+		if (FailCounter > MaximumFailures) { return false; }
+	}
+}
+
+bool ULevelGenerationLibrary::FindRoomPlacementInBatches(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UDataTable* RoomList, FRoomPlacementCandidate& OutPlacement, int32& PlacementsTested)
+{
+	const int32 MaximumFailures = FMath::RoundToInt((LevelGenerationSettings.GridSize.X * LevelGenerationSettings.GridSize.Y * LevelGenerationSettings.GridSize.Z) * 0.25f);
+	const int32 BatchSize = FMath::Max(1, LevelGenerationSettings.RoomPlacementBatchSize);
+	int32 FailCounter = 0;
+
+	TArray<FRoomPlacementCandidate> Candidates;
+	TArray<bool> CandidateIsValid;
+
+	while (true)
+	{
+		// Step 1. Draw the batch from its own stream, seeded by a single draw from the level stream
+		FRandomStream BatchStream((int32)GeneratedLevelData.LevelStream.GetUnsignedInt());
+
+		Candidates.Reset(BatchSize);
+		for (int32 i = 0; i < BatchSize; i++)
+		{
+			Candidates.Add(DrawRoomPlacementCandidate(LevelGenerationSettings, GeneratedLevelData, RoomList, BatchStream));
 		}
 
-		// Add the room to the level data
-		FTileData TileData;
-		TileData.TileMap = TileGenerationData->TileData.TileMap;
-		TileData.TileSubMaps = TileGenerationData->TileData.TileSubMaps;
-		TileData.TileActorSlotMaps = TileGenerationData->TileData.TileActorSlotMaps;
-		TileData.TileType = TileGenerationData->TileData.TileType;
-		TileData.TileRotation = RoomRotation;
-		TileData.TileSize = TileGenerationData->TileData.TileSize;
-		TileData.TileAccessPoints = TileGenerationData->TileData.TileAccessPoints;
-		TileData.MinimapMesh = TileGenerationData->TileData.MinimapMesh;
-		TileData.ParentRoomCoordinate = TileCoordinate;
-
-		GeneratedLevelData.LevelTileData.Add(TileCoordinate, TileData);
-
-		if (TileData.TileSize.Num() > 1.f)
+		// Step 2. Compile the footprints on this thread, then take their addresses once the cache has stopped growing
+		for (const FRoomPlacementCandidate& Candidate : Candidates)
 		{
-			for (FIntVector CurrentCoordinate : TileData.TileSize.Array())
-			{
-				// The centre section has already been added to the level
-				if (CurrentCoordinate == FIntVector{ 0,0,0 }) { continue; }
+			if (Candidate.TileGenerationData) { GetCompiledRoomFootprint(LevelGenerationSettings, GeneratedLevelData, Candidate.TileGenerationData, Candidate.RoomRotation); }
+		}
 
-				const FIntVector RoomSectionCoordinate = RotateIntVectorCoordinatefromOrigin(CurrentCoordinate, RoomRotation) + TileCoordinate;
+		for (FRoomPlacementCandidate& Candidate : Candidates)
+		{
+			if (Candidate.TileGenerationData) { Candidate.RoomFootprint = &GetCompiledRoomFootprint(LevelGenerationSettings, GeneratedLevelData, Candidate.TileGenerationData, Candidate.RoomRotation); }
+		}
 
-				FTileData RoomSectionTileData;
-				RoomSectionTileData.TileType = ETileType::Room_Section;
-				RoomSectionTileData.TileRotation = RoomRotation;
-				RoomSectionTileData.TileSize.Add({ 0,0,0 });
-				RoomSectionTileData.ParentRoomCoordinate = TileCoordinate;
+		// Step 3. Test the batch in parallel, the level data is only read
+		CandidateIsValid.Init(false, Candidates.Num());
+		ParallelFor(Candidates.Num(), [&](int32 CandidateIndex)
+			{
+				const FRoomPlacementCandidate& Candidate = Candidates[CandidateIndex];
+				CandidateIsValid[CandidateIndex] = Candidate.RoomFootprint && Candidate.bEmptyCoordinateFound && RoomPlacementIsValid(LevelGenerationSettings, GeneratedLevelData, *Candidate.RoomFootprint, Candidate.TileCoordinate);
+			});
 
-				if (TileData.TileAccessPoints.Contains(CurrentCoordinate))
-				{
-					RoomSectionTileData.TileAccessPoints.Add(FIntVector(0,0,0), TileData.TileAccessPoints[CurrentCoordinate]);
+		// Step 4. Take the first valid placement in the order they were drawn
+		for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); CandidateIndex++)
+		{
+			PlacementsTested++;
 
-					GeneratedLevelData.LevelTileData.Add(RoomSectionCoordinate, RoomSectionTileData);
-				}
-				else
-				{
-					GeneratedLevelData.LevelTileData.Add(RoomSectionCoordinate, RoomSectionTileData);
-				}
+			if (CandidateIsValid[CandidateIndex])
+			{
+				OutPlacement = Candidates[CandidateIndex];
+				return true;
 			}
+
+			// Return if the function has failed too often when trying to place the room
+			FailCounter++;
+			if (FailCounter > MaximumFailures) { return false; }
+		}
+	}
+}
+
+void ULevelGenerationLibrary::AddRoomToLevel(FGeneratedLevelData& GeneratedLevelData, const FRoomPlacementCandidate& Placement)
+{
+	const FTileGenerationData* TileGenerationData = Placement.TileGenerationData;
+	const FRotator RoomRotation = Placement.RoomRotation;
+	const FIntVector TileCoordinate = Placement.TileCoordinate;
+
+	// Add the room to the level data
+	FTileData TileData;
+	TileData.TileMap = TileGenerationData->TileData.TileMap;
+	TileData.TileSubMaps = TileGenerationData->TileData.TileSubMaps;
+	TileData.TileActorSlotMaps = TileGenerationData->TileData.TileActorSlotMaps;
+	TileData.TileType = TileGenerationData->TileData.TileType;
+	TileData.TileRotation = RoomRotation;
+	TileData.TileSize = TileGenerationData->TileData.TileSize;
+	TileData.TileAccessPoints = TileGenerationData->TileData.TileAccessPoints;
+	TileData.MinimapMesh = TileGenerationData->TileData.MinimapMesh;
+	TileData.ParentRoomCoordinate = TileCoordinate;
+
+	GeneratedLevelData.AddTile(TileCoordinate, TileData);
+
+	if (TileData.TileSize.Num() > 1.f)
+	{
+		for (FIntVector CurrentCoordinate : TileData.TileSize.Array())
+		{
+			// The centre section has already been added to the level
+			if (CurrentCoordinate == FIntVector{ 0,0,0 }) { continue; }
+
+			const FIntVector RoomSectionCoordinate = RotateIntVectorCoordinatefromOrigin(CurrentCoordinate, RoomRotation) + TileCoordinate;
+
+			GeneratedLevelData.AddSection(RoomSectionCoordinate, MakeTileSectionData(ETileType::Room_Section, TileCoordinate, CurrentCoordinate, TileData));
 		}
-		return;
 	}
 }
 
-UDataTable* ULevelGenerationLibrary::GetRandomRoomListFromDataTable(TMap<UDataTable*, double>& DataTableList, const FRandomStream& LevelStream)
+FTileSectionData ULevelGenerationLibrary::MakeTileSectionData(ETileType SectionType, const FIntVector& ParentCoordinate, const FIntVector& LocalOffset, const FTileData& ParentTileData)
 {
-	if (DataTableList.IsEmpty()) { return nullptr; }
-
-	TArray<double> ProbabilityArray;
-	DataTableList.GenerateValueArray(ProbabilityArray);
+	FTileSectionData SectionData;
+	SectionData.TileType = SectionType;
+	SectionData.ParentCoordinate = ParentCoordinate;
+	SectionData.LocalOffset = LocalOffset;
 
-	double ProbabilityTotal = 0.f;
-	for (double CurrentProbability : ProbabilityArray)
+	if (const FTileAccessData* AccessData = ParentTileData.TileAccessPoints.Find(LocalOffset))
 	{
-		ProbabilityTotal += CurrentProbability;
+		SectionData.AccessMask = FDirectionMask(AccessData->AccessibleDirections).Bits;
 	}
 
-	const double RandomNumber = UKismetMathLibrary::RandomFloatInRangeFromStream(0.f, ProbabilityTotal, LevelStream);
-	double LevelResultMinimum = 0.00000001f;
+	return SectionData;
+}
+
+UDataTable* ULevelGenerationLibrary::GetRandomRoomListFromDataTable(TMap<UDataTable*, double>& DataTableList, const FRandomStream& LevelStream, FRandomSelectionCache& SelectionCache)
+{
+	if (DataTableList.IsEmpty()) { return nullptr; }
 
-	TArray<UDataTable*> DataTableArray;
-	DataTableList.GenerateKeyArray(DataTableArray);
+	FRoomListSelection* RoomListSelection = SelectionCache.RoomLists.Find(&DataTableList);
 
-	for (UDataTable* CurrentDataTable : DataTableArray)
+	if (!RoomListSelection)
 	{
-		if (RandomNumber >= LevelResultMinimum && RandomNumber < DataTableList[CurrentDataTable] + LevelResultMinimum)
-		{
-			return CurrentDataTable;
-		}
-		else
-		{
-			LevelResultMinimum += DataTableList[CurrentDataTable];
-		}
+		RoomListSelection = &SelectionCache.RoomLists.Add(&DataTableList);
+
+		TArray<double> ProbabilityArray;
+		DataTableList.GenerateKeyArray(RoomListSelection->RoomLists);
+		DataTableList.GenerateValueArray(ProbabilityArray);
+
+		RoomListSelection->Selector.Initialize(ProbabilityArray);
 	}
 
-	return nullptr;
+	const int32 RoomListIndex = RoomListSelection->Selector.Pick(LevelStream, SelectionCache.SelectionMethod);
+
+	return RoomListIndex != INDEX_NONE ? RoomListSelection->RoomLists[RoomListIndex] : nullptr;
 }
 
-FTileGenerationData* ULevelGenerationLibrary::GetRandomRoomFromRoomList(UDataTable* RoomDataTable, const FRandomStream& LevelStream)
+FTileGenerationData* ULevelGenerationLibrary::GetRandomRoomFromRoomList(UDataTable* RoomDataTable, const FRandomStream& LevelStream, FRandomSelectionCache& SelectionCache)
 {
-	if (!RoomDataTable) { return nullptr; }
+	return GetRandomRowFromDataTable<FTileGenerationData>(RoomDataTable, LevelStream, SelectionCache);
+}
 
-	TArray<FName> RowNames = RoomDataTable->GetRowNames();
+FCorridorLevelData* ULevelGenerationLibrary::GetRandomCorridorFromCorridorList(UDataTable* RoomDataTable, const FRandomStream& LevelStream, FRandomSelectionCache& SelectionCache)
+{
+	return GetRandomRowFromDataTable<FCorridorLevelData>(RoomDataTable, LevelStream, SelectionCache);
+}
 
-	double ProbabilityTotal = 0.f;
-	for (FName CurrentRowName : RowNames)
-	{
-		FTileGenerationData* TileGenerationData = nullptr;
-		if (TileGenerationData = RoomDataTable->FindRow<FTileGenerationData>(CurrentRowName, ""))
-		{
-			ProbabilityTotal += TileGenerationData->RandomSelectionChance;
-		}
-	}
+FRotator ULevelGenerationLibrary::GetRandomRoomRotation(const FRandomStream& LevelStream)
+{
+	return FRotator(0.f, 90.f * UKismetMathLibrary::RandomIntegerInRangeFromStream(0, 3, LevelStream), 0.f);
+}
 
-	const double RandomLevelResult = UKismetMathLibrary::RandomFloatInRangeFromStream(0.f, ProbabilityTotal, LevelStream);
-	double LevelResultMinimum = 0.00000001f;
+FIntVector ULevelGenerationLibrary::GetRandomEmptyCoordinate(FLevelGenerationSettings& LevelGenerationSettings, const FRandomStream& LevelStream, FGeneratedLevelData& GeneratedLevelData, bool& bEmptyCoordinateFound)
+{
+	bEmptyCoordinateFound = false;
 
-	for (FName CurrentRowName : RowNames)
+	// Build the set of empty coordinates the first time it is needed
+	if (!GeneratedLevelData.FreeCells.IsInitializedFor(LevelGenerationSettings.GridSize, LevelGenerationSettings.TileStorageType))
 	{
-		FTileGenerationData* TileGenerationData = nullptr;
-		if (TileGenerationData = RoomDataTable->FindRow<FTileGenerationData>(CurrentRowName, ""))
-		{
-			if (RandomLevelResult >= LevelResultMinimum && RandomLevelResult < (LevelResultMinimum + TileGenerationData->RandomSelectionChance))
-			{
-				return TileGenerationData;
-			}
-			else { LevelResultMinimum += TileGenerationData->RandomSelectionChance; }
-		}
+		GeneratedLevelData.FreeCells.Initialize(LevelGenerationSettings.GridSize, LevelGenerationSettings.TileStorageType, GeneratedLevelData);
 	}
 
-	return nullptr;
+	const FFreeCellSet& EmptyCoordinates = GeneratedLevelData.FreeCells;
+	
+	if (EmptyCoordinates.Num() > 0)
+	{
+		bEmptyCoordinateFound = true;
+		return EmptyCoordinates.GetFreeCell(UKismetMathLibrary::RandomIntegerInRangeFromStream(0, (EmptyCoordinates.Num() - 1), LevelStream));
+	}
+	
+	return FIntVector{ 0,0,0 };
 }
 
-FCorridorLevelData* ULevelGenerationLibrary::GetRandomCorridorFromCorridorList(UDataTable* RoomDataTable, const FRandomStream& LevelStream)
+bool ULevelGenerationLibrary::RoomPlacementIsValid(const FLevelGenerationSettings& LevelGenerationSettings, const FGeneratedLevelData& GeneratedLevelData, const FCompiledRoomFootprint& RoomFootprint, const FIntVector PlacementCoordinate)
 {
-	if (!RoomDataTable) { return nullptr; }
+	if (!RoomFootprint.bIsValid) { return false; }
 
-	TArray<FName> RowNames = RoomDataTable->GetRowNames();
+	// Every section of the room must be inside the level grid
+	if (!IsCoordinateInGridSpace(PlacementCoordinate + RoomFootprint.FootprintMin, LevelGenerationSettings.GridSize)) { return false; }
+	if (!IsCoordinateInGridSpace(PlacementCoordinate + RoomFootprint.FootprintMax, LevelGenerationSettings.GridSize)) { return false; }
 
-	double ProbabilityTotal = 0.f;
-	for (FName CurrentRowName : RowNames)
+	// Box shaped buffers are tested by counting the occupied coordinates in the cube around each section
+	if (LevelGenerationSettings.RoomBufferShape == ERoomBufferShape::Box)
 	{
-		FCorridorLevelData* TileGenerationData = nullptr;
-		if (TileGenerationData = RoomDataTable->FindRow<FCorridorLevelData>(CurrentRowName, ""))
+		const FOccupancyFenwickTree& OccupancyTree = GeneratedLevelData.OccupancyTree;
+		const FIntVector BufferExtent(FMath::Max(LevelGenerationSettings.RoomBufferSize, 0));
+
+		// The cubes around a solid room merge into a single box
+		if (RoomFootprint.bFootprintIsBox)
 		{
-			ProbabilityTotal += TileGenerationData->RandomSelectionChance;
+			return OccupancyTree.CountOccupied(PlacementCoordinate + RoomFootprint.FootprintMin - BufferExtent, PlacementCoordinate + RoomFootprint.FootprintMax + BufferExtent) == 0;
 		}
+
+		for (const FIntVector& SectionOffset : RoomFootprint.SectionOffsets)
+		{
+			const FIntVector SectionCoordinate = PlacementCoordinate + SectionOffset;
+
+			if (OccupancyTree.CountOccupied(SectionCoordinate - BufferExtent, SectionCoordinate + BufferExtent) > 0) { return false; }
+		}
+
+		return true;
 	}
 
-	const double RandomLevelResult = UKismetMathLibrary::RandomFloatInRangeFromStream(0.f, ProbabilityTotal, LevelStream);
-	double LevelResultMinimum = 0.00000001f;
+	const FOccupancyBitset& Occupancy = GeneratedLevelData.Occupancy;
+	const FIntVector BoxStart = PlacementCoordinate + RoomFootprint.Min;
 
-	for (FName CurrentRowName : RowNames)
+	// Neither the room's sections nor its buffer can overlap an occupied coordinate
+	for (int32 Z = 0; Z < RoomFootprint.Size.Z; Z++)
 	{
-		FCorridorLevelData* TileGenerationData = nullptr;
-		if (TileGenerationData = RoomDataTable->FindRow<FCorridorLevelData>(CurrentRowName, ""))
+		for (int32 Y = 0; Y < RoomFootprint.Size.Y; Y++)
 		{
-			if (RandomLevelResult >= LevelResultMinimum && RandomLevelResult < (LevelResultMinimum + TileGenerationData->RandomSelectionChance))
+			const int32 RowIndex = RoomFootprint.GetRowIndex(Y, Z);
+
+			for (int32 WordIndex = 0; WordIndex < RoomFootprint.WordsPerRow; WordIndex++)
 			{
-				return TileGenerationData;
+				const uint64 RowMask = RoomFootprint.FootprintRows[RowIndex + WordIndex] | RoomFootprint.BufferRows[RowIndex + WordIndex];
+				if (RowMask == 0) { continue; }
+
+				if (RowMask & Occupancy.GetRowBits(BoxStart.Y + Y, BoxStart.Z + Z, BoxStart.X + WordIndex * 64)) { return false; }
 			}
-			else { LevelResultMinimum += TileGenerationData->RandomSelectionChance; }
 		}
 	}
 
-	return nullptr;
+	return true;
 }
 
-FRotator ULevelGenerationLibrary::GetRandomRoomRotation(const FRandomStream& LevelStream)
+const FCompiledRoomFootprint& ULevelGenerationLibrary::GetCompiledRoomFootprint(const FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, const FTileGenerationData* TileGenerationData, const FRotator& RoomRotation)
 {
-	return FRotator(0.f, 90.f * UKismetMathLibrary::RandomIntegerInRangeFromStream(0, 3, LevelStream), 0.f);
+	const int32 RotationIndex = GetRotationIndex(RoomRotation);
+
+	const TPair<const FTileGenerationData*, int32> FootprintKey(TileGenerationData, RotationIndex);
+
+	if (const FCompiledRoomFootprint* RoomFootprint = GeneratedLevelData.CompiledRoomFootprints.Find(FootprintKey)) { return *RoomFootprint; }
+
+	// Box shaped buffers are tested without the buffer bitmasks
+	const int32 RoomBufferSize = LevelGenerationSettings.RoomBufferShape == ERoomBufferShape::Box ? 0 : LevelGenerationSettings.RoomBufferSize;
+
+	return GeneratedLevelData.CompiledRoomFootprints.Add(FootprintKey, CompileRoomFootprint(TileGenerationData->TileData, RotationIndex, RoomBufferSize));
 }
 
-FIntVector ULevelGenerationLibrary::GetRandomEmptyCoordinate(FLevelGenerationSettings& LevelGenerationSettings, const FRandomStream& LevelStream, TMap<FIntVector, FTileData>& LevelTileData, bool& bEmptyCoordinateFound)
+FCompiledRoomFootprint ULevelGenerationLibrary::CompileRoomFootprint(const FTileData& TileData, int32 RotationIndex, int32 RoomBufferSize)
 {
-	bEmptyCoordinateFound = false;
+	FCompiledRoomFootprint RoomFootprint;
 
-	TArray<FIntVector> EmptyCoordinates;
+	if (TileData.TileAccessPoints.IsEmpty() || TileData.TileSize.IsEmpty()) { return RoomFootprint; }
 
-	for (int Z = 0; Z < (LevelGenerationSettings.GridSize.Z - 1); Z++)
+	const FRotator RoomRotation(0.f, RotationIndex * 90.f, 0.f);
+
+	// Step 1. Rotate the room's sections
+	TSet<FIntVector> FootprintCells;
+	for (const FIntVector& CurrentCoordinate : TileData.TileSize)
+	{
+		FootprintCells.Add(RotateIntVectorCoordinatefromOrigin(CurrentCoordinate, RoomRotation));
+	}
+
+	// Step 2. Grow the buffer outwards from every section along each of the checked directions
+	TSet<FIntVector> BufferCells;
+	for (const FIntVector& SectionCoordinate : FootprintCells)
 	{
-		for (int Y = 0; Y < (LevelGenerationSettings.GridSize.Y - 1); Y++)
+		for (int i = 1; i <= RoomBufferSize; i++)
 		{
-			for (int X = 0; X < (LevelGenerationSettings.GridSize.X - 1); X++)
+			for (const FIntVector& CurrentCoordinate : CoordinateChecklist)
 			{
-				const FIntVector Coordinate{ X, Y, Z };
+				const FIntVector BufferCoordinate = SectionCoordinate + RotateIntVectorCoordinatefromOrigin(CurrentCoordinate, RoomRotation) * i;
 
-				if (!LevelTileData.Contains(Coordinate)) { EmptyCoordinates.Add(Coordinate); }
+				if (!FootprintCells.Contains(BufferCoordinate)) { BufferCells.Add(BufferCoordinate); }
 			}
 		}
 	}
-	
-	if (!EmptyCoordinates.IsEmpty())
+
+	// Step 3. Find the box surrounding the room and its buffer
+	RoomFootprint.FootprintMin = RoomFootprint.FootprintMax = *FootprintCells.CreateConstIterator();
+	for (const FIntVector& CurrentCoordinate : FootprintCells)
 	{
-		bEmptyCoordinateFound = true;
-		return EmptyCoordinates[UKismetMathLibrary::RandomIntegerInRangeFromStream(0, (EmptyCoordinates.Num() - 1), LevelStream)];
+		RoomFootprint.FootprintMin = FIntVector(FMath::Min(RoomFootprint.FootprintMin.X, CurrentCoordinate.X), FMath::Min(RoomFootprint.FootprintMin.Y, CurrentCoordinate.Y), FMath::Min(RoomFootprint.FootprintMin.Z, CurrentCoordinate.Z));
+		RoomFootprint.FootprintMax = FIntVector(FMath::Max(RoomFootprint.FootprintMax.X, CurrentCoordinate.X), FMath::Max(RoomFootprint.FootprintMax.Y, CurrentCoordinate.Y), FMath::Max(RoomFootprint.FootprintMax.Z, CurrentCoordinate.Z));
 	}
-	
-	return FIntVector{ 0,0,0 };
-}
 
-bool ULevelGenerationLibrary::RoomPlacementIsValid(const FLevelGenerationSettings& LevelGenerationSettings, const FGeneratedLevelData& GeneratedLevelData, const TMap<FIntVector, FTileAccessData> TileAccessPoints, const FIntVector PlacementCoordinate, const FRotator RoomRotation, const TSet<FIntVector> TileSize)
-{
-	if (TileAccessPoints.IsEmpty() || TileSize.IsEmpty()) { return false; }
+	const FIntVector FootprintSize = RoomFootprint.FootprintMax - RoomFootprint.FootprintMin + FIntVector(1, 1, 1);
+	RoomFootprint.SectionOffsets = FootprintCells.Array();
+	RoomFootprint.bFootprintIsBox = FootprintCells.Num() == FootprintSize.X * FootprintSize.Y * FootprintSize.Z;
 
-	for (FIntVector CurrentCoordinate : TileSize.Array())
+	FIntVector BoxMin = RoomFootprint.FootprintMin;
+	FIntVector BoxMax = RoomFootprint.FootprintMax;
+	for (const FIntVector& CurrentCoordinate : BufferCells)
 	{
-		FIntVector RoomSectionCoordinate = RotateIntVectorCoordinatefromOrigin(CurrentCoordinate, RoomRotation);
-		FIntVector CoordinateToValidate = RoomSectionCoordinate + PlacementCoordinate;
-
-		if (!IsCoordinateInGridSpace(CoordinateToValidate / LevelGenerationSettings.TileSize, LevelGenerationSettings.GridSize)) { return false; }
-		if (!IsRoomBufferEmpty(LevelGenerationSettings, GeneratedLevelData.LevelTileData, CoordinateToValidate, RoomSectionCoordinate, RoomRotation, TileSize)) { return false; }
-		if (GeneratedLevelData.LevelTileData.Contains(CoordinateToValidate)) { return false; }
+		BoxMin = FIntVector(FMath::Min(BoxMin.X, CurrentCoordinate.X), FMath::Min(BoxMin.Y, CurrentCoordinate.Y), FMath::Min(BoxMin.Z, CurrentCoordinate.Z));
+		BoxMax = FIntVector(FMath::Max(BoxMax.X, CurrentCoordinate.X), FMath::Max(BoxMax.Y, CurrentCoordinate.Y), FMath::Max(BoxMax.Z, CurrentCoordinate.Z));
 	}
 
-	return true;
+	RoomFootprint.Min = BoxMin;
+	RoomFootprint.Size = BoxMax - BoxMin + FIntVector(1, 1, 1);
+	RoomFootprint.WordsPerRow = FMath::DivideAndRoundUp(RoomFootprint.Size.X, 64);
+
+	// Step 4. Set the bits of every section and buffer cell
+	const int32 TotalWords = RoomFootprint.WordsPerRow * RoomFootprint.Size.Y * RoomFootprint.Size.Z;
+	RoomFootprint.FootprintRows.Init(0, TotalWords);
+	RoomFootprint.BufferRows.Init(0, TotalWords);
+
+	auto SetBit = [&RoomFootprint](TArray<uint64>& Rows, const FIntVector& Coordinate)
+	{
+		const FIntVector BoxCoordinate = Coordinate - RoomFootprint.Min;
+		Rows[RoomFootprint.GetRowIndex(BoxCoordinate.Y, BoxCoordinate.Z) + (BoxCoordinate.X >> 6)] |= uint64(1) << (BoxCoordinate.X & 63);
+	};
+
+	for (const FIntVector& CurrentCoordinate : FootprintCells) { SetBit(RoomFootprint.FootprintRows, CurrentCoordinate); }
+	for (const FIntVector& CurrentCoordinate : BufferCells) { SetBit(RoomFootprint.BufferRows, CurrentCoordinate); }
+
+	RoomFootprint.bIsValid = true;
+
+	return RoomFootprint;
+}
+
+int32 ULevelGenerationLibrary::GetRotationIndex(const FRotator& TileRotation)
+{
+	const int TotalRotations = (TileRotation.Yaw / 90.f);
+
+	// RotateIntVectorCoordinatefromOrigin does not rotate outside of -270 to 270
+	if (TotalRotations < -3 || TotalRotations > 3) { return 0; }
+
+	return (TotalRotations + 4) % 4;
 }
 
 bool ULevelGenerationLibrary::IsCoordinateInGridSpace(const FIntVector& Coordinate, const FIntVector& GridSize)
@@ -751,51 +1464,75 @@ bool ULevelGenerationLibrary::IsCoordinateInGridSpace(const FIntVector& Coordina
 	return false;
 }
 
-bool ULevelGenerationLibrary::IsRoomBufferEmpty(const FLevelGenerationSettings& LevelGenerationSettings, const TMap<FIntVector, FTileData>& LevelTileData, const FIntVector& RoomCoordinate, const FIntVector& RoomSectionCoordinate, const FRotator& RoomRotation, const TSet<FIntVector>& TileSize)
+// Records the nodes evaluated by the search for the debug drawing.
+static void RecordExploredNodes(const FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, const FAdvancedPathSearch& Search, bool bPathFound)
+{
+	if (!LevelGenerationSettings.bRecordDebugData) { return; }
+
+	FCorridorSearchDebugData& CorridorSearchDebugData = GeneratedLevelData.DebugData.CorridorSearches.AddDefaulted_GetRef();
+	CorridorSearchDebugData.PathStart = Search.StartLocation;
+	CorridorSearchDebugData.PathEnd = Search.EndLocation;
+	CorridorSearchDebugData.bPathFound = bPathFound;
+	Search.CLOSED.GenerateKeyArray(CorridorSearchDebugData.ExploredNodes);
+}
+
+// Assembles the path data of a finished search from the path of its end node.
+static void AssembleFoundPath(FAdvancedPathSearch& Search)
 {
-	if (LevelGenerationSettings.RoomBufferSize == 0) { return true; }
+	Search.Result = EPathSearchResult::PathFound;
+
+	TMap<FIntVector, FAdvancedPathNode*> ChosenPath = Search.CLOSED[Search.EndLocation].PreviousPath;
+
+	TArray<FIntVector> PreviousPathKeyArray;
+	ChosenPath.GenerateKeyArray(PreviousPathKeyArray);
 
-	for (int i = 1; i <= LevelGenerationSettings.RoomBufferSize; i++)
+	for (int i = 1; i < PreviousPathKeyArray.Num() + 1; i++)
 	{
-		for (FIntVector CurrentCoordinate : CoordinateChecklist.Array())
-		{
-			FIntVector RotatedCoordinate = RotateIntVectorCoordinatefromOrigin(CurrentCoordinate, RoomRotation) * i;
-			FIntVector CoordinateToValidate = RotatedCoordinate + RoomCoordinate;
-			FIntVector SecondCoordinateToValidate = (CurrentCoordinate * i) + RoomSectionCoordinate;
+		int PreviousPathKey = PreviousPathKeyArray.Num() - i;
 
-			if (LevelTileData.Contains(CoordinateToValidate) && !TileSize.Contains(SecondCoordinateToValidate)) { return false; }
-		}
-	}
+		const FIntVector PreviousPathCoordinate = PreviousPathKeyArray[PreviousPathKey];
+		FAdvancedPathNode PreviousPathNode = *ChosenPath[PreviousPathCoordinate];
 
-	return true;
+		Search.PathData.Add(PreviousPathCoordinate, PreviousPathNode);
+
+		if (PreviousPathCoordinate == Search.StartLocation) { break; }
+	}
 }
 
 bool ULevelGenerationLibrary::AdvancedAStarPathfinding(FIntVector StartLocation, FIntVector EndLocation, TMap<FIntVector, FAdvancedPathNode>& PathData, const TArray<FPathGenerationData>& PathGenerationDataArray, FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
 {
-	FSpecialPathInfo BlankInfo;
+	FAdvancedPathSearch Search;
+	BeginAdvancedAStarPathfinding(Search, StartLocation, EndLocation, LevelGenerationSettings, GeneratedLevelData);
 
-	const TArray<EDirections> DirectionEvaluationOrder
+	while (Search.Result == EPathSearchResult::InProgress && !GeneratedLevelData.IsGenerationCancelled())
 	{
-		EDirections::West,
-		EDirections::North,
-		EDirections::East,
-		EDirections::South
-	};
+		StepAdvancedAStarPathfinding(Search, MAX_int32, PathGenerationDataArray, LevelGenerationSettings, GeneratedLevelData);
+	}
 
-	// The set of nodes to be evaluated
-	TMap<FIntVector, FAdvancedPathNode> OPEN;
-	// The set of nodes already evaluated
-	TMap<FIntVector, FAdvancedPathNode> CLOSED;
+	PathData = MoveTemp(Search.PathData);
 
-	// Get inaccessible nodes
-	TSet<FIntVector> LevelTiles;
-	GeneratedLevelData.LevelTileData.GetKeys(LevelTiles);
+	return Search.Result == EPathSearchResult::PathFound;
+}
+
+void ULevelGenerationLibrary::BeginAdvancedAStarPathfinding(FAdvancedPathSearch& Search, FIntVector StartLocation, FIntVector EndLocation, FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
+{
+	FSpecialPathInfo BlankInfo;
+
+	Search = FAdvancedPathSearch();
+	Search.StartLocation = StartLocation;
+	Search.EndLocation = EndLocation;
 
-	TSet<FIntVector> InaccessibleNodes;
+	TSet<FIntVector>& InaccessibleNodes = Search.InaccessibleNodes;
 
-	for (FIntVector CurrentVector : LevelTiles)
+	// Get inaccessible nodes
+	for (const TPair<FIntVector, FTileInstanceData>& CurrentTile : GeneratedLevelData.LevelTileData)
 	{
-		switch (GeneratedLevelData.LevelTileData[CurrentVector].TileType)
+		const FIntVector CurrentVector = CurrentTile.Key;
+
+		const FTileTemplate* CurrentTemplate = GeneratedLevelData.GetTileTemplate(CurrentTile.Value);
+		if (!CurrentTemplate) { continue; }
+
+		switch (CurrentTemplate->TileType)
 		{
 		case ETileType::Room_Basic:
 			InaccessibleNodes.Add(CurrentVector);
@@ -820,6 +1557,11 @@ bool ULevelGenerationLibrary::AdvancedAStarPathfinding(FIntVector StartLocation,
 		}
 	}
 
+	for (const TPair<FIntVector, FTileSectionData>& CurrentSection : GeneratedLevelData.LevelSectionData)
+	{
+		if (CurrentSection.Value.TileType == ETileType::Room_Section) { InaccessibleNodes.Add(CurrentSection.Key); }
+	}
+
 	if (InaccessibleNodes.Contains(StartLocation) || InaccessibleNodes.Contains(EndLocation))
 	{
 		FAdvancedPathNode StartingNode;
@@ -828,9 +1570,10 @@ bool ULevelGenerationLibrary::AdvancedAStarPathfinding(FIntVector StartLocation,
 		FAdvancedPathNode EndingNode;
 		EndingNode.ParentNode = EndLocation;
 
-		PathData.Add(StartLocation, StartingNode);
-		PathData.Add(EndLocation, EndingNode);
-		return true;
+		Search.PathData.Add(StartLocation, StartingNode);
+		Search.PathData.Add(EndLocation, EndingNode);
+		Search.Result = EPathSearchResult::PathFound;
+		return;
 	}
 
 	FAdvancedPathNode StartingNode;
@@ -842,11 +1585,37 @@ bool ULevelGenerationLibrary::AdvancedAStarPathfinding(FIntVector StartLocation,
 	StartingNode.FCost = StartingNode.GCost + StartingNode.HCost;
 	StartingNode.FCost += StartingNode.ElevationToEnd == 0 ? 0.f : 2.5f;
 
-	CLOSED.Add(StartLocation, StartingNode);
+	Search.CLOSED.Add(StartLocation, StartingNode);
+}
+
+int32 ULevelGenerationLibrary::StepAdvancedAStarPathfinding(FAdvancedPathSearch& Search, int32 MaxExpansions, const TArray<FPathGenerationData>& PathGenerationDataArray, FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
+{
+	FSpecialPathInfo BlankInfo;
+
+	const TArray<EDirections> DirectionEvaluationOrder
+	{
+		EDirections::West,
+		EDirections::North,
+		EDirections::East,
+		EDirections::South
+	};
+
+	TMap<FIntVector, FAdvancedPathNode>& OPEN = Search.OPEN;
+	TMap<FIntVector, FAdvancedPathNode>& CLOSED = Search.CLOSED;
+	TSet<FIntVector>& InaccessibleNodes = Search.InaccessibleNodes;
+	const FIntVector StartLocation = Search.StartLocation;
+	const FIntVector EndLocation = Search.EndLocation;
+
+	int32 Expansions = 0;
 
 	// Loop
-	do
+	while (Search.Result == EPathSearchResult::InProgress && Expansions < MaxExpansions)
 	{
+		// A cancelled generation leaves the search in progress
+		if (Expansions % PathExpansionsPerCancellationCheck == 0 && GeneratedLevelData.IsGenerationCancelled()) { break; }
+
+		Expansions++;
+
 		// Find all nodes that need to be evaluated (adjacent to CLOSED nodes)
 		TArray<FIntVector> ClosedCoordinates;
 		CLOSED.GenerateKeyArray(ClosedCoordinates);
@@ -869,9 +1638,9 @@ bool ULevelGenerationLibrary::AdvancedAStarPathfinding(FIntVector StartLocation,
 
 				bool bIsThereSpecialPathAtCoordinate = false;
 
-				if (GeneratedLevelData.LevelPathData.Contains(CurrentCoordinate))
+				if (const FCorridorTileData* ExistingPath = GeneratedLevelData.FindPath(CurrentCoordinate))
 				{
-					bIsThereSpecialPathAtCoordinate = GeneratedLevelData.LevelPathData[CurrentCoordinate].SpecialPathType != ESpecialPathType::None;
+					bIsThereSpecialPathAtCoordinate = ExistingPath->SpecialPathType != ESpecialPathType::None;
 				}
 
 				// Add basic nodes to OPEN
@@ -912,7 +1681,9 @@ bool ULevelGenerationLibrary::AdvancedAStarPathfinding(FIntVector StartLocation,
 
 		if (OPEN.IsEmpty())
 		{
-			return false;
+			RecordExploredNodes(LevelGenerationSettings, GeneratedLevelData, Search, false);
+			Search.Result = EPathSearchResult::NoPath;
+			return Expansions;
 		}
 
 		TArray<FIntVector>OpenCoordinates;
@@ -955,7 +1726,9 @@ bool ULevelGenerationLibrary::AdvancedAStarPathfinding(FIntVector StartLocation,
 
 			CLOSED[EndLocation].PreviousPath = PreviousNodePath;
 
-			break;
+			RecordExploredNodes(LevelGenerationSettings, GeneratedLevelData, Search, true);
+			AssembleFoundPath(Search);
+			return Expansions;
 		}
 
 		// For each neighbour of the current node
@@ -966,9 +1739,9 @@ bool ULevelGenerationLibrary::AdvancedAStarPathfinding(FIntVector StartLocation,
 
 			const FIntVector NeighbourCoordinate = CurrentNodeCoordinate + DirectionCoordinates[(EDirections)CurrentDirection];
 
-			if (CLOSED.Contains(NeighbourCoordinate))
+			if (const FAdvancedPathNode* ClosedNeighbour = CLOSED.Find(NeighbourCoordinate))
 			{
-				if (CLOSED[NeighbourCoordinate].SpecialPathType == ESpecialPathType::SpecialPathSection) { continue; }
+				if (ClosedNeighbour->SpecialPathType == ESpecialPathType::SpecialPathSection) { continue; }
 			}
 
 			// If neighbour is not traversable or neighbour is in CLOSED, skip to the next neighbour
@@ -977,9 +1750,9 @@ bool ULevelGenerationLibrary::AdvancedAStarPathfinding(FIntVector StartLocation,
 			// If neighbour lies on the current node's path, ignore it
 			if (CurrentNode.PreviousPath.Contains(NeighbourCoordinate)) { continue; }
 
-			if (GeneratedLevelData.LevelPathData.Contains(NeighbourCoordinate))
+			if (const FCorridorTileData* ExistingPath = GeneratedLevelData.FindPath(NeighbourCoordinate))
 			{
-				if (GeneratedLevelData.LevelPathData[NeighbourCoordinate].SpecialPathType != ESpecialPathType::None) { continue; }
+				if (ExistingPath->SpecialPathType != ESpecialPathType::None) { continue; }
 			}
 
 			// If new path to neighbour is shorter OR neighbour is not in OPEN
@@ -999,208 +1772,23 @@ bool ULevelGenerationLibrary::AdvancedAStarPathfinding(FIntVector StartLocation,
 				OPEN.Add(NeighbourCoordinate, NeighbourNode);
 			}
 		}
-	} while (true);
-
-	// Assemble PathData
-
-	TMap<FIntVector, FAdvancedPathNode*> ChosenPath = CLOSED[EndLocation].PreviousPath;
-
-	TArray<FIntVector> PreviousPathKeyArray;
-	ChosenPath.GenerateKeyArray(PreviousPathKeyArray);
-
-	for (int i = 1; i < PreviousPathKeyArray.Num() + 1; i++)
-	{
-		int PreviousPathKey = PreviousPathKeyArray.Num() - i;
-
-		const FIntVector PreviousPathCoordinate = PreviousPathKeyArray[PreviousPathKey];
-		FAdvancedPathNode PreviousPathNode = *ChosenPath[PreviousPathCoordinate];
-
-		PathData.Add(PreviousPathCoordinate, PreviousPathNode);
-
-		if (PreviousPathCoordinate == StartLocation) { break; }
 	}
 
-	return true;
+	return Expansions;
 }
 
-FTileData ULevelGenerationLibrary::GetTileDataFromCorridorTileData(FCorridorTileData CorridorTileData, FLevelGenerationSettings& LevelGenerationSettings, const FRandomStream& LevelStream)
+FTileData ULevelGenerationLibrary::GetTileDataFromCorridorTileData(const FCorridorTileData& CorridorTileData, const FCompiledLevelGenSettings& CompiledSettings, const FRandomStream& LevelStream, FRandomSelectionCache& SelectionCache)
 {
 	// The returned tile data
 	FTileData OutTileData;
-
-	const TSet<EDirections> AllConnections{EDirections::North, EDirections::East, EDirections::South, EDirections::West};
-
-	TArray<EDirections> InAdjacentAccessPointsKeys;
-	CorridorTileData.AdjacentAccessPoints.GenerateKeyArray(InAdjacentAccessPointsKeys);
-
-	TSet<EDirections> CorridorConnections;
-	for (EDirections CurrentDirection : InAdjacentAccessPointsKeys)
-	{
-		CorridorConnections.Add(CurrentDirection);
-	}
-	
-	// Find out what kind of basic corridor section the corridor tile data is
-	const TSet<EDirections> MissingConnections = AllConnections.Difference(CorridorConnections);
-	
-	// Four-Way
-	if (MissingConnections.IsEmpty())
-	{
-		OutTileData.TileType = ETileType::Corridor;
-		OutTileData.TileRotation = FRotator(0.f, 0.f, 0.f);
-
-		if (LevelGenerationSettings.CorridorLevelDataTableList.Contains(ECorridorType::FourWay))
-		{
-			const FCorridorLevelData* CorridorLevelData = GetRandomCorridorFromCorridorList(LevelGenerationSettings.CorridorLevelDataTableList[ECorridorType::FourWay], LevelStream);
-			OutTileData.TileMap = CorridorLevelData->CorridorMap;
-			OutTileData.TileSubMaps = CorridorLevelData->CorridorSubMaps;
-			OutTileData.TileActorSlotMaps = CorridorLevelData->CorridorActorSlotMaps;
-			OutTileData.MinimapMesh = CorridorLevelData->MinimapMesh;
-		}
-		return OutTileData;
-	}
-
-	// Three-Way
-	if (MissingConnections.Num() == 1.f)
-	{
-		OutTileData.TileType = ETileType::Corridor;
-
-		if (MissingConnections.Contains(EDirections::West))
-		{
-			OutTileData.TileRotation = FRotator(0.f, 0.f, 0.f);
-		}
-		else if (MissingConnections.Contains(EDirections::North))
-		{
-			OutTileData.TileRotation = FRotator(0.f, 90.f, 0.f);
-		}
-		else if (MissingConnections.Contains(EDirections::East))
-		{
-			OutTileData.TileRotation = FRotator(0.f, 180.f, 0.f);
-		}
-		else if (MissingConnections.Contains(EDirections::South))
-		{
-			OutTileData.TileRotation = FRotator(0.f, 270.f, 0.f);
-		}
-
-		if (LevelGenerationSettings.CorridorLevelDataTableList.Contains(ECorridorType::ThreeWay))
-		{
-			const FCorridorLevelData* CorridorLevelData = GetRandomCorridorFromCorridorList(LevelGenerationSettings.CorridorLevelDataTableList[ECorridorType::ThreeWay], LevelStream);
-			OutTileData.TileMap = CorridorLevelData->CorridorMap;
-			OutTileData.TileSubMaps = CorridorLevelData->CorridorSubMaps;
-			OutTileData.TileActorSlotMaps = CorridorLevelData->CorridorActorSlotMaps;
-			OutTileData.MinimapMesh = CorridorLevelData->MinimapMesh;
-		}
-
-		return OutTileData;
-	}
-
-	// Two-Way Corner
-	if (MissingConnections.Num() == 2.f)
-	{
-		// Corner
-		if ((CorridorConnections.Contains(EDirections::North) && CorridorConnections.Contains(EDirections::East)) ||
-			(CorridorConnections.Contains(EDirections::East) && CorridorConnections.Contains(EDirections::South)) ||
-			(CorridorConnections.Contains(EDirections::South) && CorridorConnections.Contains(EDirections::West)) ||
-			(CorridorConnections.Contains(EDirections::West) && CorridorConnections.Contains(EDirections::North)))
-		{
-
-			OutTileData.TileType = ETileType::Corridor;
-
-			if (CorridorConnections.Contains(EDirections::North) && CorridorConnections.Contains(EDirections::East))
-			{
-				OutTileData.TileRotation = FRotator(0.f, 0.f, 0.f);
-			}
-			else if (CorridorConnections.Contains(EDirections::East) && CorridorConnections.Contains(EDirections::South))
-			{
-				OutTileData.TileRotation = FRotator(0.f, 90.f, 0.f);
-			}
-			else if (CorridorConnections.Contains(EDirections::South) && CorridorConnections.Contains(EDirections::West))
-			{
-				OutTileData.TileRotation = FRotator(0.f, 180.f, 0.f);
-			}
-			else if (CorridorConnections.Contains(EDirections::West) && CorridorConnections.Contains(EDirections::North))
-			{
-				OutTileData.TileRotation = FRotator(0.f, 270.f, 0.f);
-			}
-
-			if (LevelGenerationSettings.CorridorLevelDataTableList.Contains(ECorridorType::Corner))
-			{
-				const FCorridorLevelData* CorridorLevelData = GetRandomCorridorFromCorridorList(LevelGenerationSettings.CorridorLevelDataTableList[ECorridorType::Corner], LevelStream);
-				OutTileData.TileMap = CorridorLevelData->CorridorMap;
-				OutTileData.TileSubMaps = CorridorLevelData->CorridorSubMaps;
-				OutTileData.TileActorSlotMaps = CorridorLevelData->CorridorActorSlotMaps;
-				OutTileData.MinimapMesh = CorridorLevelData->MinimapMesh;
-			}
-
-			return OutTileData;
-		}
-		else
-		{
-			OutTileData.TileType = ETileType::Corridor;
-
-			// Straight
-			if (CorridorConnections.Contains(EDirections::North) || CorridorConnections.Contains(EDirections::South))
-			{
-				OutTileData.TileRotation = FRotator(0.f, 0.f, 0.f);
-			}
-			else if (CorridorConnections.Contains(EDirections::East) || CorridorConnections.Contains(EDirections::West))
-			{
-				OutTileData.TileRotation = FRotator(0.f, 90.f, 0.f);
-			}
-
-			if (LevelGenerationSettings.CorridorLevelDataTableList.Contains(ECorridorType::TwoWay))
-			{
-				const FCorridorLevelData* CorridorLevelData = GetRandomCorridorFromCorridorList(LevelGenerationSettings.CorridorLevelDataTableList[ECorridorType::TwoWay], LevelStream);
-				OutTileData.TileMap = CorridorLevelData->CorridorMap;
-				OutTileData.TileSubMaps = CorridorLevelData->CorridorSubMaps;
-				OutTileData.TileActorSlotMaps = CorridorLevelData->CorridorActorSlotMaps;
-				OutTileData.MinimapMesh = CorridorLevelData->MinimapMesh;
-			}
-
-			return OutTileData;
-		}
-	}
-
-	if (MissingConnections.Num() == 3.f)
-	{
-		OutTileData.TileType = ETileType::Corridor;
-		OutTileData.TileRotation = FRotator(0.f, 0.f, 0.f);
-
-		// One-Way
-		if (CorridorConnections.Contains(EDirections::North))
-		{
-			OutTileData.TileRotation = FRotator(0.f, 0.f, 0.f);
-		}
-		else if (CorridorConnections.Contains(EDirections::East))
-		{
-			OutTileData.TileRotation = FRotator(0.f, 90.f, 0.f);
-		}
-		else if (CorridorConnections.Contains(EDirections::South))
-		{
-			OutTileData.TileRotation = FRotator(0.f, 180.f, 0.f);
-		}
-		else if (CorridorConnections.Contains(EDirections::West))
-		{
-			OutTileData.TileRotation = FRotator(0.f, 270.f, 0.f);
-		}
-
-		if (LevelGenerationSettings.CorridorLevelDataTableList.Contains(ECorridorType::OneWay))
-		{
-			const FCorridorLevelData* CorridorLevelData = GetRandomCorridorFromCorridorList(LevelGenerationSettings.CorridorLevelDataTableList[ECorridorType::OneWay], LevelStream);
-			OutTileData.TileMap = CorridorLevelData->CorridorMap;
-			OutTileData.TileSubMaps = CorridorLevelData->CorridorSubMaps;
-			OutTileData.TileActorSlotMaps = CorridorLevelData->CorridorActorSlotMaps;
-			OutTileData.MinimapMesh = CorridorLevelData->MinimapMesh;
-		}
-
-		return OutTileData;
-	}
-
 	OutTileData.TileType = ETileType::Corridor;
-	OutTileData.TileRotation = FRotator(0.f, 0.f, 0.f);
 
-	if (LevelGenerationSettings.CorridorLevelDataTableList.Contains(ECorridorType::ZeroWay))
+	// Find out what kind of basic corridor section the corridor tile data is from the directions it connects to
+	const FCorridorPiece& CorridorPiece = CorridorPieceTable[GetCorridorConnectionMask(CorridorTileData)];
+	OutTileData.TileRotation = FRotator(0.f, CorridorPiece.Yaw, 0.f);
+
+	if (const FCorridorLevelData* CorridorLevelData = GetRandomCorridorFromCorridorList(CompiledSettings.GetCorridorLevelDataTable(CorridorPiece.CorridorType), LevelStream, SelectionCache))
 	{
-		const FCorridorLevelData* CorridorLevelData = GetRandomCorridorFromCorridorList(LevelGenerationSettings.CorridorLevelDataTableList[ECorridorType::ZeroWay], LevelStream);
 		OutTileData.TileMap = CorridorLevelData->CorridorMap;
 		OutTileData.TileSubMaps = CorridorLevelData->CorridorSubMaps;
 		OutTileData.TileActorSlotMaps = CorridorLevelData->CorridorActorSlotMaps;
@@ -1210,6 +1798,13 @@ FTileData ULevelGenerationLibrary::GetTileDataFromCorridorTileData(FCorridorTile
 	return OutTileData;
 }
 
+FTileData ULevelGenerationLibrary::GetCorridorTileDataAtCoordinate(const FIntVector& Coordinate, const FCorridorTileData& CorridorTileData, FGeneratedLevelData& GeneratedLevelData)
+{
+	const FRandomStream CoordinateStream((int32)HashCombine((uint32)GeneratedLevelData.LevelStream.GetInitialSeed(), GetTypeHash(Coordinate)));
+
+	return GetTileDataFromCorridorTileData(CorridorTileData, GeneratedLevelData.CompiledSettings, CoordinateStream, GeneratedLevelData.RandomSelectionCache);
+}
+
 void ULevelGenerationLibrary::AddTileDataFromSpecialCorridorTileData(FIntVector Coordinate, FCorridorTileData CorridorTileData, FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
 {
 	FTileData OutTileData;
@@ -1226,9 +1821,9 @@ void ULevelGenerationLibrary::AddTileDataFromSpecialCorridorTileData(FIntVector
 	}
 
 	// Elevator Bottom
-	if (LevelGenerationSettings.SpecialPathLevelDataTableList.Contains(CorridorSpecialPathType))
+	if (UDataTable* SpecialPathTable = GeneratedLevelData.CompiledSettings.GetSpecialPathLevelDataTable(CorridorSpecialPathType))
 	{
-		const FCorridorLevelData* SpecialCorridor = GetRandomCorridorFromCorridorList(LevelGenerationSettings.SpecialPathLevelDataTableList[CorridorSpecialPathType], GeneratedLevelData.LevelStream);
+		const FCorridorLevelData* SpecialCorridor = GetRandomCorridorFromCorridorList(SpecialPathTable, GeneratedLevelData.LevelStream, GeneratedLevelData.RandomSelectionCache);
 		OutTileData.TileMap = SpecialCorridor ? SpecialCorridor->CorridorMap : nullptr;
 		OutTileData.TileSubMaps = SpecialCorridor ? SpecialCorridor->CorridorSubMaps : TArray<TSoftObjectPtr<UWorld>>();
 		OutTileData.TileActorSlotMaps = SpecialCorridor ? SpecialCorridor->CorridorActorSlotMaps : TMap<EActorSlotType, TSoftObjectPtr<UWorld>>();
@@ -1244,7 +1839,7 @@ void ULevelGenerationLibrary::AddTileDataFromSpecialCorridorTileData(FIntVector
 
 
 
-	GeneratedLevelData.LevelTileData.Add(Coordinate, OutTileData);
+	GeneratedLevelData.AddTile(Coordinate, OutTileData);
 
 	if (OutTileData.TileSize.Num() > 1.f)
 	{
@@ -1255,57 +1850,57 @@ void ULevelGenerationLibrary::AddTileDataFromSpecialCorridorTileData(FIntVector
 
 			const FIntVector CorridorSectionCoordinate = RotateIntVectorCoordinatefromOrigin(CurrentCoordinate, CorridorTileData.SpecialPathRotation) + Coordinate;
 
+			// Sections without their own level only need a compact record
+			if (!(((uint8)CorridorTileData.SpecialPathType >= (uint8)ESpecialPathType::Elevator_S2) && ((uint8)CorridorTileData.SpecialPathType < (uint8)ESpecialPathType::MAX)))
+			{
+				GeneratedLevelData.AddSection(CorridorSectionCoordinate, MakeTileSectionData(ETileType::Corridor_Section, Coordinate, CurrentCoordinate, OutTileData));
+				continue;
+			}
+
 			FTileData CorridorSectionTileData;
 
 			CorridorSectionTileData.TileRotation = OutTileData.TileRotation;
 			CorridorSectionTileData.TileSize.Add({ 0,0,0 });
+			CorridorSectionTileData.TileType = ETileType::Corridor_Special;
 
-			if (((uint8)CorridorTileData.SpecialPathType >= (uint8)ESpecialPathType::Elevator_S2) && ((uint8)CorridorTileData.SpecialPathType < (uint8)ESpecialPathType::MAX))
+			// Elevator Top
+			if (CurrentCoordinate == OutTileData.TileSize.Array().Last())
 			{
-				CorridorSectionTileData.TileType = ETileType::Corridor_Special;
-
-				// Elevator Top
-				if (CurrentCoordinate == OutTileData.TileSize.Array().Last())
-				{
-					if (LevelGenerationSettings.SpecialPathLevelDataTableList.Contains(ESpecialPathType::Elevator_Top))
-					{
-						const FCorridorLevelData* SpecialCorridor = GetRandomCorridorFromCorridorList(LevelGenerationSettings.SpecialPathLevelDataTableList[ESpecialPathType::Elevator_Top], GeneratedLevelData.LevelStream);
-						CorridorSectionTileData.TileMap = SpecialCorridor->CorridorMap;
-						CorridorSectionTileData.TileSubMaps = SpecialCorridor->CorridorSubMaps;
-						CorridorSectionTileData.TileActorSlotMaps = SpecialCorridor->CorridorActorSlotMaps;
-						CorridorSectionTileData.TileAccessPoints = SpecialCorridor->CorridorAccessPoints;
-						CorridorSectionTileData.MinimapMesh = SpecialCorridor->MinimapMesh;
-
-						if (CorridorSectionTileData.TileAccessPoints.Contains(FIntVector(0.f, 0.f, 0.f)) && GeneratedLevelData.LevelPathData.Contains(CorridorSectionCoordinate))
-						{
-							// Get used directions and add them to OutTileData
-							AddUsedAccessPointsToTileData(CorridorSectionTileData, FIntVector(0.f, 0.f, 0.f), GeneratedLevelData.LevelPathData[CorridorSectionCoordinate]);
-						}
-					}
-				}
-				// Elevator Middle
-				else
+				if (UDataTable* SpecialPathTable = GeneratedLevelData.CompiledSettings.GetSpecialPathLevelDataTable(ESpecialPathType::Elevator_Top))
 				{
-					if (LevelGenerationSettings.SpecialPathLevelDataTableList.Contains(ESpecialPathType::Elevator_Middle))
+					const FCorridorLevelData* SpecialCorridor = GetRandomCorridorFromCorridorList(SpecialPathTable, GeneratedLevelData.LevelStream, GeneratedLevelData.RandomSelectionCache);
+					CorridorSectionTileData.TileMap = SpecialCorridor->CorridorMap;
+					CorridorSectionTileData.TileSubMaps = SpecialCorridor->CorridorSubMaps;
+					CorridorSectionTileData.TileActorSlotMaps = SpecialCorridor->CorridorActorSlotMaps;
+					CorridorSectionTileData.TileAccessPoints = SpecialCorridor->CorridorAccessPoints;
+					CorridorSectionTileData.MinimapMesh = SpecialCorridor->MinimapMesh;
+
+					const FCorridorTileData* CorridorSectionPath = GeneratedLevelData.FindPath(CorridorSectionCoordinate);
+					if (CorridorSectionTileData.TileAccessPoints.Contains(FIntVector(0.f, 0.f, 0.f)) && CorridorSectionPath)
 					{
-						const FCorridorLevelData* SpecialCorridor = GetRandomCorridorFromCorridorList(LevelGenerationSettings.SpecialPathLevelDataTableList[ESpecialPathType::Elevator_Middle], GeneratedLevelData.LevelStream);
-						CorridorSectionTileData.TileMap = SpecialCorridor->CorridorMap;
-						CorridorSectionTileData.TileSubMaps = SpecialCorridor->CorridorSubMaps;
-						CorridorSectionTileData.TileActorSlotMaps = SpecialCorridor->CorridorActorSlotMaps;
-						CorridorSectionTileData.MinimapMesh = SpecialCorridor->MinimapMesh;
+						// Get used directions and add them to OutTileData
+						AddUsedAccessPointsToTileData(CorridorSectionTileData, FIntVector(0.f, 0.f, 0.f), *CorridorSectionPath);
 					}
 				}
 			}
+			// Elevator Middle
 			else
 			{
-				CorridorSectionTileData.TileType = ETileType::Corridor_Section;
+				if (UDataTable* SpecialPathTable = GeneratedLevelData.CompiledSettings.GetSpecialPathLevelDataTable(ESpecialPathType::Elevator_Middle))
+				{
+					const FCorridorLevelData* SpecialCorridor = GetRandomCorridorFromCorridorList(SpecialPathTable, GeneratedLevelData.LevelStream, GeneratedLevelData.RandomSelectionCache);
+					CorridorSectionTileData.TileMap = SpecialCorridor->CorridorMap;
+					CorridorSectionTileData.TileSubMaps = SpecialCorridor->CorridorSubMaps;
+					CorridorSectionTileData.TileActorSlotMaps = SpecialCorridor->CorridorActorSlotMaps;
+					CorridorSectionTileData.MinimapMesh = SpecialCorridor->MinimapMesh;
+				}
 			}
 
 			if (OutTileData.TileAccessPoints.Contains(CurrentCoordinate))
 			{
 				CorridorSectionTileData.TileAccessPoints.Add(FIntVector(0, 0, 0), OutTileData.TileAccessPoints[CurrentCoordinate]);
 			}
-			GeneratedLevelData.LevelTileData.Add(CorridorSectionCoordinate, CorridorSectionTileData);
+			GeneratedLevelData.AddTile(CorridorSectionCoordinate, CorridorSectionTileData);
 		}
 	}
 }
@@ -1347,10 +1942,7 @@ void ULevelGenerationLibrary::EvaluateSpecialCorridorStructures(TMap<FIntVector,
 		{EDirections::West, FRotator(0.f, 270.f, 0.f)},
 	};
 
-	TArray<ESpecialPathType> SpecialPathTypeArray;
-	LevelGenerationSettings.AllowedSpecialPathTypes.GenerateKeyArray(SpecialPathTypeArray);
-
-	USpecialPathData* SpecialPathData = LevelGenerationSettings.SpecialPathData.IsValid() ? LevelGenerationSettings.SpecialPathData.Get() : nullptr;
+	const FCompiledLevelGenSettings& CompiledSettings = GeneratedLevelData.CompiledSettings;
 
 	const FIntVector CurrentCoordinate = CurrentClosedNode + DirectionCoordinates[(EDirections)CurrentDirection];
 	const FRotator PathRotation = RotationMap[CurrentDirection];
@@ -1361,12 +1953,12 @@ void ULevelGenerationLibrary::EvaluateSpecialCorridorStructures(TMap<FIntVector,
 	if (InaccessibleNodes.Contains(CurrentCoordinate) || CLOSED.Contains(CurrentCoordinate)) { return; }
 
 	// Check to see which special path objects can be used for the next node in the path
-	for (ESpecialPathType CurrentSpecialPathType : SpecialPathTypeArray)
+	for (ESpecialPathType CurrentSpecialPathType : CompiledSettings.GetAllowedSpecialPathTypes())
 	{
-		if (!LevelGenerationSettings.AllowedSpecialPathTypes[CurrentSpecialPathType]) { continue; }
-		if (!SpecialPathData->SpecialPathSettings.Contains(CurrentSpecialPathType)) { continue; }
+		const FSpecialPathInfo* SpecialPathInfoPtr = CompiledSettings.GetSpecialPathInfo(CurrentSpecialPathType);
+		if (!SpecialPathInfoPtr) { continue; }
 
-		FSpecialPathInfo SpecialPathInfo = SpecialPathData->SpecialPathSettings[CurrentSpecialPathType];
+		const FSpecialPathInfo& SpecialPathInfo = *SpecialPathInfoPtr;
 
 		// Check both variations of the special paths (e.g. stairs going up, stairs going down)
 		for (int i = 0; i < 2; i++)
@@ -1383,9 +1975,9 @@ void ULevelGenerationLibrary::EvaluateSpecialCorridorStructures(TMap<FIntVector,
 				if (OPEN.Contains(ExitVector)) { continue; }
 
 				// Allow the use of existing paths if they are at the same location and rotation
-				if (GeneratedLevelData.LevelPathData.Contains(CurrentCoordinate))
+				if (const FCorridorTileData* ExistingPath = GeneratedLevelData.FindPath(CurrentCoordinate))
 				{
-					FAdvancedPathNode ExistingPathNode = GeneratedLevelData.LevelPathData[CurrentCoordinate].ParentPathNode;
+					const FAdvancedPathNode& ExistingPathNode = ExistingPath->ParentPathNode;
 
 					// If is same path type, rotation and origin vector, use it
 					if (ExistingPathNode.SpecialPathType == CurrentSpecialPathType && ExistingPathNode.SpecialPathRotation == PathRotation && ExistingPathNode.SpecialPathOriginVector == CurrentCoordinate)
@@ -1394,9 +1986,9 @@ void ULevelGenerationLibrary::EvaluateSpecialCorridorStructures(TMap<FIntVector,
 					}
 					/*
 					// If is same path but flipped (up instead of down), use it
-					else if (GeneratedLevelData.LevelPathData.Contains(ExistingPathNode.SpecialPathOriginVector))
+					else if (const FCorridorTileData* ExistingPathParent = GeneratedLevelData.FindPath(ExistingPathNode.SpecialPathOriginVector))
 					{
-						FAdvancedPathNode ExistingPathNodeParent = GeneratedLevelData.LevelPathData[ExistingPathNode.SpecialPathOriginVector].ParentPathNode;
+						const FAdvancedPathNode& ExistingPathNodeParent = ExistingPathParent->ParentPathNode;
 
 						// Guess what the expected origin vector, exit vector and rotation are using data from the current evaluation, then compare with the actual details
 
@@ -1478,9 +2070,9 @@ void ULevelGenerationLibrary::EvaluateSpecialCorridorStructures(TMap<FIntVector,
 				if (OPEN.Contains(ExitVector)) { continue; }
 
 				// Allow the use of existing paths if they are at the same location and rotation
-				if (GeneratedLevelData.LevelPathData.Contains(CurrentCoordinate))
+				if (const FCorridorTileData* ExistingPath = GeneratedLevelData.FindPath(CurrentCoordinate))
 				{
-					FAdvancedPathNode ExistingPathNode = GeneratedLevelData.LevelPathData[CurrentCoordinate].ParentPathNode;
+					const FAdvancedPathNode& ExistingPathNode = ExistingPath->ParentPathNode;
 
 					// If is same path type, rotation and origin vector, use it
 					if (ExistingPathNode.SpecialPathType == CurrentSpecialPathType && ExistingPathNode.SpecialPathRotation == ReversedPathRotation && ExistingPathNode.SpecialPathOriginVector == OriginVector)
@@ -1488,9 +2080,9 @@ void ULevelGenerationLibrary::EvaluateSpecialCorridorStructures(TMap<FIntVector,
 						bOverrideInvalidPlacement = true;
 					}
 					// If is same path but flipped (up instead of down), use it
-					else if (GeneratedLevelData.LevelPathData.Contains(ExistingPathNode.SpecialPathOriginVector))
+					else if (const FCorridorTileData* ExistingPathParent = GeneratedLevelData.FindPath(ExistingPathNode.SpecialPathOriginVector))
 					{
-						FAdvancedPathNode ExistingPathNodeParent = GeneratedLevelData.LevelPathData[ExistingPathNode.SpecialPathOriginVector].ParentPathNode;
+						const FAdvancedPathNode& ExistingPathNodeParent = ExistingPathParent->ParentPathNode;
 
 						// Guess what the expected origin vector, exit vector and rotation are using data from the current evaluation, then compare with the actual details
 
@@ -1560,8 +2152,8 @@ bool ULevelGenerationLibrary::IsCoordinateEmpty(const FIntVector Coordinate, con
 {
 	if (InaccessibleNodes.Contains(Coordinate)) { return false; }
 	else if (CLOSED.Contains(Coordinate)) { return false; }
-	else if (GeneratedLevelData.LevelTileData.Contains(Coordinate)) { return false; }
-	else if (GeneratedLevelData.LevelPathData.Contains(Coordinate)) { return false; }
+	else if (GeneratedLevelData.ContainsTile(Coordinate)) { return false; }
+	else if (GeneratedLevelData.ContainsPath(Coordinate)) { return false; }
 	else if (CLOSED[CurrentClosedNode].PreviousPath.Contains(Coordinate)) { return false; }
 	
 	if (!PathGenerationDataArray.IsEmpty())
@@ -1607,8 +2199,8 @@ void ULevelGenerationLibrary::GenerateNormalPathData(const FIntVector CurrentPat
 	{
 		const EDirections DirectionToDestination = GetDirectionForIntVectors(CurrentPathVector, CurrentPathGenData.DestinationAccessPointLocation);
 
-		CorridorTileData.AdjacentAccessPoints.Add(DirectionToDestination, CurrentPathGenData.DestinationTile->TileType);
-		CorridorTileData.AdjacentAccessPoints.Add(DirectionToParentNode, ETileType::Corridor);
+		CorridorTileData.SetAdjacentAccessPoint(DirectionToDestination, CurrentPathGenData.DestinationTemplate->TileType);
+		CorridorTileData.SetAdjacentAccessPoint(DirectionToParentNode, ETileType::Corridor);
 	}
 	// If current path is adjacent to the path origin
 	else if (CurrentPathVector == CurrentPathGenData.PathStart)
@@ -1617,26 +2209,26 @@ void ULevelGenerationLibrary::GenerateNormalPathData(const FIntVector CurrentPat
 
 		if (PreviousPathVector != FIntVector{ -1, -1, -1 })
 		{
-			CorridorTileData.AdjacentAccessPoints.Add(DirectionToPreviousPath, PreviousPathTileType);
+			CorridorTileData.SetAdjacentAccessPoint(DirectionToPreviousPath, PreviousPathTileType);
 		}
-		CorridorTileData.AdjacentAccessPoints.Add(DirectionToOrigin, CurrentPathGenData.OriginTile->TileType);
+		CorridorTileData.SetAdjacentAccessPoint(DirectionToOrigin, CurrentPathGenData.OriginTemplate->TileType);
 	}
 	else
 	{
 		if (PreviousPathVector != FIntVector{ -1, -1, -1 })
 		{
-			CorridorTileData.AdjacentAccessPoints.Add(DirectionToPreviousPath, PreviousPathTileType);
+			CorridorTileData.SetAdjacentAccessPoint(DirectionToPreviousPath, PreviousPathTileType);
 		}
-		CorridorTileData.AdjacentAccessPoints.Add(DirectionToParentNode, ETileType::Corridor);
+		CorridorTileData.SetAdjacentAccessPoint(DirectionToParentNode, ETileType::Corridor);
 	}
 
-	if (!GeneratedLevelData.LevelPathData.Contains(CurrentPathVector))
+	if (FCorridorTileData* ExistingPath = GeneratedLevelData.FindPath(CurrentPathVector))
 	{
-		GeneratedLevelData.LevelPathData.Add(CurrentPathVector, CorridorTileData);
+		ExistingPath->AppendAdjacentAccessPoints(CorridorTileData);
 	}
 	else
 	{
-		GeneratedLevelData.LevelPathData[CurrentPathVector].AdjacentAccessPoints.Append(CorridorTileData.AdjacentAccessPoints);
+		GeneratedLevelData.AddPath(CurrentPathVector, CorridorTileData);
 	}
 
 	// Let rooms know which access points are in use
@@ -1671,7 +2263,7 @@ void ULevelGenerationLibrary::GenerateNormalPathData(const FIntVector CurrentPat
 		const FIntVector RoomAccessPoint = RotateIntVectorCoordinatefromOrigin((TargetAccessPointCoordinate - RoomCoordinate), RoomTileData.TileRotation);
 		if (!RoomTileData.TileAccessPoints.Contains(RoomAccessPoint)) { continue; }
 
-		RoomTileData.TileAccessPoints[RoomAccessPoint].DirectionsInUse.Add(GetDirectionForIntVectors(TargetAccessPointCoordinate, CurrentPathVector));
+		RoomTileData.TileAccessPoints[RoomAccessPoint].AddDirectionInUse(GetDirectionForIntVectors(TargetAccessPointCoordinate, CurrentPathVector));
 	}*/
 
 	PreviousPathVector = CurrentPathVector;
@@ -1681,9 +2273,9 @@ void ULevelGenerationLibrary::GenerateNormalPathData(const FIntVector CurrentPat
 void ULevelGenerationLibrary::GenerateSpecialPathData(const FIntVector CurrentPathVector, const TMap<FIntVector, FAdvancedPathNode>& PathData, const FPathGenerationData& CurrentPathGenData, FIntVector& PreviousPathVector, ETileType& PreviousPathTileType, FGeneratedLevelData& GeneratedLevelData)
 {
 	FCorridorTileData CorridorTileData;
-	if (GeneratedLevelData.LevelPathData.Contains(PathData[CurrentPathVector].SpecialPathOriginVector))
+	if (const FCorridorTileData* SpecialPathOrigin = GeneratedLevelData.FindPath(PathData[CurrentPathVector].SpecialPathOriginVector))
 	{
-		CorridorTileData = GeneratedLevelData.LevelPathData[PathData[CurrentPathVector].SpecialPathOriginVector];
+		CorridorTileData = *SpecialPathOrigin;
 	}
 	else
 	{
@@ -1709,11 +2301,11 @@ void ULevelGenerationLibrary::GenerateSpecialPathData(const FIntVector CurrentPa
 	for (FIntVector CurrentVector : PathData[CurrentPathVector].SpecialPathInfo.PathVolume)
 	{
 		const FIntVector RotatedCoordinate = PathData[CurrentPathVector].SpecialPathOriginVector + RotateIntVectorCoordinatefromOrigin(CurrentVector, CorridorTileData.SpecialPathRotation);
-		if (!GeneratedLevelData.LevelPathData.Contains(RotatedCoordinate)) { GeneratedLevelData.LevelPathData.Add(RotatedCoordinate, CorridorSectionTileData); }
+		if (!GeneratedLevelData.ContainsPath(RotatedCoordinate)) { GeneratedLevelData.AddPath(RotatedCoordinate, CorridorSectionTileData); }
 	}
 
 	// Build Special Path
-	GeneratedLevelData.LevelPathData.Add(PathData[CurrentPathVector].SpecialPathOriginVector, CorridorTileData);
+	GeneratedLevelData.AddPath(PathData[CurrentPathVector].SpecialPathOriginVector, CorridorTileData);
 
 	if (((uint8)PathData[CurrentPathVector].SpecialPathType >= (uint8)ESpecialPathType::Elevator_S2) && ((uint8)PathData[CurrentPathVector].SpecialPathType < (uint8)ESpecialPathType::MAX))
 	{
@@ -1732,13 +2324,13 @@ void ULevelGenerationLibrary::GenerateSpecialPathData(const FIntVector CurrentPa
 
 			// Previous node
 			EDirections DirectionToPreviousPath = *DirectionCoordinates.FindKey(PreviousPathVector - CurrentPathVector);
-			GeneratedLevelData.LevelPathData[CurrentPathVector].AdjacentAccessPoints.Add(DirectionToPreviousPath, PreviousPathTileType);
+			if (FCorridorTileData* CurrentPath = GeneratedLevelData.FindPath(CurrentPathVector)) { CurrentPath->SetAdjacentAccessPoint(DirectionToPreviousPath, PreviousPathTileType); }
 
 			// Next node
 			const EDirections DirectionToParentNode = GetDirectionForIntVectors(ExitVector, ParentNode);
 			const ETileType ParentNodeTileType = PathData[CurrentPathVector].PreviousPath[ParentNode]->SpecialPathType == ESpecialPathType::None ? ETileType::Corridor : ETileType::Corridor_Special;
 
-			GeneratedLevelData.LevelPathData[ExitVector].AdjacentAccessPoints.Add(DirectionToParentNode, ParentNodeTileType);
+			if (FCorridorTileData* ExitPath = GeneratedLevelData.FindPath(ExitVector)) { ExitPath->SetAdjacentAccessPoint(DirectionToParentNode, ParentNodeTileType); }
 		}
 		else
 		{
@@ -1754,12 +2346,12 @@ void ULevelGenerationLibrary::GenerateSpecialPathData(const FIntVector CurrentPa
 
 			// Previous node
 			EDirections DirectionToPreviousPath = *DirectionCoordinates.FindKey(PreviousPathVector - CurrentPathVector);
-			GeneratedLevelData.LevelPathData[CurrentPathVector].AdjacentAccessPoints.Add(DirectionToPreviousPath, PreviousPathTileType);
+			if (FCorridorTileData* CurrentPath = GeneratedLevelData.FindPath(CurrentPathVector)) { CurrentPath->SetAdjacentAccessPoint(DirectionToPreviousPath, PreviousPathTileType); }
 
 			// Next node
 			const EDirections DirectionToParentNode = GetDirectionForIntVectors(ExitVector, ParentNode);
 			const ETileType ParentNodeTileType = PathData[CurrentPathVector].PreviousPath[ParentNode]->SpecialPathType == ESpecialPathType::None ? ETileType::Corridor : ETileType::Corridor_Special;
-			GeneratedLevelData.LevelPathData[ExitVector].AdjacentAccessPoints.Add(DirectionToParentNode, ParentNodeTileType);
+			if (FCorridorTileData* ExitPath = GeneratedLevelData.FindPath(ExitVector)) { ExitPath->SetAdjacentAccessPoint(DirectionToParentNode, ParentNodeTileType); }
 		}
 	}
 
@@ -1767,7 +2359,7 @@ void ULevelGenerationLibrary::GenerateSpecialPathData(const FIntVector CurrentPa
 	PreviousPathTileType = CorridorTileData.TileType;
 }
 
-void ULevelGenerationLibrary::UpdateAdvancedNode(FAdvancedPathNode& AdvancedPathNode, FLevelGenerationSettings LevelGenerationSettings, FGeneratedLevelData GeneratedLevelData, FIntVector InSpecialPathOriginVector, FIntVector InCurrentCoordinate, FIntVector InExitLocation, ESpecialPathType InSpecialPathType, FSpecialPathInfo InSpecialPathInfo, FRotator InSpecialPathRotation, TMap<FIntVector, FAdvancedPathNode*> InPreviousPath, FIntVector StartLocation, FIntVector EndLocation)
+void ULevelGenerationLibrary::UpdateAdvancedNode(FAdvancedPathNode& AdvancedPathNode, const FLevelGenerationSettings& LevelGenerationSettings, const FGeneratedLevelData& GeneratedLevelData, FIntVector InSpecialPathOriginVector, FIntVector InCurrentCoordinate, FIntVector InExitLocation, ESpecialPathType InSpecialPathType, const FSpecialPathInfo& InSpecialPathInfo, FRotator InSpecialPathRotation, const TMap<FIntVector, FAdvancedPathNode*>& InPreviousPath, FIntVector StartLocation, FIntVector EndLocation)
 {
 	AdvancedPathNode.SpecialPathType = InSpecialPathType;
 	AdvancedPathNode.SpecialPathInfo = InSpecialPathInfo;
@@ -1776,10 +2368,12 @@ void ULevelGenerationLibrary::UpdateAdvancedNode(FAdvancedPathNode& AdvancedPath
 
 	AdvancedPathNode.ElevationToEnd = abs(InExitLocation.Z - EndLocation.Z);
 
-	float NodeWeight = LevelGenerationSettings.TileTypeWeight.Contains(ETileType::Empty) ? LevelGenerationSettings.TileTypeWeight[ETileType::Empty] : 0.f;
-	if (FCorridorTileData* CorridorData = GeneratedLevelData.LevelPathData.Find(InCurrentCoordinate))
+	const FCompiledLevelGenSettings& CompiledSettings = GeneratedLevelData.CompiledSettings;
+
+	float NodeWeight = CompiledSettings.GetTileTypeWeight(ETileType::Empty);
+	if (const FCorridorTileData* CorridorData = GeneratedLevelData.FindPath(InCurrentCoordinate))
 	{
-		NodeWeight = LevelGenerationSettings.TileTypeWeight.Contains(CorridorData->TileType) ? LevelGenerationSettings.TileTypeWeight[CorridorData->TileType] : 0.f;
+		NodeWeight = CompiledSettings.GetTileTypeWeight(CorridorData->TileType);
 	}
 	if (AdvancedPathNode.SpecialPathType != ESpecialPathType::None && AdvancedPathNode.SpecialPathType != ESpecialPathType::SpecialPathSection) { NodeWeight += AdvancedPathNode.SpecialPathInfo.NodeWeight; }
 
@@ -1830,32 +2424,31 @@ void ULevelGenerationLibrary::UpdateAdvancedNode(FAdvancedPathNode& AdvancedPath
 	AdvancedPathNode.FCost += AdvancedPathNode.ElevationToEnd == 0 ? 0.f : AdvancedPathNode.ElevationToEnd * 2.5f;
 }
 
-void ULevelGenerationLibrary::AddUsedAccessPointsToTileData(FTileData& TileData, FIntVector AccessPointCoordinate, FCorridorTileData CorridorTileData)
+void ULevelGenerationLibrary::AddUsedAccessPointsToTileData(FTileData& TileData, FIntVector AccessPointCoordinate, const FCorridorTileData& CorridorTileData)
 {
 	// Let rooms know which access points are in use
-	TArray<EDirections>AdjacentAccessPointArray;
-	CorridorTileData.AdjacentAccessPoints.GenerateKeyArray(AdjacentAccessPointArray);
-	for (EDirections CurrentDirection : AdjacentAccessPointArray)
+	for (const EDirections CurrentDirection : CorridorTileData.AdjacentMask)
 	{
 		FIntVector ActualDirectionVector = RotateIntVectorCoordinatefromOrigin(DirectionCoordinates[CurrentDirection], TileData.TileRotation.GetInverse());
 		EDirections AccessPointDirection = DirectionCoordinates.FindKey(ActualDirectionVector) ? *DirectionCoordinates.FindKey(ActualDirectionVector) : EDirections::None;
 
 		if (AccessPointDirection == EDirections::None) { continue; }
 
-		TileData.TileAccessPoints[AccessPointCoordinate].DirectionsInUse.Add(AccessPointDirection);
+		TileData.TileAccessPoints[AccessPointCoordinate].AddDirectionInUse(AccessPointDirection);
 	}
 }
 
 bool ULevelGenerationLibrary::GetParentNode(const TMap<FIntVector, FAdvancedPathNode>& PathData, FIntVector TargetCoordinate, FIntVector& ParentNode)
 {
 	// Return false if there is no node at the target coordinate
-	if (!PathData.Contains(TargetCoordinate)) { return false; }
+	const FAdvancedPathNode* TargetNode = PathData.Find(TargetCoordinate);
+	if (!TargetNode) { return false; }
 
 	TArray<FIntVector> PreviousPathKeyArray;
-	if (!PathData[TargetCoordinate].PreviousPath.IsEmpty())
+	if (!TargetNode->PreviousPath.IsEmpty())
 	{
-		PathData[TargetCoordinate].PreviousPath.GenerateKeyArray(PreviousPathKeyArray);
-		ParentNode = !PreviousPathKeyArray.IsEmpty() ? PreviousPathKeyArray.Last() : PathData[TargetCoordinate].ParentNode;
+		TargetNode->PreviousPath.GenerateKeyArray(PreviousPathKeyArray);
+		ParentNode = !PreviousPathKeyArray.IsEmpty() ? PreviousPathKeyArray.Last() : TargetNode->ParentNode;
 
 		return true;
 	}
@@ -1868,42 +2461,38 @@ FPathGenerationData ULevelGenerationLibrary::GetShortestPathToTargetRoom(FGenera
 {
 	FPathGenerationData PathGenerationData;
 	PathGenerationData.PathData = InPathData;
-	PathGenerationData.OriginTile = GeneratedLevelData.LevelTileData.Find(InPathData.Origin);
-	PathGenerationData.DestinationTile = GeneratedLevelData.LevelTileData.Find(InPathData.Destination);
+	PathGenerationData.OriginTile = GeneratedLevelData.FindTile(InPathData.Origin);
+	PathGenerationData.OriginTemplate = PathGenerationData.OriginTile ? GeneratedLevelData.GetTileTemplate(*PathGenerationData.OriginTile) : nullptr;
+	PathGenerationData.DestinationTile = GeneratedLevelData.FindTile(InPathData.Destination);
+	PathGenerationData.DestinationTemplate = PathGenerationData.DestinationTile ? GeneratedLevelData.GetTileTemplate(*PathGenerationData.DestinationTile) : nullptr;
 
-	if (PathGenerationData.OriginTile && PathGenerationData.DestinationTile)
+	if (PathGenerationData.OriginTemplate && PathGenerationData.DestinationTemplate)
 	{
-		// Find the best access point to use for the starting location and end location
-		TArray<FIntVector> OriginTileAccessPoints;
-		PathGenerationData.OriginTile->TileAccessPoints.GetKeys(OriginTileAccessPoints);
-
-		TArray<FIntVector> DestinationTileAccessPoints;
-		PathGenerationData.DestinationTile->TileAccessPoints.GetKeys(DestinationTileAccessPoints);
-
+		// Find the best access point to use for the starting location and end location, walking the maps and sets in place so nothing is copied
 		// Check every access point the destination tile has
-		for (FIntVector CurrentDestinationAP : DestinationTileAccessPoints)
+		for (const TPair<FIntVector, FTileAccessData>& DestinationAccessPoint : PathGenerationData.DestinationTemplate->TileAccessPoints)
 		{
-			TArray<EDirections> DestinationDirectionsArray = PathGenerationData.DestinationTile->TileAccessPoints[CurrentDestinationAP].AccessibleDirections.Array();
-			for (EDirections DestinationDirection : DestinationDirectionsArray)
+			const FIntVector CurrentDestinationAP = DestinationAccessPoint.Key;
+			for (const EDirections DestinationDirection : DestinationAccessPoint.Value.AccessibleDirections)
 			{
-				const FIntVector PotentialPathEnd = PathGenerationData.PathData.Destination + RotateIntVectorCoordinatefromOrigin(CurrentDestinationAP + DirectionCoordinates[DestinationDirection], GeneratedLevelData.LevelTileData[PathGenerationData.PathData.Destination].TileRotation);
+				const FIntVector PotentialPathEnd = PathGenerationData.PathData.Destination + RotateIntVectorCoordinatefromOrigin(CurrentDestinationAP + DirectionCoordinates[DestinationDirection], PathGenerationData.DestinationTile->TileRotation);
 				if (ExcludedDestinationAPs.Contains(PotentialPathEnd)) { continue; }
 
-				if (GeneratedLevelData.LevelTileData.Contains(PotentialPathEnd))
+				if (GeneratedLevelData.ContainsTile(PotentialPathEnd))
 				{
 					continue;
 				}
 
 				// Check every access point the origin tile has		
-				for (FIntVector CurrentOriginAP : OriginTileAccessPoints)
+				for (const TPair<FIntVector, FTileAccessData>& OriginAccessPoint : PathGenerationData.OriginTemplate->TileAccessPoints)
 				{
-					TArray<EDirections> OriginDirectionsArray = PathGenerationData.OriginTile->TileAccessPoints[CurrentOriginAP].AccessibleDirections.Array();
-					for (EDirections OriginDirection : OriginDirectionsArray)
+					const FIntVector CurrentOriginAP = OriginAccessPoint.Key;
+					for (const EDirections OriginDirection : OriginAccessPoint.Value.AccessibleDirections)
 					{
-						const FIntVector PotentialPathStart = PathGenerationData.PathData.Origin + RotateIntVectorCoordinatefromOrigin(CurrentOriginAP + DirectionCoordinates[OriginDirection], GeneratedLevelData.LevelTileData[PathGenerationData.PathData.Origin].TileRotation);
+						const FIntVector PotentialPathStart = PathGenerationData.PathData.Origin + RotateIntVectorCoordinatefromOrigin(CurrentOriginAP + DirectionCoordinates[OriginDirection], PathGenerationData.OriginTile->TileRotation);
 						if (ExcludedOriginAPs.Contains(PotentialPathStart)) { continue; }
 
-						if (GeneratedLevelData.LevelTileData.Contains(PotentialPathEnd))
+						if (GeneratedLevelData.ContainsTile(PotentialPathEnd))
 						{
 							continue;
 						}
@@ -1916,11 +2505,11 @@ FPathGenerationData ULevelGenerationLibrary::GetShortestPathToTargetRoom(FGenera
 							if (PotentialShortestDistance < PathGenerationData.PathDistance)
 							{
 								PathGenerationData.OriginAccessPoint = CurrentOriginAP;
-								PathGenerationData.OriginAccessPointLocation = PathGenerationData.PathData.Origin + RotateIntVectorCoordinatefromOrigin(CurrentOriginAP, GeneratedLevelData.LevelTileData[PathGenerationData.PathData.Origin].TileRotation);
+								PathGenerationData.OriginAccessPointLocation = PathGenerationData.PathData.Origin + RotateIntVectorCoordinatefromOrigin(CurrentOriginAP, PathGenerationData.OriginTile->TileRotation);
 								PathGenerationData.OriginPathDirection = OriginDirection;
 
 								PathGenerationData.DestinationAccessPoint = CurrentDestinationAP;
-								PathGenerationData.DestinationAccessPointLocation = PathGenerationData.PathData.Destination + RotateIntVectorCoordinatefromOrigin(CurrentDestinationAP, GeneratedLevelData.LevelTileData[PathGenerationData.PathData.Destination].TileRotation);
+								PathGenerationData.DestinationAccessPointLocation = PathGenerationData.PathData.Destination + RotateIntVectorCoordinatefromOrigin(CurrentDestinationAP, PathGenerationData.DestinationTile->TileRotation);
 								PathGenerationData.DestinationPathDirection = DestinationDirection;
 
 								PathGenerationData.PathEnd = PotentialPathEnd;
@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/FunctionLibraries/LevelGridLibrary.h"
+
+bool ULevelGridLibrary::GetTileDataAtCoordinate(const FGeneratedLevelData& GeneratedLevelData, FIntVector Coordinate, FTileData& OutTileData)
+{
+	return GeneratedLevelData.GetTileData(Coordinate, OutTileData);
+}
+
+bool ULevelGridLibrary::GetPathDataAtCoordinate(const FGeneratedLevelData& GeneratedLevelData, FIntVector Coordinate, FCorridorTileData& OutPathData)
+{
+	const FCorridorTileData* PathData = GeneratedLevelData.FindPath(Coordinate);
+	if (!PathData) { return false; }
+
+	OutPathData = *PathData;
+	return true;
+}
+
+bool ULevelGridLibrary::IsCoordinateOccupied(const FGeneratedLevelData& GeneratedLevelData, FIntVector Coordinate)
+{
+	return GeneratedLevelData.ContainsTile(Coordinate);
+}
+
+TArray<FIntVector> ULevelGridLibrary::GetOccupiedCoordinates(const FGeneratedLevelData& GeneratedLevelData)
+{
+	TArray<FIntVector> OccupiedCoordinates;
+	OccupiedCoordinates.Reserve(GeneratedLevelData.GetTileCount());
+
+	if (!GeneratedLevelData.TileGrid.IsInitialized())
+	{
+		for (const TPair<FIntVector, FTileInstanceData>& CurrentTile : GeneratedLevelData.LevelTileData) { OccupiedCoordinates.Add(CurrentTile.Key); }
+		for (const TPair<FIntVector, FTileSectionData>& CurrentSection : GeneratedLevelData.LevelSectionData) { OccupiedCoordinates.Add(CurrentSection.Key); }
+
+		return OccupiedCoordinates;
+	}
+
+	GeneratedLevelData.TileGrid.ForEachCell([&OccupiedCoordinates](const FIntVector& Coordinate, const FLevelGridCell& Cell)
+		{
+			if (Cell.TileHandle != INDEX_NONE) { OccupiedCoordinates.Add(Coordinate); }
+		});
+
+	return OccupiedCoordinates;
+}
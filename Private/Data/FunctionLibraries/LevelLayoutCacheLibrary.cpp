@@ -0,0 +1,454 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/FunctionLibraries/LevelLayoutCacheLibrary.h"
+#include "Data/FunctionLibraries/LevelGenerationLibrary.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Identifies a level layout cache file.
+static constexpr uint32 LayoutCacheMagic = 0x434C474C; // "LGLC"
+
+// Increase whenever the layout of the file changes, older files are then ignored and regenerated.
+static constexpr uint32 LayoutCacheVersion = 1;
+
+/** Asset paths written to a layout, each path is stored once and referenced by its index. */
+struct FLayoutCachePathTable
+{
+	TArray<FString> Paths;
+	TMap<FString, int32> PathIndices;
+
+	int32 Add(const FString& Path)
+	{
+		if (const int32* PathIndex = PathIndices.Find(Path)) { return *PathIndex; }
+
+		return PathIndices.Add(Path, Paths.Add(Path));
+	}
+};
+
+static void SerializeAssetPath(FArchive& Ar, FLayoutCachePathTable& PathTable, FSoftObjectPath& AssetPath)
+{
+	int32 PathIndex = Ar.IsLoading() ? INDEX_NONE : PathTable.Add(AssetPath.ToString());
+	Ar << PathIndex;
+
+	if (Ar.IsLoading()) { AssetPath = PathTable.Paths.IsValidIndex(PathIndex) ? FSoftObjectPath(PathTable.Paths[PathIndex]) : FSoftObjectPath(); }
+}
+
+static void SerializeMap(FArchive& Ar, FLayoutCachePathTable& PathTable, TSoftObjectPtr<UWorld>& Map)
+{
+	FSoftObjectPath MapPath = Map.ToSoftObjectPath();
+	SerializeAssetPath(Ar, PathTable, MapPath);
+
+	if (Ar.IsLoading()) { Map = TSoftObjectPtr<UWorld>(MapPath); }
+}
+
+static void SerializeMesh(FArchive& Ar, FLayoutCachePathTable& PathTable, UStaticMesh*& Mesh)
+{
+	FSoftObjectPath MeshPath(Mesh);
+	SerializeAssetPath(Ar, PathTable, MeshPath);
+
+	// The mesh is already loaded by the data table it was read from
+	if (Ar.IsLoading()) { Mesh = MeshPath.IsNull() ? nullptr : Cast<UStaticMesh>(MeshPath.TryLoad()); }
+}
+
+// Directions are written in set order, since the order access points are searched in decides ties between paths.
+static void SerializeDirections(FArchive& Ar, TSet<EDirections>& Directions)
+{
+	uint8 DirectionCount = (uint8)Directions.Num();
+	Ar << DirectionCount;
+
+	if (!Ar.IsLoading())
+	{
+		for (EDirections CurrentDirection : Directions) { Ar << CurrentDirection; }
+		return;
+	}
+
+	Directions.Reset();
+	for (uint8 i = 0; i < DirectionCount; i++)
+	{
+		EDirections CurrentDirection = EDirections::None;
+		Ar << CurrentDirection;
+		Directions.Add(CurrentDirection);
+	}
+}
+
+static void SerializeTile(FArchive& Ar, FLayoutCachePathTable& PathTable, FTileData& TileData)
+{
+	SerializeMap(Ar, PathTable, TileData.TileMap);
+
+	int32 SubMapCount = TileData.TileSubMaps.Num();
+	Ar << SubMapCount;
+	if (Ar.IsLoading()) { TileData.TileSubMaps.SetNum(SubMapCount); }
+	for (TSoftObjectPtr<UWorld>& CurrentSubMap : TileData.TileSubMaps) { SerializeMap(Ar, PathTable, CurrentSubMap); }
+
+	int32 ActorSlotMapCount = TileData.TileActorSlotMaps.Num();
+	Ar << ActorSlotMapCount;
+	if (Ar.IsLoading())
+	{
+		for (int32 i = 0; i < ActorSlotMapCount; i++)
+		{
+			EActorSlotType ActorSlotType = EActorSlotType::None;
+			Ar << ActorSlotType;
+			SerializeMap(Ar, PathTable, TileData.TileActorSlotMaps.Add(ActorSlotType));
+		}
+	}
+	else
+	{
+		for (TPair<EActorSlotType, TSoftObjectPtr<UWorld>>& CurrentActorSlotMap : TileData.TileActorSlotMaps)
+		{
+			Ar << CurrentActorSlotMap.Key;
+			SerializeMap(Ar, PathTable, CurrentActorSlotMap.Value);
+		}
+	}
+
+	Ar << TileData.TileType;
+	Ar << TileData.ParentRoomCoordinate;
+	Ar << TileData.TileRotation;
+	Ar << TileData.TileSize;
+
+	int32 AccessPointCount = TileData.TileAccessPoints.Num();
+	Ar << AccessPointCount;
+	if (Ar.IsLoading())
+	{
+		for (int32 i = 0; i < AccessPointCount; i++)
+		{
+			FIntVector AccessPointCoordinate;
+			Ar << AccessPointCoordinate;
+
+			FTileAccessData& AccessData = TileData.TileAccessPoints.Add(AccessPointCoordinate);
+			SerializeDirections(Ar, AccessData.AccessibleDirections);
+			SerializeDirections(Ar, AccessData.DirectionsInUse);
+		}
+	}
+	else
+	{
+		for (TPair<FIntVector, FTileAccessData>& CurrentAccessPoint : TileData.TileAccessPoints)
+		{
+			Ar << CurrentAccessPoint.Key;
+			SerializeDirections(Ar, CurrentAccessPoint.Value.AccessibleDirections);
+			SerializeDirections(Ar, CurrentAccessPoint.Value.DirectionsInUse);
+		}
+	}
+
+	SerializeMesh(Ar, PathTable, TileData.MinimapMesh);
+}
+
+static void SerializeSection(FArchive& Ar, FTileSectionData& SectionData)
+{
+	Ar << SectionData.TileType;
+	Ar << SectionData.ParentCoordinate;
+	Ar << SectionData.LocalOffset;
+	Ar << SectionData.AccessMask;
+}
+
+static void SerializePath(FArchive& Ar, FLayoutCachePathTable& PathTable, FCorridorTileData& PathData)
+{
+	Ar << PathData.TileType;
+	Ar << PathData.SpecialPathType;
+	Ar << PathData.SpecialPathRotation;
+	Ar << PathData.SpecialPathTileSize;
+
+	// Only the parts of the parent node used after the level is generated, the pointers to previous nodes are not kept
+	FAdvancedPathNode& ParentPathNode = PathData.ParentPathNode;
+	Ar << ParentPathNode.ParentNode;
+	Ar << ParentPathNode.GCost;
+	Ar << ParentPathNode.HCost;
+	Ar << ParentPathNode.FCost;
+	Ar << ParentPathNode.SpecialPathType;
+	Ar << ParentPathNode.SpecialPathInfo.PathVolume;
+	Ar << ParentPathNode.SpecialPathInfo.ExitVector;
+	Ar << ParentPathNode.SpecialPathInfo.NodeWeight;
+	Ar << ParentPathNode.SpecialPathOriginVector;
+	Ar << ParentPathNode.SpecialPathRotation;
+	Ar << ParentPathNode.bIsPathReversed;
+	Ar << ParentPathNode.ElevationToEnd;
+
+	uint8 AdjacentAccessPointCount = (uint8)PathData.AdjacentAccessPoints.Num();
+	Ar << AdjacentAccessPointCount;
+	if (Ar.IsLoading())
+	{
+		for (uint8 i = 0; i < AdjacentAccessPointCount; i++)
+		{
+			EDirections Direction = EDirections::None;
+			ETileType AdjacentTileType = ETileType::Empty;
+			Ar << Direction;
+			Ar << AdjacentTileType;
+			PathData.SetAdjacentAccessPoint(Direction, AdjacentTileType);
+		}
+	}
+	else
+	{
+		for (TPair<EDirections, ETileType>& CurrentAccessPoint : PathData.AdjacentAccessPoints)
+		{
+			Ar << CurrentAccessPoint.Key;
+			Ar << CurrentAccessPoint.Value;
+		}
+	}
+
+	SerializeMesh(Ar, PathTable, PathData.MinimapMesh);
+}
+
+static FString MakeCacheFilePath(int32 Seed, uint32 SettingsHash, uint32 ContentHash)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("LevelLayoutCache"), FString::Printf(TEXT("%d_%08x_%08x.bin"), Seed, SettingsHash, ContentHash));
+}
+
+static uint32 GetStructHash(const UScriptStruct* Struct, const void* StructData)
+{
+	if (!Struct || !StructData) { return 0; }
+
+	FString StructText;
+	Struct->ExportText(StructText, StructData, nullptr, nullptr, PPF_None, nullptr);
+
+	return FCrc::StrCrc32(*StructText);
+}
+
+static uint32 GetDataTableHash(const UDataTable* DataTable)
+{
+	if (!DataTable) { return 0; }
+
+	// Names are hashed as text, the hash of an FName changes between runs
+	uint32 Hash = FCrc::StrCrc32(*DataTable->GetPathName());
+	for (const TPair<FName, uint8*>& CurrentRow : DataTable->GetRowMap())
+	{
+		Hash = HashCombine(Hash, HashCombine(FCrc::StrCrc32(*CurrentRow.Key.ToString()), GetStructHash(DataTable->GetRowStruct(), CurrentRow.Value)));
+	}
+
+	return Hash;
+}
+
+bool ULevelLayoutCacheLibrary::GenerateOrLoadLevel(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UObject* WorldRef)
+{
+	// Levels with a random seed are never generated twice
+	const bool bUseLayoutCache = LevelGenerationSettings.bUseLayoutCache && LevelGenerationSettings.bUsePlayerSeed;
+
+	if (bUseLayoutCache && LoadCachedLayout(LevelGenerationSettings, GeneratedLevelData))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ULevelLayoutCacheLibrary::GenerateOrLoadLevel Level loaded from the layout cache!"));
+		return true;
+	}
+
+	ULevelGenerationLibrary::GenerateLevel(LevelGenerationSettings, GeneratedLevelData, WorldRef);
+
+	if (bUseLayoutCache) { SaveCachedLayout(LevelGenerationSettings, GeneratedLevelData); }
+
+	return false;
+}
+
+bool ULevelLayoutCacheLibrary::LoadCachedLayout(const FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
+{
+	const uint32 SettingsHash = GetSettingsHash(LevelGenerationSettings);
+	const uint32 ContentHash = GetContentHash(LevelGenerationSettings);
+	const FString CacheFilePath = MakeCacheFilePath(LevelGenerationSettings.LevelUserSeed, SettingsHash, ContentHash);
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*CacheFilePath)) { return false; }
+
+	// Read the file straight from a memory mapping where the platform supports it
+	TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*CacheFilePath));
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile ? MappedFile->MapRegion(0, MappedFile->GetFileSize()) : nullptr);
+
+	if (MappedRegion)
+	{
+		return ReadLayout(TArrayView<const uint8>(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()), LevelGenerationSettings, SettingsHash, ContentHash, GeneratedLevelData);
+	}
+
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *CacheFilePath)) { return false; }
+
+	return ReadLayout(FileData, LevelGenerationSettings, SettingsHash, ContentHash, GeneratedLevelData);
+}
+
+bool ULevelLayoutCacheLibrary::SaveCachedLayout(const FLevelGenerationSettings& LevelGenerationSettings, const FGeneratedLevelData& GeneratedLevelData)
+{
+	FLayoutCachePathTable PathTable;
+
+	// Step 1. Write the level, collecting every asset path it references.
+	TArray<uint8> LayoutData;
+	FMemoryWriter LayoutWriter(LayoutData);
+
+	int32 TileCount = GeneratedLevelData.LevelTileData.Num();
+	LayoutWriter << TileCount;
+	for (const TPair<FIntVector, FTileInstanceData>& CurrentTile : GeneratedLevelData.LevelTileData)
+	{
+		FIntVector Coordinate = CurrentTile.Key;
+		FTileData TileData;
+		GeneratedLevelData.GetTileData(Coordinate, TileData);
+		LayoutWriter << Coordinate;
+		SerializeTile(LayoutWriter, PathTable, TileData);
+	}
+
+	int32 SectionCount = GeneratedLevelData.LevelSectionData.Num();
+	LayoutWriter << SectionCount;
+	for (const TPair<FIntVector, FTileSectionData>& CurrentSection : GeneratedLevelData.LevelSectionData)
+	{
+		FIntVector Coordinate = CurrentSection.Key;
+		FTileSectionData SectionData = CurrentSection.Value;
+		LayoutWriter << Coordinate;
+		SerializeSection(LayoutWriter, SectionData);
+	}
+
+	int32 PathCount = GeneratedLevelData.LevelPathData.Num();
+	LayoutWriter << PathCount;
+	for (const TPair<FIntVector, FCorridorTileData>& CurrentPath : GeneratedLevelData.LevelPathData)
+	{
+		FIntVector Coordinate = CurrentPath.Key;
+		FCorridorTileData PathData = CurrentPath.Value;
+		LayoutWriter << Coordinate;
+		SerializePath(LayoutWriter, PathTable, PathData);
+	}
+
+	int32 EdgeCount = GeneratedLevelData.MinimumSpanningTree.Num();
+	LayoutWriter << EdgeCount;
+	for (FEdgeInfo CurrentEdge : GeneratedLevelData.MinimumSpanningTree)
+	{
+		LayoutWriter << CurrentEdge.Origin;
+		LayoutWriter << CurrentEdge.Destination;
+		LayoutWriter << CurrentEdge.Weight;
+	}
+
+	// Step 2. Write the header and the asset paths ahead of the level.
+	TArray<uint8> FileData;
+	FMemoryWriter FileWriter(FileData);
+
+	uint32 Magic = LayoutCacheMagic;
+	uint32 Version = LayoutCacheVersion;
+	int32 InitialSeed = GeneratedLevelData.LevelStream.GetInitialSeed();
+	uint32 SettingsHash = GetSettingsHash(LevelGenerationSettings);
+	uint32 ContentHash = GetContentHash(LevelGenerationSettings);
+
+	FileWriter << Magic;
+	FileWriter << Version;
+	FileWriter << InitialSeed;
+	FileWriter << SettingsHash;
+	FileWriter << ContentHash;
+	FileWriter << PathTable.Paths;
+	FileWriter.Serialize(LayoutData.GetData(), LayoutData.Num());
+
+	// Keyed by the seed the level was actually generated with
+	const FString CacheFilePath = MakeCacheFilePath(InitialSeed, SettingsHash, ContentHash);
+	if (!FFileHelper::SaveArrayToFile(FileData, *CacheFilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ULevelLayoutCacheLibrary::SaveCachedLayout Could not write %s!"), *CacheFilePath);
+		return false;
+	}
+
+	return true;
+}
+
+bool ULevelLayoutCacheLibrary::ReadLayout(TArrayView<const uint8> FileData, const FLevelGenerationSettings& LevelGenerationSettings, uint32 SettingsHash, uint32 ContentHash, FGeneratedLevelData& GeneratedLevelData)
+{
+	FMemoryReaderView Reader(FileData);
+
+	// Step 1. Check the header matches the current settings and data tables.
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int32 InitialSeed = 0;
+	uint32 FileSettingsHash = 0;
+	uint32 FileContentHash = 0;
+
+	Reader << Magic;
+	Reader << Version;
+	Reader << InitialSeed;
+	Reader << FileSettingsHash;
+	Reader << FileContentHash;
+
+	if (Reader.IsError() || Magic != LayoutCacheMagic || Version != LayoutCacheVersion) { return false; }
+	if (InitialSeed != LevelGenerationSettings.LevelUserSeed || FileSettingsHash != SettingsHash || FileContentHash != ContentHash) { return false; }
+
+	FLayoutCachePathTable PathTable;
+	Reader << PathTable.Paths;
+
+	// Step 2. Rebuild the level through AddTile, AddSection and AddPath so its indices and templates match a generated level.
+	FGeneratedLevelData LoadedLevelData;
+	LoadedLevelData.LevelStream.Initialize(InitialSeed);
+	LoadedLevelData.TileTemplates = MakeShared<FTileTemplateRegistry>();
+	LoadedLevelData.BuildTileGrid(LevelGenerationSettings.GridSize, LevelGenerationSettings.TileStorageType);
+
+	int32 TileCount = 0;
+	Reader << TileCount;
+	for (int32 i = 0; i < TileCount && !Reader.IsError(); i++)
+	{
+		FIntVector Coordinate;
+		FTileData TileData;
+		Reader << Coordinate;
+		SerializeTile(Reader, PathTable, TileData);
+		LoadedLevelData.AddTile(Coordinate, TileData);
+	}
+
+	int32 SectionCount = 0;
+	Reader << SectionCount;
+	for (int32 i = 0; i < SectionCount && !Reader.IsError(); i++)
+	{
+		FIntVector Coordinate;
+		FTileSectionData SectionData;
+		Reader << Coordinate;
+		SerializeSection(Reader, SectionData);
+		LoadedLevelData.AddSection(Coordinate, SectionData);
+	}
+
+	int32 PathCount = 0;
+	Reader << PathCount;
+	for (int32 i = 0; i < PathCount && !Reader.IsError(); i++)
+	{
+		FIntVector Coordinate;
+		FCorridorTileData PathData;
+		Reader << Coordinate;
+		SerializePath(Reader, PathTable, PathData);
+		LoadedLevelData.AddPath(Coordinate, PathData);
+	}
+
+	int32 EdgeCount = 0;
+	Reader << EdgeCount;
+	for (int32 i = 0; i < EdgeCount && !Reader.IsError(); i++)
+	{
+		FEdgeInfo& CurrentEdge = LoadedLevelData.MinimumSpanningTree.AddDefaulted_GetRef();
+		Reader << CurrentEdge.Origin;
+		Reader << CurrentEdge.Destination;
+		Reader << CurrentEdge.Weight;
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ULevelLayoutCacheLibrary::ReadLayout The cached layout is corrupt and will be regenerated!"));
+		return false;
+	}
+
+	GeneratedLevelData = MoveTemp(LoadedLevelData);
+	return true;
+}
+
+FString ULevelLayoutCacheLibrary::GetCacheFilePath(const FLevelGenerationSettings& LevelGenerationSettings)
+{
+	return MakeCacheFilePath(LevelGenerationSettings.LevelUserSeed, GetSettingsHash(LevelGenerationSettings), GetContentHash(LevelGenerationSettings));
+}
+
+uint32 ULevelLayoutCacheLibrary::GetSettingsHash(const FLevelGenerationSettings& LevelGenerationSettings)
+{
+	return GetStructHash(FLevelGenerationSettings::StaticStruct(), &LevelGenerationSettings);
+}
+
+uint32 ULevelLayoutCacheLibrary::GetContentHash(const FLevelGenerationSettings& LevelGenerationSettings)
+{
+	uint32 Hash = LayoutCacheVersion;
+
+	for (const TPair<ECorridorType, UDataTable*>& CurrentTable : LevelGenerationSettings.CorridorLevelDataTableList) { Hash = HashCombine(Hash, GetDataTableHash(CurrentTable.Value)); }
+	for (const TPair<ESpecialPathType, UDataTable*>& CurrentTable : LevelGenerationSettings.SpecialPathLevelDataTableList) { Hash = HashCombine(Hash, GetDataTableHash(CurrentTable.Value)); }
+	for (const TPair<UDataTable*, double>& CurrentTable : LevelGenerationSettings.BasicRoomList) { Hash = HashCombine(Hash, GetDataTableHash(CurrentTable.Key)); }
+	for (const TPair<FName, FKeyTileData>& CurrentKeyRoom : LevelGenerationSettings.KeyRooms) { Hash = HashCombine(Hash, GetDataTableHash(CurrentKeyRoom.Value.KeyRoomList)); }
+	for (const TPair<FName, FSpecialTileData>& CurrentSpecialRoom : LevelGenerationSettings.SpecialRooms) { Hash = HashCombine(Hash, GetDataTableHash(CurrentSpecialRoom.Value.SpecialRoomList)); }
+
+	if (const USpecialPathData* SpecialPathData = LevelGenerationSettings.SpecialPathData.LoadSynchronous())
+	{
+		for (const TPair<ESpecialPathType, FSpecialPathInfo>& CurrentSpecialPath : SpecialPathData->SpecialPathSettings)
+		{
+			Hash = HashCombine(Hash, HashCombine(GetTypeHash(CurrentSpecialPath.Key), GetStructHash(FSpecialPathInfo::StaticStruct(), &CurrentSpecialPath.Value)));
+		}
+	}
+
+	return Hash;
+}
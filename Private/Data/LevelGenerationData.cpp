@@ -2,6 +2,8 @@
 
 
 #include "Data/LevelGenerationData.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Algo/BinarySearch.h"
 
 void FMinimapInfo_Interactable::SetInteractableTransform(const FVector& Location, const FRotator& Rotation, const FVector& Scale3D, const float MinimapScale, AActor* MinimapActor)
 {
@@ -10,3 +12,728 @@ void FMinimapInfo_Interactable::SetInteractableTransform(const FVector& Location
 	InteractableTransform.SetRotation(MinimapActor->GetActorQuat() + Rotation.Quaternion());
 	InteractableTransform.SetScale3D(Scale3D);*/
 }
+
+void FFreeCellSet::Initialize(const FIntVector& InGridSize, ETileStorageType InStorageType, const FGeneratedLevelData& GeneratedLevelData)
+{
+	GridSize = InGridSize;
+	bIsSparse = InStorageType == ETileStorageType::MortonHash;
+	FreeCells.Reset();
+	CellIndices.Reset();
+	OccupiedIndices.Reset();
+
+	bIsInitialized = true;
+
+	// Only the occupied coordinates are stored, the empty ones are found from them
+	if (bIsSparse)
+	{
+		for (const TPair<FIntVector, FTileInstanceData>& CurrentTile : GeneratedLevelData.LevelTileData)
+		{
+			Occupy(CurrentTile.Key);
+		}
+
+		for (const TPair<FIntVector, FTileSectionData>& CurrentSection : GeneratedLevelData.LevelSectionData)
+		{
+			Occupy(CurrentSection.Key);
+		}
+
+		return;
+	}
+
+	CellIndices.Init(INDEX_NONE, FMath::Max(GridSize.X - 1, 0) * FMath::Max(GridSize.Y - 1, 0) * FMath::Max(GridSize.Z - 1, 0));
+
+	// Rooms are not placed on the last row of each axis
+	for (int Z = 0; Z < (GridSize.Z - 1); Z++)
+	{
+		for (int Y = 0; Y < (GridSize.Y - 1); Y++)
+		{
+			for (int X = 0; X < (GridSize.X - 1); X++)
+			{
+				const FIntVector Coordinate{ X, Y, Z };
+
+				if (!GeneratedLevelData.ContainsTile(Coordinate)) { CellIndices[(int32)GetGridIndex(Coordinate)] = FreeCells.Add(Coordinate); }
+			}
+		}
+	}
+}
+
+void FFreeCellSet::Occupy(const FIntVector& Coordinate)
+{
+	const int64 GridIndex = GetGridIndex(Coordinate);
+	if (GridIndex == INDEX_NONE) { return; }
+
+	if (bIsSparse)
+	{
+		const int32 OccupiedIndex = Algo::LowerBound(OccupiedIndices, GridIndex);
+		if (!OccupiedIndices.IsValidIndex(OccupiedIndex) || OccupiedIndices[OccupiedIndex] != GridIndex) { OccupiedIndices.Insert(GridIndex, OccupiedIndex); }
+
+		return;
+	}
+
+	const int32 FreeCellIndex = CellIndices[(int32)GridIndex];
+	if (FreeCellIndex == INDEX_NONE) { return; }
+
+	// Move the last coordinate into the removed coordinate's slot
+	const FIntVector LastCell = FreeCells.Last();
+	FreeCells.RemoveAtSwap(FreeCellIndex, 1, false);
+
+	if (LastCell != Coordinate) { CellIndices[(int32)GetGridIndex(LastCell)] = FreeCellIndex; }
+	CellIndices[(int32)GridIndex] = INDEX_NONE;
+}
+
+void FFreeCellSet::Release(const FIntVector& Coordinate)
+{
+	const int64 GridIndex = GetGridIndex(Coordinate);
+	if (GridIndex == INDEX_NONE) { return; }
+
+	if (bIsSparse)
+	{
+		const int32 OccupiedIndex = Algo::BinarySearch(OccupiedIndices, GridIndex);
+		if (OccupiedIndex != INDEX_NONE) { OccupiedIndices.RemoveAt(OccupiedIndex); }
+
+		return;
+	}
+
+	if (CellIndices[(int32)GridIndex] != INDEX_NONE) { return; }
+
+	CellIndices[(int32)GridIndex] = FreeCells.Add(Coordinate);
+}
+
+int32 FFreeCellSet::Num() const
+{
+	if (!bIsSparse) { return FreeCells.Num(); }
+
+	const int64 GridVolume = int64(FMath::Max(GridSize.X - 1, 0)) * FMath::Max(GridSize.Y - 1, 0) * FMath::Max(GridSize.Z - 1, 0);
+
+	// The random draw is limited to 32 bits, the empty coordinates past that are never picked
+	return int32(FMath::Min<int64>(GridVolume - OccupiedIndices.Num(), MAX_int32));
+}
+
+FIntVector FFreeCellSet::GetFreeCell(int32 Index) const
+{
+	if (!bIsSparse) { return FreeCells[Index]; }
+
+	// The grid index of the empty coordinate is its index plus the number of occupied coordinates up to it, repeat until no more occupied coordinates are passed
+	int64 GridIndex = Index;
+
+	while (true)
+	{
+		const int64 NextGridIndex = Index + Algo::UpperBound(OccupiedIndices, GridIndex);
+		if (NextGridIndex == GridIndex) { break; }
+
+		GridIndex = NextGridIndex;
+	}
+
+	const int64 RowLength = FMath::Max(GridSize.X - 1, 1);
+	const int64 LayerSize = RowLength * FMath::Max(GridSize.Y - 1, 1);
+
+	return FIntVector(int32(GridIndex % RowLength), int32((GridIndex % LayerSize) / RowLength), int32(GridIndex / LayerSize));
+}
+
+int64 FFreeCellSet::GetGridIndex(const FIntVector& Coordinate) const
+{
+	if (!bIsInitialized) { return INDEX_NONE; }
+
+	if (Coordinate.X < 0 || Coordinate.X >= (GridSize.X - 1) ||
+		Coordinate.Y < 0 || Coordinate.Y >= (GridSize.Y - 1) ||
+		Coordinate.Z < 0 || Coordinate.Z >= (GridSize.Z - 1))
+	{
+		return INDEX_NONE;
+	}
+
+	return (int64(Coordinate.Z) * (GridSize.Y - 1) + Coordinate.Y) * (GridSize.X - 1) + Coordinate.X;
+}
+
+void FWeightedRandomSelector::Initialize(const TArray<double>& InWeights)
+{
+	Weights = InWeights;
+	CumulativeStarts.Reset(Weights.Num());
+	AliasProbabilities.Init(0.0, Weights.Num());
+	AliasIndices.Init(INDEX_NONE, Weights.Num());
+
+	// Step 1. Build the ranges used by the legacy method, matching the offset of the original linear search
+	double RangeStart = 0.00000001f;
+	TotalWeight = 0.0;
+
+	for (double CurrentWeight : Weights)
+	{
+		CumulativeStarts.Add(RangeStart);
+		RangeStart += CurrentWeight;
+		TotalWeight += CurrentWeight;
+	}
+
+	if (TotalWeight <= 0.0) { return; }
+
+	// Step 2. Build the alias table (Vose's method)
+	const int32 WeightCount = Weights.Num();
+	TArray<double> ScaledWeights;
+	ScaledWeights.Reserve(WeightCount);
+
+	TArray<int32> SmallIndices;
+	TArray<int32> LargeIndices;
+
+	for (int32 i = 0; i < WeightCount; i++)
+	{
+		ScaledWeights.Add(FMath::Max(Weights[i], 0.0) * WeightCount / TotalWeight);
+
+		if (ScaledWeights[i] < 1.0) { SmallIndices.Add(i); }
+		else { LargeIndices.Add(i); }
+	}
+
+	while (!SmallIndices.IsEmpty() && !LargeIndices.IsEmpty())
+	{
+		const int32 SmallIndex = SmallIndices.Pop(false);
+		const int32 LargeIndex = LargeIndices.Last();
+
+		AliasProbabilities[SmallIndex] = ScaledWeights[SmallIndex];
+		AliasIndices[SmallIndex] = LargeIndex;
+
+		ScaledWeights[LargeIndex] -= 1.0 - ScaledWeights[SmallIndex];
+
+		if (ScaledWeights[LargeIndex] < 1.0)
+		{
+			LargeIndices.Pop(false);
+			SmallIndices.Add(LargeIndex);
+		}
+	}
+
+	// The remaining columns only pick their own index, any difference from 1 is rounding error
+	for (int32 LargeIndex : LargeIndices) { AliasProbabilities[LargeIndex] = 1.0; }
+	for (int32 SmallIndex : SmallIndices) { AliasProbabilities[SmallIndex] = 1.0; }
+}
+
+int32 FWeightedRandomSelector::Pick(const FRandomStream& LevelStream, ERandomSelectionMethod SelectionMethod) const
+{
+	if (Weights.IsEmpty()) { return INDEX_NONE; }
+
+	if (SelectionMethod == ERandomSelectionMethod::AliasTable)
+	{
+		if (TotalWeight <= 0.0) { return INDEX_NONE; }
+
+		const double ScaledResult = LevelStream.FRand() * Weights.Num();
+		const int32 Column = FMath::Min(FMath::FloorToInt32(ScaledResult), Weights.Num() - 1);
+
+		return (ScaledResult - Column) < AliasProbabilities[Column] ? Column : AliasIndices[Column];
+	}
+
+	// Same random draw and ranges as the original linear search, found with a binary search instead
+	const double RandomResult = UKismetMathLibrary::RandomFloatInRangeFromStream(0.f, TotalWeight, LevelStream);
+
+	const int32 RangeIndex = Algo::UpperBound(CumulativeStarts, RandomResult) - 1;
+	if (RangeIndex == INDEX_NONE) { return INDEX_NONE; }
+
+	return RandomResult < (CumulativeStarts[RangeIndex] + Weights[RangeIndex]) ? RangeIndex : INDEX_NONE;
+}
+
+void FOccupancyBitset::Initialize(const FIntVector& InGridSize, ETileStorageType InStorageType, const FGeneratedLevelData& GeneratedLevelData)
+{
+	GridSize = InGridSize;
+	bIsSparse = InStorageType == ETileStorageType::MortonHash;
+	WordsPerRow = FMath::DivideAndRoundUp(FMath::Max(GridSize.X, 0), 64);
+	SparseWords.Reset();
+
+	if (bIsSparse) { Words.Empty(); }
+	else { Words.Init(0, WordsPerRow * FMath::Max(GridSize.Y, 0) * FMath::Max(GridSize.Z, 0)); }
+
+	bIsInitialized = true;
+
+	for (const TPair<FIntVector, FTileInstanceData>& CurrentTile : GeneratedLevelData.LevelTileData)
+	{
+		SetOccupied(CurrentTile.Key);
+	}
+
+	for (const TPair<FIntVector, FTileSectionData>& CurrentSection : GeneratedLevelData.LevelSectionData)
+	{
+		SetOccupied(CurrentSection.Key);
+	}
+}
+
+void FOccupancyBitset::SetOccupied(const FIntVector& Coordinate)
+{
+	if (Coordinate.X < 0 || Coordinate.X >= GridSize.X ||
+		Coordinate.Y < 0 || Coordinate.Y >= GridSize.Y ||
+		Coordinate.Z < 0 || Coordinate.Z >= GridSize.Z)
+	{
+		return;
+	}
+
+	const uint64 CoordinateBit = uint64(1) << (Coordinate.X & 63);
+
+	if (bIsSparse) { SparseWords.FindOrAdd(FIntVector(Coordinate.X >> 6, Coordinate.Y, Coordinate.Z)) |= CoordinateBit; }
+	else { Words[(Coordinate.Z * GridSize.Y + Coordinate.Y) * WordsPerRow + (Coordinate.X >> 6)] |= CoordinateBit; }
+}
+
+bool FOccupancyBitset::IsOccupied(const FIntVector& Coordinate) const
+{
+	if (Coordinate.X < 0 || Coordinate.X >= GridSize.X) { return false; }
+
+	return (GetRowBits(Coordinate.Y, Coordinate.Z, Coordinate.X) & 1) != 0;
+}
+
+uint64 FOccupancyBitset::GetRowBits(int32 Y, int32 Z, int32 StartX) const
+{
+	if (Y < 0 || Y >= GridSize.Y || Z < 0 || Z >= GridSize.Z) { return 0; }
+	if (StartX <= -64 || StartX >= GridSize.X) { return 0; }
+
+	// The first bits are left of the level grid
+	if (StartX < 0) { return GetWord(0, Y, Z) << -StartX; }
+
+	const int32 WordIndex = StartX >> 6;
+	const int32 Shift = StartX & 63;
+
+	uint64 RowBits = GetWord(WordIndex, Y, Z) >> Shift;
+	if (Shift != 0 && WordIndex + 1 < WordsPerRow) { RowBits |= GetWord(WordIndex + 1, Y, Z) << (64 - Shift); }
+
+	return RowBits;
+}
+
+uint64 FOccupancyBitset::GetWord(int32 WordIndex, int32 Y, int32 Z) const
+{
+	if (!bIsSparse) { return Words[(Z * GridSize.Y + Y) * WordsPerRow + WordIndex]; }
+
+	const uint64* Word = SparseWords.Find(FIntVector(WordIndex, Y, Z));
+	return Word ? *Word : 0;
+}
+
+void FOccupancyFenwickTree::Initialize(const FIntVector& InGridSize, ETileStorageType InStorageType, const FGeneratedLevelData& GeneratedLevelData)
+{
+	GridSize = InGridSize;
+	bIsSparse = InStorageType == ETileStorageType::MortonHash;
+	SparseTree.Reset();
+	SparseOccupiedCells.Reset();
+
+	const int32 GridVolume = bIsSparse ? 0 : FMath::Max(GridSize.X, 0) * FMath::Max(GridSize.Y, 0) * FMath::Max(GridSize.Z, 0);
+	Tree.Init(0, GridVolume);
+	OccupiedCells.Init(false, GridVolume);
+
+	bIsInitialized = true;
+
+	for (const TPair<FIntVector, FTileInstanceData>& CurrentTile : GeneratedLevelData.LevelTileData)
+	{
+		SetOccupied(CurrentTile.Key);
+	}
+
+	for (const TPair<FIntVector, FTileSectionData>& CurrentSection : GeneratedLevelData.LevelSectionData)
+	{
+		SetOccupied(CurrentSection.Key);
+	}
+}
+
+void FOccupancyFenwickTree::SetOccupied(const FIntVector& Coordinate)
+{
+	if (Coordinate.X < 0 || Coordinate.X >= GridSize.X ||
+		Coordinate.Y < 0 || Coordinate.Y >= GridSize.Y ||
+		Coordinate.Z < 0 || Coordinate.Z >= GridSize.Z)
+	{
+		return;
+	}
+
+	if (bIsSparse)
+	{
+		bool bIsAlreadyOccupied = false;
+		SparseOccupiedCells.Add(Coordinate, &bIsAlreadyOccupied);
+		if (bIsAlreadyOccupied) { return; }
+	}
+	else
+	{
+		const int32 GridIndex = GetGridIndex(Coordinate);
+		if (OccupiedCells[GridIndex]) { return; }
+		OccupiedCells[GridIndex] = true;
+	}
+
+	// Add the coordinate to every partial sum that covers it, the tree is one-based along each axis
+	for (int32 Z = Coordinate.Z + 1; Z <= GridSize.Z; Z += Z & -Z)
+	{
+		for (int32 Y = Coordinate.Y + 1; Y <= GridSize.Y; Y += Y & -Y)
+		{
+			for (int32 X = Coordinate.X + 1; X <= GridSize.X; X += X & -X)
+			{
+				const FIntVector TreeCoordinate(X - 1, Y - 1, Z - 1);
+
+				if (bIsSparse) { SparseTree.FindOrAdd(TreeCoordinate)++; }
+				else { Tree[GetGridIndex(TreeCoordinate)]++; }
+			}
+		}
+	}
+}
+
+int32 FOccupancyFenwickTree::CountOccupied(const FIntVector& BoxMin, const FIntVector& BoxMax) const
+{
+	// Clip the box to the level grid
+	const FIntVector Min(FMath::Max(BoxMin.X, 0), FMath::Max(BoxMin.Y, 0), FMath::Max(BoxMin.Z, 0));
+	const FIntVector Max(FMath::Min(BoxMax.X, GridSize.X - 1), FMath::Min(BoxMax.Y, GridSize.Y - 1), FMath::Min(BoxMax.Z, GridSize.Z - 1));
+
+	if (Min.X > Max.X || Min.Y > Max.Y || Min.Z > Max.Z) { return 0; }
+
+	// Inclusion-exclusion of the eight prefix sums around the box
+	return GetPrefixSum(Max.X, Max.Y, Max.Z)
+		- GetPrefixSum(Min.X - 1, Max.Y, Max.Z)
+		- GetPrefixSum(Max.X, Min.Y - 1, Max.Z)
+		- GetPrefixSum(Max.X, Max.Y, Min.Z - 1)
+		+ GetPrefixSum(Min.X - 1, Min.Y - 1, Max.Z)
+		+ GetPrefixSum(Min.X - 1, Max.Y, Min.Z - 1)
+		+ GetPrefixSum(Max.X, Min.Y - 1, Min.Z - 1)
+		- GetPrefixSum(Min.X - 1, Min.Y - 1, Min.Z - 1);
+}
+
+int32 FOccupancyFenwickTree::GetPrefixSum(int32 X, int32 Y, int32 Z) const
+{
+	if (X < 0 || Y < 0 || Z < 0) { return 0; }
+
+	int32 Sum = 0;
+
+	for (int32 TreeZ = Z + 1; TreeZ > 0; TreeZ -= TreeZ & -TreeZ)
+	{
+		for (int32 TreeY = Y + 1; TreeY > 0; TreeY -= TreeY & -TreeY)
+		{
+			for (int32 TreeX = X + 1; TreeX > 0; TreeX -= TreeX & -TreeX)
+			{
+				const FIntVector TreeCoordinate(TreeX - 1, TreeY - 1, TreeZ - 1);
+
+				if (!bIsSparse) { Sum += Tree[GetGridIndex(TreeCoordinate)]; }
+				else if (const int32* PartialSum = SparseTree.Find(TreeCoordinate)) { Sum += *PartialSum; }
+			}
+		}
+	}
+
+	return Sum;
+}
+
+void FCompiledLevelGenSettings::Compile(const FLevelGenerationSettings& LevelGenerationSettings)
+{
+	*this = FCompiledLevelGenSettings();
+
+	for (const TPair<ETileType, float>& CurrentWeight : LevelGenerationSettings.TileTypeWeight)
+	{
+		if (CurrentWeight.Key < ETileType::MAX) { TileTypeWeights[(uint8)CurrentWeight.Key] = CurrentWeight.Value; }
+	}
+
+	for (const TPair<ECorridorType, UDataTable*>& CurrentTable : LevelGenerationSettings.CorridorLevelDataTableList)
+	{
+		if (CurrentTable.Key < ECorridorType::MAX) { CorridorLevelDataTables[(uint8)CurrentTable.Key] = CurrentTable.Value; }
+	}
+
+	for (const TPair<ESpecialPathType, UDataTable*>& CurrentTable : LevelGenerationSettings.SpecialPathLevelDataTableList)
+	{
+		if (CurrentTable.Key < ESpecialPathType::MAX) { SpecialPathLevelDataTables[(uint8)CurrentTable.Key] = CurrentTable.Value; }
+	}
+
+	// Keep the order of the settings map, special paths are tried in this order
+	for (const TPair<ESpecialPathType, bool>& CurrentSpecialPathType : LevelGenerationSettings.AllowedSpecialPathTypes)
+	{
+		if (!CurrentSpecialPathType.Value || CurrentSpecialPathType.Key >= ESpecialPathType::MAX) { continue; }
+
+		AllowedSpecialPathMask |= 1u << (uint8)CurrentSpecialPathType.Key;
+		AllowedSpecialPathTypes[AllowedSpecialPathTypeCount++] = CurrentSpecialPathType.Key;
+	}
+
+	SpecialPathData = LevelGenerationSettings.SpecialPathData.Get();
+	if (SpecialPathData)
+	{
+		for (const TPair<ESpecialPathType, FSpecialPathInfo>& CurrentSpecialPath : SpecialPathData->SpecialPathSettings)
+		{
+			if (CurrentSpecialPath.Key < ESpecialPathType::MAX) { SpecialPathInfos[(uint8)CurrentSpecialPath.Key] = &CurrentSpecialPath.Value; }
+		}
+	}
+
+	bIsCompiled = true;
+}
+
+bool FTileTemplate::Matches(const FTileData& TileData) const
+{
+	if (TileType != TileData.TileType || TileMap != TileData.TileMap || MinimapMesh != TileData.MinimapMesh) { return false; }
+	if (TileSubMaps != TileData.TileSubMaps || !TileActorSlotMaps.OrderIndependentCompareEqual(TileData.TileActorSlotMaps)) { return false; }
+	if (TileSize.Num() != TileData.TileSize.Num() || TileAccessPoints.Num() != TileData.TileAccessPoints.Num()) { return false; }
+
+	for (const FIntVector& CurrentCoordinate : TileSize)
+	{
+		if (!TileData.TileSize.Contains(CurrentCoordinate)) { return false; }
+	}
+
+	for (const TPair<FIntVector, FTileAccessData>& CurrentAccessPoint : TileAccessPoints)
+	{
+		const FTileAccessData* AccessData = TileData.TileAccessPoints.Find(CurrentAccessPoint.Key);
+		if (!AccessData || FDirectionMask(AccessData->AccessibleDirections).Bits != CurrentAccessPoint.Value.AccessibleMask.Bits) { return false; }
+	}
+
+	return true;
+}
+
+int32 FTileTemplate::GetAccessPointIndex(const FIntVector& AccessPoint) const
+{
+	int32 AccessPointIndex = 0;
+
+	for (const TPair<FIntVector, FTileAccessData>& CurrentAccessPoint : TileAccessPoints)
+	{
+		if (CurrentAccessPoint.Key == AccessPoint) { return AccessPointIndex; }
+
+		AccessPointIndex++;
+	}
+
+	return INDEX_NONE;
+}
+
+uint32 FTileTemplateRegistry::GetTemplateHash(const FTileData& TileData)
+{
+	uint32 Hash = HashCombine(GetTypeHash(TileData.TileMap), GetTypeHash(TileData.TileType));
+	Hash = HashCombine(Hash, GetTypeHash(TileData.TileSize.Num()));
+	return HashCombine(Hash, GetTypeHash(TileData.TileAccessPoints.Num()));
+}
+
+uint16 FTileTemplateRegistry::FindOrAddTemplate(const FTileData& TileData)
+{
+	const uint32 Hash = GetTemplateHash(TileData);
+
+	TArray<uint16, TInlineAllocator<4>> CandidateIds;
+	TemplateIds.MultiFind(Hash, CandidateIds);
+
+	for (const uint16 CandidateId : CandidateIds)
+	{
+		if (Templates[CandidateId].Matches(TileData)) { return CandidateId; }
+	}
+
+	if (Templates.Num() >= InvalidTileTemplateId)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FTileTemplateRegistry::FindOrAddTemplate Every template id is in use, the tile cannot be added!"));
+		return InvalidTileTemplateId;
+	}
+
+	FTileTemplate& NewTemplate = Templates.AddDefaulted_GetRef();
+	NewTemplate.TileMap = TileData.TileMap;
+	NewTemplate.TileSubMaps = TileData.TileSubMaps;
+	NewTemplate.TileActorSlotMaps = TileData.TileActorSlotMaps;
+	NewTemplate.TileType = TileData.TileType;
+	NewTemplate.TileSize = TileData.TileSize;
+	NewTemplate.MinimapMesh = TileData.MinimapMesh;
+
+	for (const TPair<FIntVector, FTileAccessData>& CurrentAccessPoint : TileData.TileAccessPoints)
+	{
+		FTileAccessData& TemplateAccessData = NewTemplate.TileAccessPoints.Add(CurrentAccessPoint.Key);
+		TemplateAccessData.AccessibleDirections = CurrentAccessPoint.Value.AccessibleDirections;
+		TemplateAccessData.UpdateDirectionMasks();
+	}
+
+	const uint16 NewTemplateId = uint16(Templates.Num() - 1);
+	TemplateIds.Add(Hash, NewTemplateId);
+
+	return NewTemplateId;
+}
+
+FTileInstanceData FTileTemplateRegistry::MakeInstance(const FTileData& TileData, uint16 TemplateId) const
+{
+	FTileInstanceData Instance;
+	Instance.TileRotation = TileData.TileRotation;
+	Instance.ParentRoomCoordinate = TileData.ParentRoomCoordinate;
+	Instance.LevelInstanceRef = TileData.LevelInstanceRef;
+
+	const FTileTemplate* Template = GetTemplate(TemplateId);
+	if (!Template) { return Instance; }
+
+	Instance.TemplateId = TemplateId;
+	Instance.UsedDirections.Reserve(Template->TileAccessPoints.Num());
+
+	for (const TPair<FIntVector, FTileAccessData>& CurrentAccessPoint : Template->TileAccessPoints)
+	{
+		const FTileAccessData* AccessData = TileData.TileAccessPoints.Find(CurrentAccessPoint.Key);
+		Instance.UsedDirections.Add(AccessData ? FDirectionMask(AccessData->DirectionsInUse) : FDirectionMask());
+	}
+
+	return Instance;
+}
+
+bool FTileTemplateRegistry::ExpandInstance(const FTileInstanceData& Instance, FTileData& OutTileData) const
+{
+	OutTileData.TileRotation = Instance.TileRotation;
+	OutTileData.ParentRoomCoordinate = Instance.ParentRoomCoordinate;
+	OutTileData.LevelInstanceRef = Instance.LevelInstanceRef;
+
+	const FTileTemplate* Template = GetTemplate(Instance.TemplateId);
+	if (!Template) { return false; }
+
+	OutTileData.TileMap = Template->TileMap;
+	OutTileData.TileSubMaps = Template->TileSubMaps;
+	OutTileData.TileActorSlotMaps = Template->TileActorSlotMaps;
+	OutTileData.TileType = Template->TileType;
+	OutTileData.TileSize = Template->TileSize;
+	OutTileData.TileAccessPoints = Template->TileAccessPoints;
+	OutTileData.MinimapMesh = Template->MinimapMesh;
+
+	int32 AccessPointIndex = 0;
+	for (TPair<FIntVector, FTileAccessData>& CurrentAccessPoint : OutTileData.TileAccessPoints)
+	{
+		if (Instance.UsedDirections.IsValidIndex(AccessPointIndex))
+		{
+			CurrentAccessPoint.Value.DirectionsInUse = Instance.UsedDirections[AccessPointIndex].ToSet();
+			CurrentAccessPoint.Value.InUseMask = Instance.UsedDirections[AccessPointIndex];
+		}
+
+		AccessPointIndex++;
+	}
+
+	return true;
+}
+
+SIZE_T FTileTemplateRegistry::GetAllocatedSize() const
+{
+	SIZE_T AllocatedSize = Templates.GetAllocatedSize() + TemplateIds.GetAllocatedSize();
+
+	for (const FTileTemplate& CurrentTemplate : Templates)
+	{
+		AllocatedSize += CurrentTemplate.TileSubMaps.GetAllocatedSize() + CurrentTemplate.TileActorSlotMaps.GetAllocatedSize() + CurrentTemplate.TileSize.GetAllocatedSize() + CurrentTemplate.TileAccessPoints.GetAllocatedSize();
+
+		for (const TPair<FIntVector, FTileAccessData>& CurrentAccessPoint : CurrentTemplate.TileAccessPoints)
+		{
+			AllocatedSize += CurrentAccessPoint.Value.AccessibleDirections.GetAllocatedSize();
+		}
+	}
+
+	return AllocatedSize;
+}
+
+void FGeneratedLevelData::AddTile(const FIntVector& Coordinate, const FTileData& TileData)
+{
+	if (!TileTemplates.IsValid()) { TileTemplates = MakeShared<FTileTemplateRegistry>(); }
+
+	const uint16 TemplateId = TileTemplates->FindOrAddTemplate(TileData);
+	if (TemplateId == InvalidTileTemplateId) { return; }
+
+	LevelTileData.Add(Coordinate, TileTemplates->MakeInstance(TileData, TemplateId));
+
+	FreeCells.Occupy(Coordinate);
+	Occupancy.SetOccupied(Coordinate);
+	OccupancyTree.SetOccupied(Coordinate);
+
+	if (TileGrid.IsInitialized()) { TileGrid.FindOrAddCell(Coordinate).TileHandle = FLevelGridCell::MakeTileHandle(LevelTileData.FindId(Coordinate).AsInteger()); }
+}
+
+void FGeneratedLevelData::AddSection(const FIntVector& Coordinate, const FTileSectionData& SectionData)
+{
+	LevelSectionData.Add(Coordinate, SectionData);
+	FreeCells.Occupy(Coordinate);
+	Occupancy.SetOccupied(Coordinate);
+	OccupancyTree.SetOccupied(Coordinate);
+
+	if (TileGrid.IsInitialized()) { TileGrid.FindOrAddCell(Coordinate).TileHandle = FLevelGridCell::MakeSectionHandle(LevelSectionData.FindId(Coordinate).AsInteger()); }
+}
+
+void FGeneratedLevelData::AddPath(const FIntVector& Coordinate, const FCorridorTileData& PathData)
+{
+	LevelPathData.Add(Coordinate, PathData).UpdateAdjacencyCache();
+
+	if (TileGrid.IsInitialized()) { TileGrid.FindOrAddCell(Coordinate).PathHandle = LevelPathData.FindId(Coordinate).AsInteger(); }
+}
+
+void FGeneratedLevelData::BuildTileGrid(const FIntVector& GridSize, ETileStorageType StorageType)
+{
+	TileGrid.Initialize(GridSize, StorageType);
+
+	// The handles are the element indices of the maps, which stay the same until an element is removed
+	for (TMap<FIntVector, FTileInstanceData>::TConstIterator It = LevelTileData.CreateConstIterator(); It; ++It)
+	{
+		TileGrid.FindOrAddCell(It.Key()).TileHandle = FLevelGridCell::MakeTileHandle(It.GetId().AsInteger());
+	}
+
+	for (TMap<FIntVector, FTileSectionData>::TConstIterator It = LevelSectionData.CreateConstIterator(); It; ++It)
+	{
+		TileGrid.FindOrAddCell(It.Key()).TileHandle = FLevelGridCell::MakeSectionHandle(It.GetId().AsInteger());
+	}
+
+	for (TMap<FIntVector, FCorridorTileData>::TConstIterator It = LevelPathData.CreateConstIterator(); It; ++It)
+	{
+		TileGrid.FindOrAddCell(It.Key()).PathHandle = It.GetId().AsInteger();
+	}
+}
+
+const FTileInstanceData* FGeneratedLevelData::FindTile(const FIntVector& Coordinate) const
+{
+	if (!TileGrid.IsInitialized()) { return LevelTileData.Find(Coordinate); }
+
+	const FLevelGridCell* Cell = TileGrid.FindCell(Coordinate);
+	return Cell && Cell->HasTile() ? &LevelTileData.Get(FSetElementId::FromInteger(Cell->GetElementIndex())).Value : nullptr;
+}
+
+const FTileSectionData* FGeneratedLevelData::FindSection(const FIntVector& Coordinate) const
+{
+	if (!TileGrid.IsInitialized()) { return LevelSectionData.Find(Coordinate); }
+
+	const FLevelGridCell* Cell = TileGrid.FindCell(Coordinate);
+	return Cell && Cell->HasSection() ? &LevelSectionData.Get(FSetElementId::FromInteger(Cell->GetElementIndex())).Value : nullptr;
+}
+
+const FCorridorTileData* FGeneratedLevelData::FindPath(const FIntVector& Coordinate) const
+{
+	if (!TileGrid.IsInitialized()) { return LevelPathData.Find(Coordinate); }
+
+	const FLevelGridCell* Cell = TileGrid.FindCell(Coordinate);
+	return Cell && Cell->PathHandle != INDEX_NONE ? &LevelPathData.Get(FSetElementId::FromInteger(Cell->PathHandle)).Value : nullptr;
+}
+
+SIZE_T FGeneratedLevelData::GetAllocatedSize() const
+{
+	SIZE_T AllocatedSize = LevelTileData.GetAllocatedSize() + LevelSectionData.GetAllocatedSize() + LevelPathData.GetAllocatedSize();
+
+	for (const TPair<FIntVector, FTileInstanceData>& CurrentTile : LevelTileData)
+	{
+		AllocatedSize += CurrentTile.Value.UsedDirections.GetAllocatedSize();
+	}
+
+	if (TileTemplates.IsValid()) { AllocatedSize += TileTemplates->GetAllocatedSize(); }
+
+	for (const TPair<FIntVector, FCorridorTileData>& CurrentPath : LevelPathData)
+	{
+		AllocatedSize += CurrentPath.Value.AdjacentAccessPoints.GetAllocatedSize() + CurrentPath.Value.SpecialPathTileSize.GetAllocatedSize();
+	}
+
+	AllocatedSize += MinimumSpanningTree.GetAllocatedSize() + RoomMinimumSpanningTree.GetAllocatedSize();
+
+	return AllocatedSize;
+}
+
+void FGeneratedLevelData::ReleaseGenerationData()
+{
+	FreeCells = FFreeCellSet();
+	Occupancy = FOccupancyBitset();
+	OccupancyTree = FOccupancyFenwickTree();
+	TileGrid = FLevelTileIndex();
+}
+
+bool FGeneratedLevelData::GetTileData(const FIntVector& Coordinate, FTileData& OutTileData) const
+{
+	if (const FTileInstanceData* TileInstance = FindTile(Coordinate))
+	{
+		OutTileData = FTileData();
+		if (TileTemplates.IsValid()) { TileTemplates->ExpandInstance(*TileInstance, OutTileData); }
+
+		return true;
+	}
+
+	const FTileSectionData* SectionData = FindSection(Coordinate);
+	if (!SectionData) { return false; }
+
+	OutTileData = FTileData();
+	OutTileData.TileType = SectionData->TileType;
+	OutTileData.ParentRoomCoordinate = SectionData->ParentCoordinate;
+	OutTileData.TileSize.Add({ 0,0,0 });
+
+	if (const FTileInstanceData* ParentTileInstance = FindTile(SectionData->ParentCoordinate))
+	{
+		OutTileData.TileRotation = ParentTileInstance->TileRotation;
+
+		const FTileTemplate* ParentTemplate = GetTileTemplate(*ParentTileInstance);
+		const FTileAccessData* AccessData = ParentTemplate ? ParentTemplate->TileAccessPoints.Find(SectionData->LocalOffset) : nullptr;
+
+		if (AccessData)
+		{
+			FTileAccessData& SectionAccessData = OutTileData.TileAccessPoints.Add(FIntVector(0, 0, 0), *AccessData);
+
+			// The template's access points have no directions in use, they are kept by the parent tile
+			const int32 AccessPointIndex = ParentTemplate->GetAccessPointIndex(SectionData->LocalOffset);
+			if (ParentTileInstance->UsedDirections.IsValidIndex(AccessPointIndex))
+			{
+				SectionAccessData.InUseMask = ParentTileInstance->UsedDirections[AccessPointIndex];
+				SectionAccessData.DirectionsInUse = SectionAccessData.InUseMask.ToSet();
+			}
+		}
+	}
+
+	return true;
+}
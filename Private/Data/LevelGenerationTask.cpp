@@ -0,0 +1,185 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/LevelGenerationTask.h"
+#include "Data/FunctionLibraries/LevelGenerationLibrary.h"
+#include "Async/Async.h"
+
+void FLevelGenerationTiles::Add(const FIntVector& Coordinate, const FTileData& TileData)
+{
+	const uint16 TemplateId = TileTemplates->FindOrAddTemplate(TileData);
+	if (TemplateId == InvalidTileTemplateId) { return; }
+
+	Tiles.Add(Coordinate, TileTemplates->MakeInstance(TileData, TemplateId));
+}
+
+FLevelGenerationTask::FLevelGenerationTask(const FLevelGenerationSettings& InLevelGenerationSettings)
+	: LevelGenerationSettings(InLevelGenerationSettings)
+	, Progress(MakeShared<FLevelGenerationProgress>())
+{
+	CollectReferencedObjects();
+}
+
+void FLevelGenerationTask::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObjects(ReferencedObjects);
+}
+
+void FLevelGenerationTask::Start(FOnLevelGenerationTaskComplete InOnComplete)
+{
+	check(IsInGameThread());
+
+	OnComplete = MoveTemp(InOnComplete);
+
+	// Step 1. Load and compile everything the generation reads while still on the game thread.
+	ULevelGenerationLibrary::PrepareLevelGeneration(LevelGenerationSettings, GeneratedLevelData);
+	GeneratedLevelData.Progress = Progress;
+
+	// The special path data has just been loaded
+	CollectReferencedObjects();
+
+	// Step 2. Copy the rooms and every new corridor out as they are added, the worker thread keeps the task alive while they are called.
+	if (OnRoomsReady.IsBound())
+	{
+		Progress->OnRoomsGenerated = [this](FGeneratedLevelData& InGeneratedLevelData)
+			{
+				if (!InGeneratedLevelData.TileTemplates.IsValid()) { return; }
+
+				// The rooms keep their template ids, the registry is copied since the worker thread keeps adding templates to it
+				FLevelGenerationTiles RoomTiles;
+				RoomTiles.TileTemplates = MakeShared<FTileTemplateRegistry>(*InGeneratedLevelData.TileTemplates);
+
+				for (const TPair<FIntVector, FTileInstanceData>& CurrentTile : InGeneratedLevelData.LevelTileData)
+				{
+					const FTileTemplate* Template = InGeneratedLevelData.GetTileTemplate(CurrentTile.Value);
+					if (Template && Template->TileType != ETileType::Room_Section) { RoomTiles.Tiles.Add(CurrentTile.Key, CurrentTile.Value); }
+				}
+
+				SendTilesToGameThread(OnRoomsReady, MoveTemp(RoomTiles));
+			};
+	}
+
+	if (OnCorridorsReady.IsBound())
+	{
+		Progress->OnCorridorCommitted = [this](FGeneratedLevelData& InGeneratedLevelData, const TArray<FIntVector>& Coordinates)
+			{
+				FLevelGenerationTiles CorridorTiles;
+
+				for (const FIntVector& CurrentCoordinate : Coordinates)
+				{
+					// Special corridors are only turned into tiles once every path is known
+					const FCorridorTileData* CorridorTileData = InGeneratedLevelData.FindPath(CurrentCoordinate);
+					if (!CorridorTileData || CorridorTileData->TileType != ETileType::Corridor) { continue; }
+
+					CorridorTiles.Add(CurrentCoordinate, ULevelGenerationLibrary::GetCorridorTileDataAtCoordinate(CurrentCoordinate, *CorridorTileData, InGeneratedLevelData));
+				}
+
+				if (!CorridorTiles.IsEmpty()) { SendTilesToGameThread(OnCorridorsReady, MoveTemp(CorridorTiles)); }
+			};
+	}
+
+	// Step 3. Generate the rooms and corridors on the thread pool, the task keeps itself alive until it is done.
+	TSharedRef<FLevelGenerationTask> LevelGenerationTask = AsShared();
+
+	// Platforms without the background thread pool use the normal one
+	FQueuedThreadPool* ThreadPool = bUseBackgroundThreadPool && GBackgroundPriorityThreadPool ? GBackgroundPriorityThreadPool : GThreadPool;
+
+	Future = AsyncPool(*ThreadPool, [LevelGenerationTask]() mutable
+		{
+			// The world is never touched off the game thread
+			const bool bCompleted = ULevelGenerationLibrary::RunLevelGeneration(LevelGenerationTask->LevelGenerationSettings, LevelGenerationTask->GeneratedLevelData);
+
+			// Step 4. Hand the level back to the game thread, along with the worker's reference so the task is always destroyed there.
+			AsyncTask(ENamedThreads::GameThread, [LevelGenerationTask = MoveTemp(LevelGenerationTask)]() { LevelGenerationTask->Finish(); });
+
+			return bCompleted;
+		}, nullptr, WorkPriority);
+}
+
+void FLevelGenerationTask::SetOnTilesReady(FOnLevelGenerationTilesReady InOnRoomsReady, FOnLevelGenerationTilesReady InOnCorridorsReady)
+{
+	check(!Future.IsValid());
+
+	OnRoomsReady = MoveTemp(InOnRoomsReady);
+	OnCorridorsReady = MoveTemp(InOnCorridorsReady);
+}
+
+void FLevelGenerationTask::SetWorkPriority(EQueuedWorkPriority InWorkPriority)
+{
+	check(!Future.IsValid());
+
+	WorkPriority = InWorkPriority;
+}
+
+void FLevelGenerationTask::SetUseBackgroundThreadPool(bool bInUseBackgroundThreadPool)
+{
+	check(!Future.IsValid());
+
+	bUseBackgroundThreadPool = bInUseBackgroundThreadPool;
+}
+
+FGeneratedLevelData FLevelGenerationTask::TakeGeneratedLevelData()
+{
+	check(IsCompleted());
+
+	FGeneratedLevelData OutGeneratedLevelData = MoveTemp(GeneratedLevelData);
+
+	// The footprints are keyed by the rooms in the task's copy of the settings and are only needed while generating
+	OutGeneratedLevelData.CompiledRoomFootprints.Reset();
+	OutGeneratedLevelData.Progress.Reset();
+
+	return OutGeneratedLevelData;
+}
+
+void FLevelGenerationTask::Finish()
+{
+	bIsDone = true;
+
+	UE_LOG(LogTemp, Warning, TEXT("FLevelGenerationTask::Finish Level generation %s!"), IsCompleted() ? TEXT("finished") : TEXT("cancelled"));
+
+	OnComplete.ExecuteIfBound(AsShared());
+	OnComplete.Unbind();
+}
+
+void FLevelGenerationTask::CollectReferencedObjects()
+{
+	check(IsInGameThread());
+
+	ReferencedObjects.Reset();
+
+	for (const TPair<ECorridorType, UDataTable*>& CurrentTable : LevelGenerationSettings.CorridorLevelDataTableList)
+	{
+		if (CurrentTable.Value) { ReferencedObjects.Add(CurrentTable.Value); }
+	}
+
+	for (const TPair<ESpecialPathType, UDataTable*>& CurrentTable : LevelGenerationSettings.SpecialPathLevelDataTableList)
+	{
+		if (CurrentTable.Value) { ReferencedObjects.Add(CurrentTable.Value); }
+	}
+
+	for (const TPair<UDataTable*, double>& CurrentTable : LevelGenerationSettings.BasicRoomList)
+	{
+		if (CurrentTable.Key) { ReferencedObjects.Add(CurrentTable.Key); }
+	}
+
+	for (const TPair<FName, FKeyTileData>& CurrentKeyRoom : LevelGenerationSettings.KeyRooms)
+	{
+		if (CurrentKeyRoom.Value.KeyRoomList) { ReferencedObjects.Add(CurrentKeyRoom.Value.KeyRoomList); }
+	}
+
+	for (const TPair<FName, FSpecialTileData>& CurrentSpecialRoom : LevelGenerationSettings.SpecialRooms)
+	{
+		if (CurrentSpecialRoom.Value.SpecialRoomList) { ReferencedObjects.Add(CurrentSpecialRoom.Value.SpecialRoomList); }
+	}
+
+	if (UObject* SpecialPathData = LevelGenerationSettings.SpecialPathData.Get()) { ReferencedObjects.Add(SpecialPathData); }
+}
+
+void FLevelGenerationTask::SendTilesToGameThread(const FOnLevelGenerationTilesReady& TilesReady, FLevelGenerationTiles&& Tiles)
+{
+	AsyncTask(ENamedThreads::GameThread, [LevelGenerationTask = AsShared(), &TilesReady, Tiles = MoveTemp(Tiles)]()
+		{
+			// Tiles sent after the task was cancelled are dropped
+			if (!LevelGenerationTask->Progress->IsCancelled()) { TilesReady.ExecuteIfBound(LevelGenerationTask, Tiles); }
+		});
+}
@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/LevelGenerationTrace.h"
+#include "Data/LevelGenerationData.h"
+
+UE_TRACE_CHANNEL_DEFINE(LevelGenerationChannel);
+
+UE_TRACE_EVENT_BEGIN(LevelGeneration, GenerationStart)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int32, Seed)
+	UE_TRACE_EVENT_FIELD(int32, GridSizeX)
+	UE_TRACE_EVENT_FIELD(int32, GridSizeY)
+	UE_TRACE_EVENT_FIELD(int32, GridSizeZ)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(LevelGeneration, RoomPlacement)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int32, Seed)
+	UE_TRACE_EVENT_FIELD(uint8, RoomType)
+	UE_TRACE_EVENT_FIELD(int32, PlacementsTested)
+	UE_TRACE_EVENT_FIELD(bool, bPlaced)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(LevelGeneration, CorridorEdge)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int32, Seed)
+	UE_TRACE_EVENT_FIELD(int32, EdgeIndex)
+	UE_TRACE_EVENT_FIELD(int32, OriginX)
+	UE_TRACE_EVENT_FIELD(int32, OriginY)
+	UE_TRACE_EVENT_FIELD(int32, OriginZ)
+	UE_TRACE_EVENT_FIELD(int32, DestinationX)
+	UE_TRACE_EVENT_FIELD(int32, DestinationY)
+	UE_TRACE_EVENT_FIELD(int32, DestinationZ)
+	UE_TRACE_EVENT_FIELD(int32, PathExpansions)
+	UE_TRACE_EVENT_FIELD(int32, AccessPointsTried)
+	UE_TRACE_EVENT_FIELD(bool, bPathFound)
+UE_TRACE_EVENT_END()
+
+bool FLevelGenerationTrace::IsEnabled()
+{
+	return UE_TRACE_CHANNELEXPR_IS_ENABLED(LevelGenerationChannel);
+}
+
+void FLevelGenerationTrace::OutputGenerationStart(int32 Seed, const FIntVector& GridSize)
+{
+	if (!IsEnabled()) { return; }
+
+	UE_TRACE_LOG(LevelGeneration, GenerationStart, LevelGenerationChannel)
+		<< GenerationStart.Cycle(FPlatformTime::Cycles64())
+		<< GenerationStart.Seed(Seed)
+		<< GenerationStart.GridSizeX(GridSize.X)
+		<< GenerationStart.GridSizeY(GridSize.Y)
+		<< GenerationStart.GridSizeZ(GridSize.Z);
+
+	TRACE_BOOKMARK(TEXT("Level Generation Seed %d"), Seed);
+}
+
+void FLevelGenerationTrace::OutputRoomPlacement(int32 Seed, ETileType RoomType, int32 PlacementsTested, bool bPlaced)
+{
+	if (!IsEnabled()) { return; }
+
+	UE_TRACE_LOG(LevelGeneration, RoomPlacement, LevelGenerationChannel)
+		<< RoomPlacement.Cycle(FPlatformTime::Cycles64())
+		<< RoomPlacement.Seed(Seed)
+		<< RoomPlacement.RoomType((uint8)RoomType)
+		<< RoomPlacement.PlacementsTested(PlacementsTested)
+		<< RoomPlacement.bPlaced(bPlaced);
+}
+
+void FLevelGenerationTrace::OutputCorridorEdge(int32 Seed, int32 EdgeIndex, const FIntVector& Origin, const FIntVector& Destination, int32 PathExpansions, int32 AccessPointsTried, bool bPathFound)
+{
+	if (!IsEnabled()) { return; }
+
+	UE_TRACE_LOG(LevelGeneration, CorridorEdge, LevelGenerationChannel)
+		<< CorridorEdge.Cycle(FPlatformTime::Cycles64())
+		<< CorridorEdge.Seed(Seed)
+		<< CorridorEdge.EdgeIndex(EdgeIndex)
+		<< CorridorEdge.OriginX(Origin.X)
+		<< CorridorEdge.OriginY(Origin.Y)
+		<< CorridorEdge.OriginZ(Origin.Z)
+		<< CorridorEdge.DestinationX(Destination.X)
+		<< CorridorEdge.DestinationY(Destination.Y)
+		<< CorridorEdge.DestinationZ(Destination.Z)
+		<< CorridorEdge.PathExpansions(PathExpansions)
+		<< CorridorEdge.AccessPointsTried(AccessPointsTried)
+		<< CorridorEdge.bPathFound(bPathFound);
+}
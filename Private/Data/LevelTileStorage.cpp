@@ -0,0 +1,216 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/LevelTileStorage.h"
+
+void FChunkedTileGrid::Initialize(const FIntVector& InGridSize)
+{
+	GridSize = InGridSize;
+	ChunkCount = FIntVector(
+		FMath::DivideAndRoundUp(FMath::Max(GridSize.X, 0), ChunkSize),
+		FMath::DivideAndRoundUp(FMath::Max(GridSize.Y, 0), ChunkSize),
+		FMath::DivideAndRoundUp(FMath::Max(GridSize.Z, 0), ChunkSize));
+
+	ChunkSlots.Init(INDEX_NONE, ChunkCount.X * ChunkCount.Y * ChunkCount.Z);
+	ChunkOrigins.Reset();
+	Cells.Reset();
+	OverflowCells.Reset();
+
+	bIsInitialized = true;
+}
+
+const FLevelGridCell* FChunkedTileGrid::FindCell(const FIntVector& Coordinate) const
+{
+	const int32 ChunkSlot = GetChunkSlot(Coordinate);
+	if (ChunkSlot == INDEX_NONE) { return OverflowCells.Find(Coordinate); }
+
+	const int32 ChunkIndex = ChunkSlots[ChunkSlot];
+	if (ChunkIndex == INDEX_NONE) { return nullptr; }
+
+	return &Cells[ChunkIndex * CellsPerChunk + GetLocalMortonIndex(Coordinate)];
+}
+
+FLevelGridCell& FChunkedTileGrid::FindOrAddCell(const FIntVector& Coordinate)
+{
+	const int32 ChunkSlot = GetChunkSlot(Coordinate);
+	if (ChunkSlot == INDEX_NONE) { return OverflowCells.FindOrAdd(Coordinate); }
+
+	int32& ChunkIndex = ChunkSlots[ChunkSlot];
+
+	// Allocate the chunk the first time one of its cells is used
+	if (ChunkIndex == INDEX_NONE)
+	{
+		ChunkIndex = ChunkOrigins.Add(FIntVector(Coordinate.X & ~(ChunkSize - 1), Coordinate.Y & ~(ChunkSize - 1), Coordinate.Z & ~(ChunkSize - 1)));
+		Cells.AddDefaulted(CellsPerChunk);
+	}
+
+	return Cells[ChunkIndex * CellsPerChunk + GetLocalMortonIndex(Coordinate)];
+}
+
+int32 FChunkedTileGrid::GetChunkSlot(const FIntVector& Coordinate) const
+{
+	if (Coordinate.X < 0 || Coordinate.X >= GridSize.X ||
+		Coordinate.Y < 0 || Coordinate.Y >= GridSize.Y ||
+		Coordinate.Z < 0 || Coordinate.Z >= GridSize.Z)
+	{
+		return INDEX_NONE;
+	}
+
+	return ((Coordinate.Z >> ChunkBits) * ChunkCount.Y + (Coordinate.Y >> ChunkBits)) * ChunkCount.X + (Coordinate.X >> ChunkBits);
+}
+
+int32 FChunkedTileGrid::GetLocalMortonIndex(const FIntVector& Coordinate)
+{
+	int32 MortonIndex = 0;
+
+	// Interleave the bits of each axis as ZYX ZYX ZYX
+	for (int32 Bit = 0; Bit < ChunkBits; Bit++)
+	{
+		MortonIndex |= ((Coordinate.X >> Bit) & 1) << (Bit * 3);
+		MortonIndex |= ((Coordinate.Y >> Bit) & 1) << (Bit * 3 + 1);
+		MortonIndex |= ((Coordinate.Z >> Bit) & 1) << (Bit * 3 + 2);
+	}
+
+	return MortonIndex;
+}
+
+FIntVector FChunkedTileGrid::GetLocalCoordinate(int32 MortonIndex)
+{
+	FIntVector LocalCoordinate = FIntVector::ZeroValue;
+
+	for (int32 Bit = 0; Bit < ChunkBits; Bit++)
+	{
+		LocalCoordinate.X |= ((MortonIndex >> (Bit * 3)) & 1) << Bit;
+		LocalCoordinate.Y |= ((MortonIndex >> (Bit * 3 + 1)) & 1) << Bit;
+		LocalCoordinate.Z |= ((MortonIndex >> (Bit * 3 + 2)) & 1) << Bit;
+	}
+
+	return LocalCoordinate;
+}
+
+// Spreads the lowest 21 bits of the value so there are two zero bits between each of them.
+static uint64 SpreadMortonBits(uint64 Value)
+{
+	Value &= 0x1fffff;
+	Value = (Value | Value << 32) & 0x1f00000000ffff;
+	Value = (Value | Value << 16) & 0x1f0000ff0000ff;
+	Value = (Value | Value << 8) & 0x100f00f00f00f00f;
+	Value = (Value | Value << 4) & 0x10c30c30c30c30c3;
+	Value = (Value | Value << 2) & 0x1249249249249249;
+	return Value;
+}
+
+// Gathers every third bit of the value back into the lowest 21 bits.
+static uint64 CompactMortonBits(uint64 Value)
+{
+	Value &= 0x1249249249249249;
+	Value = (Value ^ (Value >> 2)) & 0x10c30c30c30c30c3;
+	Value = (Value ^ (Value >> 4)) & 0x100f00f00f00f00f;
+	Value = (Value ^ (Value >> 8)) & 0x1f0000ff0000ff;
+	Value = (Value ^ (Value >> 16)) & 0x1f00000000ffff;
+	Value = (Value ^ (Value >> 32)) & 0x1fffff;
+	return Value;
+}
+
+// Offset added to each axis so negative coordinates have a Morton code.
+static constexpr int32 MortonAxisBias = 1 << 20;
+
+void FMortonTileHash::Initialize(int32 ExpectedCells)
+{
+	// Keep the table at most half full
+	const int32 SlotCount = FMath::RoundUpToPowerOfTwo(FMath::Max(ExpectedCells * 2, 64));
+
+	Keys.Init(EmptyKey, SlotCount);
+	Values.Init(FLevelGridCell(), SlotCount);
+	CellCount = 0;
+}
+
+const FLevelGridCell* FMortonTileHash::FindCell(const FIntVector& Coordinate) const
+{
+	if (Keys.IsEmpty()) { return nullptr; }
+
+	const int32 Slot = FindSlot(GetMortonCode(Coordinate));
+	return Keys[Slot] != EmptyKey ? &Values[Slot] : nullptr;
+}
+
+FLevelGridCell& FMortonTileHash::FindOrAddCell(const FIntVector& Coordinate)
+{
+	if ((CellCount + 1) * 2 > Keys.Num()) { Grow(); }
+
+	const uint64 MortonCode = GetMortonCode(Coordinate);
+	const int32 Slot = FindSlot(MortonCode);
+
+	if (Keys[Slot] == EmptyKey)
+	{
+		Keys[Slot] = MortonCode;
+		CellCount++;
+	}
+
+	return Values[Slot];
+}
+
+uint64 FMortonTileHash::GetMortonCode(const FIntVector& Coordinate)
+{
+	return SpreadMortonBits(uint64(Coordinate.X + MortonAxisBias)) | (SpreadMortonBits(uint64(Coordinate.Y + MortonAxisBias)) << 1) | (SpreadMortonBits(uint64(Coordinate.Z + MortonAxisBias)) << 2);
+}
+
+FIntVector FMortonTileHash::GetCoordinate(uint64 MortonCode)
+{
+	return FIntVector(
+		int32(CompactMortonBits(MortonCode)) - MortonAxisBias,
+		int32(CompactMortonBits(MortonCode >> 1)) - MortonAxisBias,
+		int32(CompactMortonBits(MortonCode >> 2)) - MortonAxisBias);
+}
+
+int32 FMortonTileHash::FindSlot(uint64 MortonCode) const
+{
+	const uint64 SlotMask = uint64(Keys.Num() - 1);
+
+	// Fold the high bits into the low bits, which are kept so neighbours share nearby slots
+	int32 Slot = int32((MortonCode ^ (MortonCode >> 21) ^ (MortonCode >> 42)) & SlotMask);
+
+	// Linear probing, the table is never full
+	while (Keys[Slot] != EmptyKey && Keys[Slot] != MortonCode)
+	{
+		Slot = int32((Slot + 1) & SlotMask);
+	}
+
+	return Slot;
+}
+
+void FMortonTileHash::Grow()
+{
+	TArray<uint64> OldKeys = MoveTemp(Keys);
+	TArray<FLevelGridCell> OldValues = MoveTemp(Values);
+
+	Initialize(FMath::Max(OldKeys.Num(), 32));
+
+	for (int32 Slot = 0; Slot < OldKeys.Num(); Slot++)
+	{
+		if (OldKeys[Slot] == EmptyKey) { continue; }
+
+		const int32 NewSlot = FindSlot(OldKeys[Slot]);
+		Keys[NewSlot] = OldKeys[Slot];
+		Values[NewSlot] = OldValues[Slot];
+		CellCount++;
+	}
+}
+
+void FLevelTileIndex::Initialize(const FIntVector& InGridSize, ETileStorageType InStorageType)
+{
+	StorageType = InStorageType;
+
+	// Only the chosen container holds any memory
+	if (StorageType == ETileStorageType::MortonHash)
+	{
+		ChunkedGrid = FChunkedTileGrid();
+		MortonHash.Initialize();
+	}
+	else
+	{
+		MortonHash = FMortonTileHash();
+		ChunkedGrid.Initialize(InGridSize);
+	}
+
+	bIsInitialized = true;
+}
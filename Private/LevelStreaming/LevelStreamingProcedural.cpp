@@ -54,8 +54,21 @@ void ULevelStreamingProcedural::OnLevelLoadedChanged(ULevel* Level)
 
 	OnPlayerSpawnRoomLoaded.Broadcast(this, Level);
 	OnProceduralLevelLoaded.Broadcast(this);
-	OnDoorSlotLevelLevelLoaded.Broadcast(this, Level, LevelTileData);
+	// Only expand the tile when something needs it
+	if (OnDoorSlotLevelLevelLoaded.IsBound()) { OnDoorSlotLevelLevelLoaded.Broadcast(this, Level, GetLevelTileData()); }
 	OnElevatorBottomLoaded.Broadcast(this, Level, ElevatorBottomInfo);
 	OnElevatorTopLoaded.Broadcast(this, Level, ElevatorTopInfo);
 
 }
+
+FTileData ULevelStreamingProcedural::GetLevelTileData() const
+{
+	FTileData LevelTileData;
+
+	if (!TileTemplates.IsValid() || !TileTemplates->ExpandInstance(LevelTileInstance, LevelTileData))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ULevelStreamingProcedural::GetLevelTileData %s has no tile template!"), *GetName());
+	}
+
+	return LevelTileData;
+}
@@ -0,0 +1,294 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/LevelPreGenerationSubsystem.h"
+#include "Data/FunctionLibraries/LevelLayoutCacheLibrary.h"
+#include "HAL/FileManager.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+void ULevelPreGenerationSubsystem::Deinitialize()
+{
+	// Wait for the running generation to stop so it never outlives the game instance
+	if (PreGenerationTask.IsValid() && PreGenerationTask->GetFuture().IsValid())
+	{
+		PreGenerationTask->Cancel();
+		PreGenerationTask->GetFuture().Wait();
+	}
+
+	CancelPreGeneration();
+	ClearPreGeneratedLevels();
+
+	Super::Deinitialize();
+}
+
+void ULevelPreGenerationSubsystem::PreGenerateLevels(const FLevelGenerationSettings& LevelGenerationSettings, const TArray<int32>& Seeds)
+{
+	// Levels generated or queued with other settings would never be played
+	if (ULevelLayoutCacheLibrary::GetSettingsHash(MakeSeededSettings(LevelGenerationSettings, 0)) != ULevelLayoutCacheLibrary::GetSettingsHash(MakeSeededSettings(PreGenerationSettings, 0)))
+	{
+		CancelPreGeneration();
+		ClearPreGeneratedLevels();
+		PreGenerationSettings = LevelGenerationSettings;
+	}
+
+	// Levels for seeds the player has moved past would never be played either
+	PendingSeeds.RemoveAll([&Seeds](int32 PendingSeed) { return !Seeds.Contains(PendingSeed); });
+
+	for (int32 i = PreGeneratedLevels.Num() - 1; i >= 0; i--)
+	{
+		if (!Seeds.Contains(PreGeneratedLevels[i].Seed)) { RemovePreGeneratedLevel(i); }
+	}
+
+	if (PreGenerationTask.IsValid() && !Seeds.Contains(PreGenerationTask->GetLevelGenerationSettings().LevelUserSeed))
+	{
+		PreGenerationTask->Cancel();
+		PreGenerationTask.Reset();
+	}
+
+	for (const int32 CurrentSeed : Seeds)
+	{
+		if (PendingSeeds.Contains(CurrentSeed) || IsLevelPreGenerated(CurrentSeed)) { continue; }
+
+		// A cached level is loaded almost as quickly as one kept in memory
+		const FLevelGenerationSettings SeededSettings = MakeSeededSettings(PreGenerationSettings, CurrentSeed);
+		if (SeededSettings.bUseLayoutCache && IFileManager::Get().FileExists(*ULevelLayoutCacheLibrary::GetCacheFilePath(SeededSettings))) { continue; }
+
+		PendingSeeds.Add(CurrentSeed);
+	}
+
+	StartNextPreGeneration();
+}
+
+void ULevelPreGenerationSubsystem::PreGenerateNextLevels(const FLevelGenerationSettings& LevelGenerationSettings)
+{
+	if (!LevelGenerationSettings.bUsePlayerSeed || LevelGenerationSettings.PreGeneratedLevelCount <= 0) { return; }
+
+	TArray<int32> Seeds;
+	for (int32 i = 1; i <= LevelGenerationSettings.PreGeneratedLevelCount; i++)
+	{
+		Seeds.Add(LevelGenerationSettings.LevelUserSeed + i);
+	}
+
+	PreGenerateLevels(LevelGenerationSettings, Seeds);
+}
+
+bool ULevelPreGenerationSubsystem::TakePreGeneratedLevel(const FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData)
+{
+	if (!LevelGenerationSettings.bUsePlayerSeed || PreGeneratedLevels.IsEmpty()) { return false; }
+
+	const uint32 SettingsHash = ULevelLayoutCacheLibrary::GetSettingsHash(LevelGenerationSettings);
+
+	const int32 LevelIndex = PreGeneratedLevels.IndexOfByPredicate([&](const FPreGeneratedLevel& CurrentLevel) { return CurrentLevel.Seed == LevelGenerationSettings.LevelUserSeed && CurrentLevel.SettingsHash == SettingsHash; });
+	if (LevelIndex == INDEX_NONE) { return false; }
+
+	GeneratedLevelData = MoveTemp(PreGeneratedLevels[LevelIndex].GeneratedLevelData);
+	RemovePreGeneratedLevel(LevelIndex);
+
+	// The tile index was released while the level was waiting
+	GeneratedLevelData.BuildTileGrid(LevelGenerationSettings.GridSize, LevelGenerationSettings.TileStorageType);
+
+	UE_LOG(LogTemp, Warning, TEXT("ULevelPreGenerationSubsystem::TakePreGeneratedLevel Level %d was generated in the background!"), LevelGenerationSettings.LevelUserSeed);
+
+	// There is room for the levels that did not fit in the budget
+	StartNextPreGeneration();
+
+	return true;
+}
+
+bool ULevelPreGenerationSubsystem::IsLevelPreGenerated(int32 Seed) const
+{
+	return PreGeneratedLevels.ContainsByPredicate([Seed](const FPreGeneratedLevel& CurrentLevel) { return CurrentLevel.Seed == Seed; });
+}
+
+void ULevelPreGenerationSubsystem::CancelPreGeneration()
+{
+	PendingSeeds.Reset();
+	PendingPrewarmPackages.Reset();
+
+	// The task finishes on its own, its result is ignored once it has been replaced
+	if (PreGenerationTask.IsValid())
+	{
+		PreGenerationTask->Cancel();
+		PreGenerationTask.Reset();
+	}
+}
+
+void ULevelPreGenerationSubsystem::ClearPreGeneratedLevels()
+{
+	PreGeneratedLevels.Reset();
+	PreGeneratedMemory = 0;
+
+	PendingPrewarmPackages.Reset();
+	PrewarmedPackages.Reset();
+	PrewarmedPackageSizes.Reset();
+	PrewarmedMemory = 0;
+}
+
+void ULevelPreGenerationSubsystem::StartNextPreGeneration()
+{
+	if (PreGenerationTask.IsValid() || PendingSeeds.IsEmpty()) { return; }
+
+	// Without the layout cache, levels that do not fit in the budget wait until one is taken
+	if (!PreGenerationSettings.bUseLayoutCache && GetUsedMemory() >= GetMemoryBudget(PreGenerationSettings)) { return; }
+
+	const int32 Seed = PendingSeeds[0];
+	PendingSeeds.RemoveAt(0);
+
+	// Step 1. Generate the level on the lowest priority threads so gameplay threads are scheduled first, it stops promptly if cancelled.
+	PreGenerationTask = MakeShared<FLevelGenerationTask>(MakeSeededSettings(PreGenerationSettings, Seed));
+	PreGenerationTask->SetUseBackgroundThreadPool(true);
+	PreGenerationTask->SetWorkPriority(EQueuedWorkPriority::Lowest);
+	PreGenerationTask->Start(FOnLevelGenerationTaskComplete::CreateUObject(this, &ULevelPreGenerationSubsystem::OnPreGenerationComplete));
+}
+
+void ULevelPreGenerationSubsystem::OnPreGenerationComplete(TSharedRef<FLevelGenerationTask> CompletedTask)
+{
+	// Ignore tasks that were cancelled or replaced
+	if (PreGenerationTask != CompletedTask) { return; }
+
+	PreGenerationTask.Reset();
+
+	if (CompletedTask->IsCompleted())
+	{
+		const FLevelGenerationSettings& SeededSettings = CompletedTask->GetLevelGenerationSettings();
+
+		FPreGeneratedLevel PreGeneratedLevel;
+		PreGeneratedLevel.Seed = SeededSettings.LevelUserSeed;
+		PreGeneratedLevel.SettingsHash = ULevelLayoutCacheLibrary::GetSettingsHash(SeededSettings);
+		PreGeneratedLevel.GeneratedLevelData = CompletedTask->TakeGeneratedLevelData();
+
+		// The grid sized data is only needed while generating and would dwarf the rest of the level
+		PreGeneratedLevel.GeneratedLevelData.ReleaseGenerationData();
+		PreGeneratedLevel.AllocatedSize = PreGeneratedLevel.GeneratedLevelData.GetAllocatedSize();
+
+		// Step 2. Keep the level in memory if it fits in the budget, otherwise write it to the layout cache.
+		if (GetUsedMemory() + PreGeneratedLevel.AllocatedSize <= GetMemoryBudget(SeededSettings))
+		{
+			PrewarmLevelPackages(PreGeneratedLevel);
+
+			PreGeneratedMemory += PreGeneratedLevel.AllocatedSize;
+			PreGeneratedLevels.Add(MoveTemp(PreGeneratedLevel));
+		}
+		else if (SeededSettings.bUseLayoutCache)
+		{
+			ULevelLayoutCacheLibrary::SaveCachedLayout(SeededSettings, PreGeneratedLevel.GeneratedLevelData);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ULevelPreGenerationSubsystem::OnPreGenerationComplete Level %d does not fit in the memory budget and was discarded!"), PreGeneratedLevel.Seed);
+		}
+	}
+
+	// Step 3. Move on to the next queued level.
+	StartNextPreGeneration();
+}
+
+void ULevelPreGenerationSubsystem::PrewarmLevelPackages(FPreGeneratedLevel& PreGeneratedLevel)
+{
+	const FGeneratedLevelData& GeneratedLevelData = PreGeneratedLevel.GeneratedLevelData;
+	TSet<FName>& PackageNames = PreGeneratedLevel.PackageNames;
+
+	for (const TPair<FIntVector, FTileInstanceData>& CurrentTile : GeneratedLevelData.LevelTileData)
+	{
+		const FTileTemplate* CurrentTemplate = GeneratedLevelData.GetTileTemplate(CurrentTile.Value);
+		if (!CurrentTemplate || CurrentTemplate->TileType == ETileType::Room_Section) { continue; }
+
+		PackageNames.Add(FName(CurrentTemplate->TileMap.GetLongPackageName()));
+
+		for (const TSoftObjectPtr<UWorld>& CurrentSubMap : CurrentTemplate->TileSubMaps)
+		{
+			PackageNames.Add(FName(CurrentSubMap.GetLongPackageName()));
+		}
+
+		for (const TPair<EActorSlotType, TSoftObjectPtr<UWorld>>& CurrentActorSlotMap : CurrentTemplate->TileActorSlotMaps)
+		{
+			PackageNames.Add(FName(CurrentActorSlotMap.Value.GetLongPackageName()));
+		}
+	}
+
+	for (const FName& CurrentPackageName : PackageNames)
+	{
+		// Skip maps that are not set, already loaded or already loading
+		if (CurrentPackageName.IsNone() || PendingPrewarmPackages.Contains(CurrentPackageName) || FindPackage(nullptr, *CurrentPackageName.ToString())) { continue; }
+
+		PendingPrewarmPackages.Add(CurrentPackageName);
+		LoadPackageAsync(CurrentPackageName.ToString(), FLoadPackageAsyncDelegate::CreateUObject(this, &ULevelPreGenerationSubsystem::OnPackagePrewarmed), 0, PKG_ContainsMap);
+	}
+}
+
+void ULevelPreGenerationSubsystem::OnPackagePrewarmed(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+{
+	// Packages that finish loading after the pre-generation was cancelled are not kept
+	if (PendingPrewarmPackages.Remove(PackageName) == 0) { return; }
+
+	if (Result != EAsyncLoadingResult::Succeeded || !LoadedPackage) { return; }
+
+	const SIZE_T PackageSize = GetPackageSize(LoadedPackage);
+
+	PrewarmedPackages.Add(LoadedPackage);
+	PrewarmedPackageSizes.Add(PackageName, PackageSize);
+	PrewarmedMemory += PackageSize;
+}
+
+void ULevelPreGenerationSubsystem::RemovePreGeneratedLevel(int32 LevelIndex)
+{
+	PreGeneratedMemory -= PreGeneratedLevels[LevelIndex].AllocatedSize;
+	PreGeneratedLevels.RemoveAt(LevelIndex);
+
+	ReleaseUnusedPackages();
+}
+
+void ULevelPreGenerationSubsystem::ReleaseUnusedPackages()
+{
+	TSet<FName> UsedPackageNames;
+	for (const FPreGeneratedLevel& CurrentLevel : PreGeneratedLevels)
+	{
+		UsedPackageNames.Append(CurrentLevel.PackageNames);
+	}
+
+	// Maps still loading are dropped when they finish
+	for (auto PackageIterator = PendingPrewarmPackages.CreateIterator(); PackageIterator; ++PackageIterator)
+	{
+		if (!UsedPackageNames.Contains(*PackageIterator)) { PackageIterator.RemoveCurrent(); }
+	}
+
+	for (int32 i = PrewarmedPackages.Num() - 1; i >= 0; i--)
+	{
+		const FName PackageName = PrewarmedPackages[i] ? PrewarmedPackages[i]->GetFName() : NAME_None;
+		if (UsedPackageNames.Contains(PackageName)) { continue; }
+
+		SIZE_T PackageSize = 0;
+		PrewarmedPackageSizes.RemoveAndCopyValue(PackageName, PackageSize);
+		PrewarmedMemory -= PackageSize;
+
+		PrewarmedPackages.RemoveAtSwap(i);
+	}
+}
+
+FLevelGenerationSettings ULevelPreGenerationSubsystem::MakeSeededSettings(const FLevelGenerationSettings& LevelGenerationSettings, int32 Seed)
+{
+	FLevelGenerationSettings SeededSettings = LevelGenerationSettings;
+	SeededSettings.bUsePlayerSeed = true;
+	SeededSettings.LevelUserSeed = Seed;
+
+	return SeededSettings;
+}
+
+SIZE_T ULevelPreGenerationSubsystem::GetPackageSize(UPackage* Package)
+{
+	SIZE_T PackageSize = 0;
+
+	ForEachObjectWithPackage(Package, [&PackageSize](UObject* Object)
+		{
+			PackageSize += Object->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+			return true;
+		});
+
+	return PackageSize;
+}
+
+SIZE_T ULevelPreGenerationSubsystem::GetMemoryBudget(const FLevelGenerationSettings& LevelGenerationSettings)
+{
+	return (SIZE_T)(FMath::Max(LevelGenerationSettings.PreGenerationMemoryBudgetMB, 0.f) * 1024.f * 1024.f);
+}
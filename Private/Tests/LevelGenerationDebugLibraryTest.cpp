@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "Components/LineBatchComponent.h"
+#include "Data/FunctionLibraries/LevelGenerationDebugLibrary.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLevelGenerationDebugLibraryBuildDebugLinesTest, "ProjectSciFi.LevelGeneration.DebugLibrary.BuildDebugLines", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLevelGenerationDebugLibraryBuildDebugLinesTest::RunTest(const FString& Parameters)
+{
+	FLevelGenerationSettings LevelGenerationSettings;
+	LevelGenerationSettings.TileSize = 100;
+
+	FGeneratedLevelData GeneratedLevelData;
+	GeneratedLevelData.MinimumSpanningTree.Add(FEdgeInfo(FIntVector(0, 0, 0), FIntVector(2, 0, 0)));
+	GeneratedLevelData.MinimumSpanningTree.Add(FEdgeInfo(FIntVector(2, 0, 0), FIntVector(2, 3, 1)));
+	GeneratedLevelData.DebugData.DiscardedEdges.Add(FEdgeInfo(FIntVector(0, 0, 0), FIntVector(2, 3, 1)));
+
+	FCorridorSearchDebugData CorridorSearch;
+	CorridorSearch.bPathFound = false;
+	CorridorSearch.ExploredNodes.Add(FIntVector(1, 0, 0));
+	GeneratedLevelData.DebugData.CorridorSearches.Add(CorridorSearch);
+
+	FLevelGenerationDebugDrawOptions DrawOptions;
+	DrawOptions.HeightOffset = 50.f;
+
+	// Step 1. Only the MST is drawn by default, one line per edge raised by the height offset
+	TArray<FBatchedLine> Lines;
+	ULevelGenerationDebugLibrary::BuildDebugLines(LevelGenerationSettings, GeneratedLevelData, DrawOptions, Lines);
+
+	if (!TestEqual(TEXT("MST line count"), Lines.Num(), 2)) { return false; }
+
+	TestEqual(TEXT("MST line start"), Lines[0].Start, FVector(0.f, 0.f, 50.f));
+	TestEqual(TEXT("MST line end"), Lines[0].End, FVector(200.f, 0.f, 50.f));
+	TestEqual(TEXT("MST line end above the grid"), Lines[1].End, FVector(200.f, 300.f, 150.f));
+	TestEqual(TEXT("MST line colour"), Lines[0].Color, DrawOptions.MinimumSpanningTreeColour);
+
+	// Step 2. The discarded edges and a cross for each explored node are added after the MST
+	DrawOptions.bDrawDiscardedEdges = true;
+	DrawOptions.bDrawExploredNodes = true;
+
+	Lines.Reset();
+	ULevelGenerationDebugLibrary::BuildDebugLines(LevelGenerationSettings, GeneratedLevelData, DrawOptions, Lines);
+
+	if (!TestEqual(TEXT("Line count with debug data"), Lines.Num(), 5)) { return false; }
+
+	TestEqual(TEXT("Discarded edge colour"), Lines[2].Color, DrawOptions.DiscardedEdgeColour);
+	TestEqual(TEXT("Failed search colour"), Lines[3].Color, DrawOptions.FailedSearchColour);
+	TestEqual(TEXT("Explored node cross centre"), (Lines[3].Start + Lines[3].End) * 0.5, FVector(100.f, 0.f, 50.f));
+
+	// Step 3. Nothing is drawn when every option is disabled
+	DrawOptions.bDrawMinimumSpanningTree = false;
+	DrawOptions.bDrawDiscardedEdges = false;
+	DrawOptions.bDrawExploredNodes = false;
+
+	Lines.Reset();
+	ULevelGenerationDebugLibrary::BuildDebugLines(LevelGenerationSettings, GeneratedLevelData, DrawOptions, Lines);
+
+	TestTrue(TEXT("No lines without any option"), Lines.IsEmpty());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -5,12 +5,14 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Data/FunctionLibraries/LevelGenerationLibrary.h"
+#include "Data/FunctionLibraries/LevelGenerationDebugLibrary.h"
 #include "LevelStreaming/LevelStreamingProcedural.h"
 #include "ProceduralLevelGenerationActor.generated.h"
 
 
 class USpringArmComponent;
 class USceneCaptureComponent2D;
+class ULineBatchComponent;
 class ULevelStreamingProcedural;
 class AActorSlot_Door;
 class AInteractableActor_Base;
@@ -29,6 +31,9 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	// Called when the actor is removed from play, cancels the level generation if it is still running
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
@@ -44,6 +49,26 @@ public:
 	/** Updates LevelGenerationSettings with the latest level generation settings that are selected. */
 	void GetLevelGenerationSettings();
 
+	/** Shows or hides the debug drawing of the level generation without generating the level again. */
+	UFUNCTION(BlueprintCallable, Category = "Procedural Level Generation|Debug")
+	void SetDebugDrawingEnabled(bool bEnabled);
+
+	/** Rebuilds the debug drawing of the level generation from the current DebugDrawOptions. */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Procedural Level Generation|Debug")
+	void RefreshDebugDrawing();
+
+	/** Stops the level generation if the level is still being generated, the level is left ungenerated. */
+	UFUNCTION(BlueprintCallable, Category = "Procedural Level Generation")
+	void CancelLevelGeneration();
+
+	/** Returns how much of the level generation has finished, from 0 to 1. */
+	UFUNCTION(BlueprintPure, Category = "Procedural Level Generation")
+	float GetLevelGenerationProgress() const;
+
+	/** Returns true while the level is being generated off the game thread. */
+	UFUNCTION(BlueprintPure, Category = "Procedural Level Generation")
+	bool IsGeneratingLevel() const { return LevelGenerationTask.IsValid() || LevelGenerationStepState.IsValid(); }
+
 protected:
 
 	/** Called when a LevelStreamingProcedural is loaded. */
@@ -68,6 +93,41 @@ protected:
 
 	/** Preloads every room and corridor before level generation begins. */
 	void PreloadLevels();
+
+	/** Generates the level on a worker thread, loading it from the layout cache instead if it can. */
+	void GenerateLevelAsync();
+
+	/** Starts generating the level a few steps per frame in Tick, loading it from the layout cache instead if it can. */
+	void GenerateLevelTimeSliced();
+
+	/** Runs the time sliced level generation for this frame's budget. */
+	void TickLevelGeneration();
+
+	/** Called on the game thread when the level generation task is done. */
+	void OnLevelGenerationTaskComplete(TSharedRef<FLevelGenerationTask> CompletedTask);
+
+	/** Called on the game thread with rooms or corridors of the level that is still being generated, streams them in. */
+	void OnPipelinedTilesReady(TSharedRef<FLevelGenerationTask> GeneratingTask, const FLevelGenerationTiles& Tiles);
+
+	/** Streams in the map and sublevels of a tile while the level is still generating, replacing the tile already streamed at the coordinate if it has changed. */
+	void StreamPipelinedTile(const FIntVector& Coordinate, FTileInstanceData TileInstance, const TSharedRef<FTileTemplateRegistry>& TileTemplates);
+
+	/// <summary>
+	/// Hands the level instances streamed in for a tile while the level was generating over to the generated tile.
+	/// </summary>
+	/// <param name="Coordinate"> The location of the room/corridor. </param>
+	/// <param name="TileInstance"> The generated tile instance of the room/corridor. </param>
+	/// <returns> False if nothing was streamed for the tile or it was streamed with different maps, the instances are then removed. </returns>
+	bool AdoptPipelinedTile(const FIntVector& Coordinate, FTileInstanceData& TileInstance);
+
+	/** Unloads and removes the level instances streamed in for the coordinate while the level was generating. */
+	void RemovePipelinedTile(const FIntVector& Coordinate);
+
+	/** Unloads and removes every level instance streamed in while the level was generating that has not been handed over to the generated level. */
+	void RemovePipelinedTiles();
+
+	/** Populates the level and sets up its elevators once the level has been generated. */
+	void OnLevelGenerated();
 	
 	/** Instances and loads every room and corridor in the level. */
 	void PopulateLevel();
@@ -100,10 +160,12 @@ protected:
 	/// Creates a procedural level instance of a room/corridor and binds various delegates depending on its tile type.
 	/// </summary>
 	/// <param name="CurrentCoordinate"> The location of the room/corridor. </param>
-	/// <param name="RoomTileData"> The tile data of the room/corridor. </param>
+	/// <param name="RoomTileInstance"> The tile instance of the room/corridor, its level instance is set if MapToInstance is its base map. </param>
+	/// <param name="TileTemplates"> The registry the tile's shared data is read from. </param>
 	/// <param name="MapToInstance"> Reference to the level of the room/corridor. </param>
 	/// <param name="MapSlotType"> The type of the room/corridor.</param>
-	void CreateProceduralLevelInstance(FIntVector CurrentCoordinate, FTileData& RoomTileData, TSoftObjectPtr<UWorld> MapToInstance, EActorSlotType MapSlotType = EActorSlotType::None);
+	/// <returns> The level instance created, or nullptr if it could not be created. </returns>
+	ULevelStreamingProcedural* CreateProceduralLevelInstance(FIntVector CurrentCoordinate, FTileInstanceData& RoomTileInstance, const TSharedPtr<const FTileTemplateRegistry>& TileTemplates, TSoftObjectPtr<UWorld> MapToInstance, EActorSlotType MapSlotType = EActorSlotType::None);
 
 	/** Returns the static mesh component of the newly created minimap mesh. */
 	UStaticMeshComponent* CreateMinimapMesh(UStaticMesh* MinimapMesh, const FString MeshName, const TArray<FName> MeshTags = TArray<FName>());
@@ -126,6 +188,19 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Procedural Level Generation|Settings")
 	FGeneratedLevelData GeneratedLevelData;
 
+	// The task generating the level off the game thread, only valid while it is running.
+	TSharedPtr<FLevelGenerationTask> LevelGenerationTask;
+
+	// The state of the time sliced level generation, only valid while it is running.
+	TUniquePtr<FLevelGenerationStepState> LevelGenerationStepState;
+
+	// The level instances streamed in while the level is still generating, by coordinate. Handed over to the generated tiles once the level is populated.
+	UPROPERTY()
+	TMap<FIntVector, FPipelinedTileInstances> PipelinedTiles;
+
+	// The number of level instances created while pipelining, keeps the names of replaced instances unique.
+	int32 PipelinedInstanceCount = 0;
+
 	// Map of all the levels preloaded for the level generation.
 	TMap<FName, ULevelStreamingDynamic*> LoadedLevelMap;
 
@@ -138,6 +213,9 @@ protected:
 	// Map containing all the blocked access point meshes needed for the minimap 
 	TMap<AActor*, FMinimapInfo_Interactable> MinimapAccessBlockers;
 
+	// Return true once the level has been generated or loaded from the layout cache.
+	bool bLevelGenerated = false;
+
 	// Return true if the level generation has finished and we are waiting on all the levels to finish loading. 
 	bool bLevelWaitingToLoad = false;
 
@@ -163,4 +241,16 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Procedural Level Generation|Minimap")
 	USceneCaptureComponent2D* MinimapOpacityMaskSceneCapture;
 
+	// Draws the debug lines of the level generation.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Procedural Level Generation|Debug")
+	ULineBatchComponent* DebugLineBatcher;
+
+	// The options that determine what the debug drawing displays.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Procedural Level Generation|Debug")
+	FLevelGenerationDebugDrawOptions DebugDrawOptions;
+
+	// Return true if the debug drawing is being displayed.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Procedural Level Generation|Debug")
+	bool bDebugDrawingEnabled = false;
+
 };
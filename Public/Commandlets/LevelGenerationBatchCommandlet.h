@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Data/LevelGenerationData.h"
+#include "LevelGenerationBatchCommandlet.generated.h"
+
+/** The report of a level generated by ULevelGenerationBatchCommandlet. */
+struct FLevelGenerationBatchResult
+{
+
+public:
+
+	// The seed the level was generated from.
+	int32 Seed = 0;
+
+	// True if the whole level was generated.
+	bool bCompleted = false;
+
+	// The time in seconds spent setting up the generation on the game thread.
+	double PrepareTime = 0.0;
+
+	// The time in seconds spent generating the rooms, room graph and corridors.
+	double GenerationTime = 0.0;
+
+	// The statistics recorded during the generation, including the time of each stage.
+	FLevelGenerationStats Stats;
+
+	// The number of rooms placed.
+	int32 RoomCount = 0;
+
+	// The number of rooms that could not be placed.
+	int32 PlacementFailures = 0;
+
+	// The number of placements tested while placing the rooms.
+	int32 PlacementsTested = 0;
+
+	// The number of normal corridor tiles.
+	int32 CorridorCount = 0;
+
+	// The number of special corridor tiles, e.g. stairs and elevators.
+	int32 SpecialCorridorCount = 0;
+
+	// The number of tiles in the level.
+	int32 TileCount = 0;
+
+	/** Returns true if every room was placed and every corridor was built. */
+	bool IsClean() const { return bCompleted && PlacementFailures == 0 && Stats.FailedEdges.IsEmpty(); }
+};
+
+/**
+ * Generates the levels for a range of seeds without a world or level streaming, one level per worker thread, and writes a report of every seed as CSV and JSON.
+ * Used to find the seeds that are slow to generate or fail to place rooms or build corridors.
+ *
+ * UnrealEditor-Cmd <Project> -run=LevelGenerationBatch -Settings=<DataTablePath> -Profile=<RowName> [-FirstSeed=0] [-SeedCount=100] [-Workers=<WorkerThreads>] [-Report=<PathWithoutExtension>] -nullrhi
+ */
+UCLASS()
+class PROJECTSCIFI_API ULevelGenerationBatchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	ULevelGenerationBatchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+
+	/** Builds the report of a generated level. */
+	static FLevelGenerationBatchResult MakeResult(const FLevelGenerationSettings& LevelGenerationSettings, const FGeneratedLevelData& GeneratedLevelData, bool bCompleted);
+
+	/** Writes a row for every seed to a CSV file, returns false if the file could not be written. */
+	static bool WriteCsvReport(const FString& FilePath, const TArray<FLevelGenerationBatchResult>& Results);
+
+	/** Writes an object for every seed to a JSON file, including the edges that failed, returns false if the file could not be written. */
+	static bool WriteJsonReport(const FString& FilePath, const TArray<FLevelGenerationBatchResult>& Results);
+};
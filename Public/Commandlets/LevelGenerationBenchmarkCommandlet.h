@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Data/LevelGenerationData.h"
+#include "LevelGenerationBenchmarkCommandlet.generated.h"
+
+/** A time measured by ULevelGenerationBenchmarkCommandlet. */
+struct FLevelGenerationBenchmarkSample
+{
+
+public:
+
+	// The name of the stage that was timed.
+	FString Stage;
+
+	// The size of each side of the level grid, 0 for stages swept across grid sizes or that do not use the grid.
+	int32 GridSize = 0;
+
+	// The size of the input the stage was timed with, e.g. the number of rooms.
+	int32 InputSize = 0;
+
+	// The best time of the stage over every repeat, in milliseconds.
+	double Milliseconds = 0.0;
+
+};
+
+/** The scaling of a stage fitted from its samples, the time of the stage is about Coefficient * InputSize ^ Exponent. */
+struct FLevelGenerationBenchmarkFit
+{
+
+public:
+
+	// The name of the stage.
+	FString Stage;
+
+	// The size of each side of the level grid the samples were measured in.
+	int32 GridSize = 0;
+
+	// The fitted complexity of the stage, 1 is linear, 2 is quadratic.
+	double Exponent = 0.0;
+
+	// The fitted time of the stage for an input size of 1, in milliseconds.
+	double Coefficient = 0.0;
+
+};
+
+/**
+ * Times each stage of the level generation on synthetic inputs with fixed seeds, sweeping the grid size and the number of rooms, and fits the scaling curve of every stage.
+ * Writes the samples and fitted curves as CSV, and fails if a stage scales or runs worse than a baseline report by more than the tolerances.
+ *
+ * UnrealEditor-Cmd <Project> -run=LevelGenerationBenchmark [-GridSizes=16,32,64,128] [-RoomCounts=10,50,100,500,1000,5000] [-Repeats=3] [-Seed=1337]
+ *		[-Report=<PathWithoutExtension>] [-Baseline=<SamplesCsvPath>] [-ExponentTolerance=0.3] [-TimeTolerance=0.5] [-MinRegressionMs=1] [-MaxExponent=<Exponent>] -nullrhi
+ */
+UCLASS()
+class PROJECTSCIFI_API ULevelGenerationBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	ULevelGenerationBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+
+	/** Returns the settings used by every benchmark for a cubic level grid. */
+	static FLevelGenerationSettings MakeBenchmarkSettings(int32 GridSize, int32 Seed, const TMap<ECorridorType, UDataTable*>& CorridorTables);
+
+	/** Returns distinct random coordinates inside a cubic level grid. */
+	static TArray<FIntVector> MakeRandomPoints(int32 GridSize, int32 PointCount, int32 Seed);
+
+	/** Times placing the rooms one at a time with PlaceRoomInGrid, which picks each coordinate with GetRandomEmptyCoordinate. */
+	static double BenchmarkRoomPlacement(UDataTable* RoomTable, int32 GridSize, int32 RoomCount, int32 Seed, int32 Repeats);
+
+	/** Times the Delaunay Tetrahedralization of the points with BuildTetrahedralization, the tetrahedralization used by the level generation. */
+	static double BenchmarkTetrahedralization(int32 GridSize, const TArray<FIntVector>& Points, int32 Repeats);
+
+	/** Times BuildRoomTetrahedralization on a level with the rooms placed by PlaceRoomInGrid, including gathering the room coordinates and edges. */
+	static double BenchmarkRoomTetrahedralization(UDataTable* RoomTable, int32 GridSize, int32 RoomCount, int32 Seed, int32 Repeats);
+
+	/** Times building the Minimum Spanning Tree of the points from the edges of their tetrahedralization. */
+	static double BenchmarkMinimumSpanningTree(const TArray<FIntVector>& Points, const TArray<FEdgeInfo>& Edges, int32 Repeats);
+
+	/** Times the A* Pathfinding of a corridor across an empty level grid. */
+	static double BenchmarkPathfinding(int32 GridSize, int32 Seed, int32 Repeats);
+
+	/** Times turning random corridor tile data into tile data. */
+	static double BenchmarkCorridorTiles(const TMap<ECorridorType, UDataTable*>& CorridorTables, int32 CorridorCount, int32 Seed, int32 Repeats);
+
+	/** Fits the scaling curve of every stage and grid size with at least two samples, using a least squares line through the log-log samples. */
+	static TArray<FLevelGenerationBenchmarkFit> FitScaling(const TArray<FLevelGenerationBenchmarkSample>& Samples);
+
+	/** Writes the samples to <ReportPath>.csv and the fitted curves to <ReportPath>_Fits.csv, returns false if a file could not be written. */
+	static bool WriteReport(const FString& ReportPath, const TArray<FLevelGenerationBenchmarkSample>& Samples, const TArray<FLevelGenerationBenchmarkFit>& Fits);
+
+	/** Reads the samples of an earlier report, returns false if the file could not be read. */
+	static bool ReadSamples(const FString& FilePath, TArray<FLevelGenerationBenchmarkSample>& OutSamples);
+};
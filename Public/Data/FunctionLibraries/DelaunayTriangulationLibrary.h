@@ -54,6 +54,34 @@ public:
 
 };
 
+/** Structure containing statistics about the point location walks made during a triangulation. */
+USTRUCT(BlueprintType)
+struct FPointLocationStats
+{
+    GENERATED_USTRUCT_BODY()
+
+public:
+
+    /** The number of points that have been located in the triangulation. */
+    UPROPERTY(BlueprintReadOnly, Category = "Triangulation")
+    int32 PointsLocated = 0;
+
+    /** The total number of triangles visited while locating the points. */
+    UPROPERTY(BlueprintReadOnly, Category = "Triangulation")
+    int32 TotalWalkLength = 0;
+
+    /** The highest number of triangles visited while locating a single point. */
+    UPROPERTY(BlueprintReadOnly, Category = "Triangulation")
+    int32 LongestWalkLength = 0;
+
+    /** Returns the average number of triangles visited to locate a point. */
+    float GetAverageWalkLength() const
+    {
+        return PointsLocated > 0 ? (float)TotalWalkLength / (float)PointsLocated : 0.f;
+    }
+
+};
+
 /** Structure representing the verties of a tetrahedron. */
 USTRUCT()
 struct FTetrahedron
@@ -80,6 +108,12 @@ public:
         else { return false; }
     }
 
+    /** Returns true if the vertex is one of the vertices of the tetrahedron. */
+    bool HasVertex(const FVector& InVertex) const
+    {
+        return InVertex == A || InVertex == B || InVertex == C || InVertex == D;
+    }
+
 };
 
 /** Structure that denotes a weighted edge. */
@@ -118,6 +152,43 @@ public:
 
 };
 
+/** The vertices of a tetrahedron face in a consistent order, so both tetrahedra sharing the face have the same key. */
+using FTetrahedronFaceKey = TTuple<FVector, FVector, FVector>;
+
+/** Structure storing a Delaunay Tetrahedralization, allowing points to be inserted and removed without rebuilding it. */
+USTRUCT()
+struct FTetrahedralizationData
+{
+    GENERATED_USTRUCT_BODY()
+
+public:
+
+    /** The size of the grid the tetrahedralization was built for. */
+    FIntVector GridSize = FIntVector::ZeroValue;
+
+    /** The boundary tetrahedron enclosing the level grid. */
+    FTetrahedron BoundaryTetrahedron;
+
+    /** The tetrahedra of the tetrahedralization, including the tetrahedra incident to the boundary tetrahedron. */
+    TArray<FTetrahedron> TetrahedraArray;
+
+    /** The points that have been inserted into the tetrahedralization. */
+    TSet<FIntVector> PointSet;
+
+    /** The number of tetrahedra using each edge between two inserted points, keyed by the ordered edge. */
+    TMap<FEdgeInfo, int32> EdgeReferenceCount;
+
+    /** The indices of the tetrahedra incident to each inserted point, so the tetrahedra around a point are found without scanning every tetrahedron. */
+    TMap<FIntVector, TArray<int32>> PointTetrahedra;
+
+    /** The indices of the one or two tetrahedra sharing each face, so the neighbours of a tetrahedron are found without scanning every tetrahedron. */
+    TMap<FTetrahedronFaceKey, TArray<int32, TInlineAllocator<2>>> FaceTetrahedra;
+
+    /** Returns true if the tetrahedralization has been built. */
+    bool IsValid() const { return !TetrahedraArray.IsEmpty(); }
+
+};
+
 UCLASS()
 class PROJECTSCIFI_API UDelaunayTriangulationLibrary : public UBlueprintFunctionLibrary
 {
@@ -172,6 +243,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Triangulation")
     static TArray<FQuarterEdge> GuibasStolfi(FIntVector GridSize, TArray<FIntVector> PointArray, bool bRemoveBoundaryTriangle = true);
 
+    /// <summary>
+    /// Delaunay Triangulation using the Guibas and Stolfi algorithm, also returning statistics about the point location walks.
+    /// </summary>
+    /// <param name="GridSize"> The size of each grid space that the points sit on. </param>
+    /// <param name="PointArray"> List of points to use in the Delaunay Triangulation. </param>
+    /// <param name="bRemoveBoundaryTriangle"> If true, edges that touch the boundary triangle will be removed from the returned array. </param>
+    /// <param name="PointLocationStats"> Returns statistics about the walks made to locate each point in the triangulation. </param>
+    /// <returns> List of edges made by the Delaunay Triangulation. </returns>
+    static TArray<FQuarterEdge> GuibasStolfiWithStats(FIntVector GridSize, TArray<FIntVector> PointArray, bool bRemoveBoundaryTriangle, FPointLocationStats& PointLocationStats);
+
     /// <summary>
     /// Delaunay Tetrahedralization using the Bowyer-Watson algorithm.
     /// </summary>
@@ -182,6 +263,38 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Triangulation")
     static TArray<FEdgeInfo> DelaunayTetrahedralization(FIntVector GridSize, TArray<FIntVector> PointArray, bool bRemoveBoundaryTetrahedron = true);
 
+    /// <summary>
+    /// Builds a Delaunay Tetrahedralization using the Bowyer-Watson algorithm which can then be updated incrementally.
+    /// </summary>
+    /// <param name="GridSize"> The size of each grid space that the points sit on. </param>
+    /// <param name="PointArray"> List of points to use in the Delaunay Tetrahedralization. </param>
+    /// <param name="Tetrahedralization"> Returns the tetrahedralization of the points. </param>
+    static void BuildTetrahedralization(FIntVector GridSize, const TArray<FIntVector>& PointArray, FTetrahedralizationData& Tetrahedralization);
+
+    /// <summary>
+    /// Inserts a point into an existing tetrahedralization, only the tetrahedra whose circumsphere contains the point are replaced.
+    /// </summary>
+    /// <param name="Tetrahedralization"> The tetrahedralization being updated. </param>
+    /// <param name="Point"> The point to insert. </param>
+    /// <param name="NewEdges"> Returned list of the edges connected to the inserted point. </param>
+    /// <returns> True if the point was inserted. </returns>
+    static bool InsertPointIntoTetrahedralization(FTetrahedralizationData& Tetrahedralization, FIntVector Point, TArray<FEdgeInfo>& NewEdges);
+
+    /// <summary>
+    /// Removes a point from an existing tetrahedralization, only the cavity left by the tetrahedra incident to the point is re-tetrahedralized.
+    /// </summary>
+    /// <param name="Tetrahedralization"> The tetrahedralization being updated. </param>
+    /// <param name="Point"> The point to remove. </param>
+    /// <param name="NeighbourEdges"> Returned list of the edges that fill the cavity, which connect the points that were connected to the removed point. </param>
+    /// <returns> True if the point was removed. </returns>
+    static bool RemovePointFromTetrahedralization(FTetrahedralizationData& Tetrahedralization, FIntVector Point, TArray<FEdgeInfo>& NeighbourEdges);
+
+    /** Returns the edges between the inserted points of the tetrahedralization. */
+    static TArray<FEdgeInfo> GetTetrahedralizationEdges(const FTetrahedralizationData& Tetrahedralization);
+
+    /** Returns an edge between the two points with its vertices in a consistent order, so it can be used as a key. */
+    static FEdgeInfo GetOrderedEdge(FIntVector PointA, FIntVector PointB);
+
     /** Returns a quarter edge made from the provided vectors. */
     static FQuarterEdge *MakeQuadEdge(FVector Start, FVector End);
 
@@ -232,6 +345,17 @@ protected:
     /** Returns true if the point exists somewhere along the edge. */
     static bool IsPointOnEdge(FVector Point, FQuarterEdge *FEdgeInfo);
 
+    /// <summary>
+    /// Jump-and-walk point location. Jumps to the closest of the cached edge for the point's grid bucket and a sample of roughly n^(1/3) edges, then walks to the triangle containing the point.
+    /// </summary>
+    /// <param name="Point"> The point being located. </param>
+    /// <param name="TriangulationArray"> List of edges in the triangulation, one for each triangle. </param>
+    /// <param name="BucketCache"> The last edge inserted in each grid bucket. </param>
+    /// <param name="BucketKey"> The grid bucket that the point lies in. </param>
+    /// <param name="PointLocationStats"> Statistics about the point location walks, updated with this walk. </param>
+    /// <returns> An edge of the triangle containing the point. </returns>
+    static FQuarterEdge* LocatePoint(FVector Point, const TArray<FQuarterEdge*>& TriangulationArray, const TMap<FIntPoint, FQuarterEdge*>& BucketCache, FIntPoint BucketKey, FPointLocationStats& PointLocationStats);
+
 /*
 *   3D DELAUNAY TRIANGULATION
 */
@@ -256,6 +380,55 @@ protected:
     /// <param name="PointArray"> List of points to use in the Delaunay Triangulation. </param>
     static void BowyerWatson3D(TArray<FTetrahedron*>& TetrahedraArray, TArray<FVector> PointArray);
 
+    /** Returns the tetrahedron enclosing the level grid, used as the starting point of the Bowyer-Watson algorithm. */
+    static FTetrahedron MakeBoundaryTetrahedron(FIntVector GridSize);
+
+    /// <summary>
+    /// Inserts a point into the tetrahedra using a single step of the Bowyer-Watson algorithm.
+    /// The tetrahedron containing the point is found by walking across the faces, then the cavity is grown from it through the face neighbours.
+    /// </summary>
+    /// <param name="Tetrahedralization"> The tetrahedralization being updated. </param>
+    /// <param name="Point"> The point to insert. </param>
+    /// <param name="RemovedTetrahedra"> Returned list of the tetrahedra whose circumsphere contained the point. </param>
+    /// <param name="AddedTetrahedra"> Returned list of the tetrahedra connecting the point to the cavity boundary. </param>
+    static void InsertPointIntoTetrahedraArray(FTetrahedralizationData& Tetrahedralization, FVector Point, TArray<FTetrahedron>& RemovedTetrahedra, TArray<FTetrahedron>& AddedTetrahedra);
+
+    /** Returns the index of the tetrahedron containing the point, walking across the faces from the most recently added tetrahedron. */
+    static int32 LocateTetrahedron(const FTetrahedralizationData& Tetrahedralization, const FVector& Point);
+
+    /** Returns the index of the tetrahedron on the other side of the face, or INDEX_NONE on the outside of the boundary tetrahedron. */
+    static int32 GetNeighbourTetrahedron(const FTetrahedralizationData& Tetrahedralization, int32 TetrahedronIndex, const FTetrahedronFaceKey& FaceKey);
+
+    /** Returns the key of the face made by the three vertices. */
+    static FTetrahedronFaceKey GetFaceKey(const FVector& A, const FVector& B, const FVector& C);
+
+    /** Returns true if the point is strictly inside the circumsphere of the tetrahedron, points on the circumsphere are outside. */
+    static bool IsPointInsideCircumsphere(const FTetrahedron& Tetrahedron, const FVector& Point);
+
+    /** Adds the tetrahedron to the tetrahedralization, to the incident tetrahedra of its inserted points and to the tetrahedra of its faces. */
+    static void AddTetrahedron(FTetrahedralizationData& Tetrahedralization, const FTetrahedron& Tetrahedron);
+
+    /** Removes the tetrahedron at the index by swapping the last tetrahedron into its place, keeping the incident tetrahedra of the points and faces up to date. */
+    static void RemoveTetrahedron(FTetrahedralizationData& Tetrahedralization, int32 TetrahedronIndex);
+
+    /** Returns the signed volume of the parallelepiped spanned by the triangle ABC and the point, positive if the point is on the side the normal of ABC points to. */
+    static double GetOrientation(const FVector& A, const FVector& B, const FVector& C, const FVector& Point);
+
+    /** Returns false if the tetrahedron is flat, otherwise returns the centre and squared radius of its circumsphere. */
+    static bool GetCircumsphere(const FTetrahedron& Tetrahedron, FVector& OutCentre, double& OutRadiusSquared);
+
+    /** Adds the edges of the tetrahedron to the edge reference count of the tetrahedralization, or removes them if Delta is negative. */
+    static void UpdateEdgeReferenceCount(FTetrahedralizationData& Tetrahedralization, const FTetrahedron& Tetrahedron, int32 Delta);
+
+    /** Returns true if the vertex is a point that has been inserted into the tetrahedralization, rather than a boundary vertex. */
+    static bool GetInsertedPoint(const FTetrahedralizationData& Tetrahedralization, const FVector& Vertex, FIntVector& OutPoint);
+
+    /** Returns true if the point lies inside or on the surface of the tetrahedron. */
+    static bool IsPointInsideTetrahedron(const FTetrahedron& Tetrahedron, const FVector& Point);
+
+    /** Returns the volume of the tetrahedron. */
+    static double GetTetrahedronVolume(const FTetrahedron& Tetrahedron);
+
     /** Returns true if the tetrahedron is in the array. */
     static bool IsTetrahedronAlreadyInArray(TArray<FTetrahedron*> TetrahedraArray, FTetrahedron* InTetrahedron);
 
@@ -8,6 +8,100 @@
 #include "Data/FunctionLibraries/DelaunayTriangulationLibrary.h"
 #include "KruskalMSTLibrary.generated.h"
 
+UENUM(BlueprintType, meta = (DisplayName = "Minimum Spanning Tree Algorithm"))
+enum class EMinimumSpanningTreeAlgorithm : uint8
+{
+	Kruskal				UMETA(DisplayName = "Kruskal"),
+	FilterKruskal		UMETA(DisplayName = "Parallel Filter-Kruskal"),
+
+	MAX					UMETA(Hidden)
+};
+
+/** Union-find structure with path compression and union by rank, used to check if an edge would form a cycle in the MST. */
+struct FEdgeDisjointSet
+{
+
+public:
+
+	FEdgeDisjointSet(int32 Size)
+	{
+		Parents.SetNumUninitialized(Size);
+		Ranks.SetNumZeroed(Size);
+
+		for (int32 i = 0; i < Size; i++) { Parents[i] = i; }
+	}
+
+	/** Returns the representative element of the set containing the element. */
+	int32 Find(int32 Element)
+	{
+		// Path halving, every other element on the path is pointed at its grandparent
+		while (Parents[Element] != Element)
+		{
+			Parents[Element] = Parents[Parents[Element]];
+			Element = Parents[Element];
+		}
+
+		return Element;
+	}
+
+	/** Returns the representative element of the set containing the element without compressing the path, safe to call from multiple threads while no unions are made. */
+	int32 FindWithoutCompression(int32 Element) const
+	{
+		while (Parents[Element] != Element) { Element = Parents[Element]; }
+
+		return Element;
+	}
+
+	/** Merges the sets containing both elements, returns false if they were already in the same set. */
+	bool Union(int32 ElementA, int32 ElementB)
+	{
+		int32 RootA = Find(ElementA);
+		int32 RootB = Find(ElementB);
+
+		if (RootA == RootB) { return false; }
+
+		if (Ranks[RootA] < Ranks[RootB]) { Swap(RootA, RootB); }
+
+		Parents[RootB] = RootA;
+		if (Ranks[RootA] == Ranks[RootB]) { Ranks[RootA]++; }
+
+		return true;
+	}
+
+private:
+
+	TArray<int32> Parents;
+	TArray<uint8> Ranks;
+
+};
+
+/** Structure denoting a weighted edge using the indices of its points. */
+struct FIndexedEdge
+{
+
+public:
+
+	int32 Origin = INDEX_NONE;
+	int32 Destination = INDEX_NONE;
+	float Weight = 0.f;
+
+	// Index of the edge in the source edge array
+	int32 EdgeIndex = INDEX_NONE;
+
+	/** Orders edges by weight, ties are broken by the lower then the higher point index so the order never depends on the input order. */
+	bool operator<(const FIndexedEdge& Other) const
+	{
+		if (Weight != Other.Weight) { return Weight < Other.Weight; }
+
+		const int32 MinIndex = FMath::Min(Origin, Destination);
+		const int32 OtherMinIndex = FMath::Min(Other.Origin, Other.Destination);
+		if (MinIndex != OtherMinIndex) { return MinIndex < OtherMinIndex; }
+
+		return FMath::Max(Origin, Destination) < FMath::Max(Other.Origin, Other.Destination);
+	}
+
+};
+
 UCLASS()
 class PROJECTSCIFI_API UKruskalMSTLibrary : public UBlueprintFunctionLibrary
 {
@@ -31,9 +125,26 @@ public:
 	/// <param name="PointArray"> List of points used in the Delaunay Tetrahedralization. </param>
 	/// <param name="MSTEdgeArray"> List of edges made by the Delaunay Tetrahedralization. </param>
 	/// <param name="DiscardedEdgesArray"> Returned list of edges which are not part of the MST. </param>
+	/// <param name="Algorithm"> The algorithm used to build the MST, every algorithm returns the same tree and discarded edges. </param>
 	/// <returns> The Minimum Spanning Tree of the provided points and edges. </returns>
 	UFUNCTION(BlueprintCallable, Category = "Kruskal MST")
-	static TArray<FEdgeInfo> GetMinimumSpanningTreeV2(TArray<FIntVector> PointArray, TArray<FEdgeInfo> EdgeArray, TArray<FEdgeInfo>&DiscardedEdgesArray);
+	static TArray<FEdgeInfo> GetMinimumSpanningTreeV2(TArray<FIntVector> PointArray, TArray<FEdgeInfo> EdgeArray, TArray<FEdgeInfo>&DiscardedEdgesArray, EMinimumSpanningTreeAlgorithm Algorithm = EMinimumSpanningTreeAlgorithm::Kruskal);
+
+	/// <summary>
+	/// Updates a Minimum Spanning Tree after a point has been added to the graph. Only the existing tree and the edges connected to the new point can be part of the new tree.
+	/// </summary>
+	/// <param name="MinimumSpanningTree"> The Minimum Spanning Tree before the point was added, returns the updated Minimum Spanning Tree. </param>
+	/// <param name="NewPointEdges"> List of the edges in the graph connected to the new point. </param>
+	/// <param name="DiscardedEdgesArray"> Returned list of edges which were considered but are not part of the MST. </param>
+	static void AddPointToMinimumSpanningTree(TArray<FEdgeInfo>& MinimumSpanningTree, const TArray<FEdgeInfo>& NewPointEdges, TArray<FEdgeInfo>& DiscardedEdgesArray);
+
+	/// <summary>
+	/// Updates a Minimum Spanning Tree after a point has been removed from the graph. The remaining tree edges are kept and the pieces are reconnected using only the edges between the neighbours of the removed point.
+	/// </summary>
+	/// <param name="MinimumSpanningTree"> The Minimum Spanning Tree before the point was removed, returns the updated Minimum Spanning Tree. </param>
+	/// <param name="RemovedPoint"> The point that has been removed from the graph. </param>
+	/// <param name="NeighbourEdges"> List of the graph edges between the points that were connected to the removed point, e.g. the edges filling its cavity in the tetrahedralization. </param>
+	static void RemovePointFromMinimumSpanningTree(TArray<FEdgeInfo>& MinimumSpanningTree, FIntVector RemovedPoint, const TArray<FEdgeInfo>& NeighbourEdges);
 
 	/// <summary>
 	/// Displays the MST in the game world.
@@ -42,7 +153,7 @@ public:
 	/// <param name="WorldRef"> Reference of the game world. </param>
 	/// <param name="TileSize"> The size of the level grid used in the procedural level generation. </param>
 	/// <param name="TraceColour"> The colour of the MST drawing. </param>
-	UFUNCTION(BlueprintCallable, Category = "Kruskal MST")
+	UFUNCTION(BlueprintCallable, Category = "Kruskal MST", meta = (DeprecatedFunction, DeprecationMessage = "Use DrawDebugLines from the Level Generation Debug Library instead."))
 	static void DrawMST(TArray<FEdgeInfo> MSTEdgeArray, UObject* WorldRef, int TileSize, FLinearColor TraceColour);
 	
 	/// <summary>
@@ -60,6 +171,43 @@ protected:
 	//function to compare edges using qsort() in C programming
 	static bool EdgeComparison(const FEdgeInfo& EdgeA, const FEdgeInfo& EdgeB);
 
+	/// <summary>
+	/// Kruskal's algorithm. The edges are converted to point indices and sorted once, then scanned in a single pass.
+	/// </summary>
+	/// <param name="PointArray"> List of points in the graph. </param>
+	/// <param name="EdgeArray"> List of edges in the graph. </param>
+	/// <param name="DiscardedEdgesArray"> Returned list of edges which are not part of the MST. </param>
+	/// <returns> The Minimum Spanning Tree of the provided points and edges. </returns>
+	static TArray<FEdgeInfo> BuildMinimumSpanningTree(const TArray<FIntVector>& PointArray, const TArray<FEdgeInfo>& EdgeArray, TArray<FEdgeInfo>& DiscardedEdgesArray);
+
+	/// <summary>
+	/// Filter-Kruskal algorithm. The edges are partitioned around a pivot in parallel, the lighter half is solved first and the heavier half is filtered of edges that would form a cycle before it is solved.
+	/// </summary>
+	/// <param name="PointArray"> List of points in the graph. </param>
+	/// <param name="EdgeArray"> List of edges in the graph. </param>
+	/// <param name="DiscardedEdgesArray"> Returned list of edges which are not part of the MST. </param>
+	/// <returns> The Minimum Spanning Tree of the provided points and edges. </returns>
+	static TArray<FEdgeInfo> BuildMinimumSpanningTreeFilterKruskal(const TArray<FIntVector>& PointArray, const TArray<FEdgeInfo>& EdgeArray, TArray<FEdgeInfo>& DiscardedEdgesArray);
+
+	/// <summary>
+	/// Recursive step of the Filter-Kruskal algorithm.
+	/// </summary>
+	/// <param name="IndexedEdges"> List of edges to add to the MST. </param>
+	/// <param name="DisjointSet"> The union-find structure of the points in the graph. </param>
+	/// <param name="TreeSize"> The number of edges in a complete MST. </param>
+	/// <param name="TreeEdges"> List of edges added to the MST, in order of weight. </param>
+	/// <param name="DiscardedEdges"> List of edges which are not part of the MST. </param>
+	static void FilterKruskal(TArray<FIndexedEdge>& IndexedEdges, FEdgeDisjointSet& DisjointSet, int32 TreeSize, TArray<FIndexedEdge>& TreeEdges, TArray<FIndexedEdge>& DiscardedEdges);
+
+	/// <summary>
+	/// Converts the edges into edges between point indices.
+	/// </summary>
+	/// <param name="PointArray"> List of points in the graph. </param>
+	/// <param name="EdgeArray"> List of edges in the graph. </param>
+	/// <param name="DiscardedEdgesArray"> Returned list of edges whose points are not in the point array. </param>
+	/// <returns> List of the edges using point indices. </returns>
+	static TArray<FIndexedEdge> GetIndexedEdges(const TArray<FIntVector>& PointArray, const TArray<FEdgeInfo>& EdgeArray, TArray<FEdgeInfo>& DiscardedEdgesArray);
+
 private:
 
 
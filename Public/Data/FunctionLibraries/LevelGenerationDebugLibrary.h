@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Data/LevelGenerationData.h"
+#include "LevelGenerationDebugLibrary.generated.h"
+
+struct FBatchedLine;
+class ULineBatchComponent;
+
+/** Structure containing the options used to draw the level generation debug data. */
+USTRUCT(BlueprintType)
+struct FLevelGenerationDebugDrawOptions
+{
+	GENERATED_USTRUCT_BODY()
+public:
+
+	/** If enabled, the MST (and any additional paths) will be drawn. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Draw MST"), Category = "Debug")
+	bool bDrawMinimumSpanningTree = true;
+
+	/** If enabled, the edges of the room graph which are not corridors will be drawn. Requires bRecordDebugData. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Draw Discarded Edges"), Category = "Debug")
+	bool bDrawDiscardedEdges = false;
+
+	/** If enabled, the nodes explored by the A* Pathfinding of each corridor will be drawn. Requires bRecordDebugData. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Draw Explored Nodes"), Category = "Debug")
+	bool bDrawExploredNodes = false;
+
+	/** If enabled, the occupied tiles of a single floor of the level grid will be drawn. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Draw Occupancy Slice"), Category = "Debug")
+	bool bDrawOccupancySlice = false;
+
+	/** The floor of the level grid drawn by the occupancy slice. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Occupancy Slice Z", EditCondition = "bDrawOccupancySlice"), Category = "Debug")
+	int32 OccupancySliceZ = 0;
+
+	/** The height the debug lines are drawn above the tiles. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Height Offset"), Category = "Debug")
+	float HeightOffset = 1000.f;
+
+	/** The thickness of the debug lines. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Line Thickness"), Category = "Debug")
+	float LineThickness = 0.f;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "MST Colour"), Category = "Debug")
+	FLinearColor MinimumSpanningTreeColour = FLinearColor::Green;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Discarded Edge Colour"), Category = "Debug")
+	FLinearColor DiscardedEdgeColour = FLinearColor::Red;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Explored Node Colour"), Category = "Debug")
+	FLinearColor ExploredNodeColour = FLinearColor::Yellow;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Failed Search Colour"), Category = "Debug")
+	FLinearColor FailedSearchColour = FLinearColor(1.f, 0.f, 1.f);
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Room Tile Colour"), Category = "Debug")
+	FLinearColor RoomTileColour = FLinearColor::Blue;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Corridor Tile Colour"), Category = "Debug")
+	FLinearColor CorridorTileColour = FLinearColor::White;
+};
+
+/**
+ * Builds the debug drawing of the level generation as a single batch of lines.
+ */
+UCLASS()
+class PROJECTSCIFI_API ULevelGenerationDebugLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+
+	/// <summary>
+	/// Fills a list of lines with the debug drawing of the generated level. Does not need a world, so it can be used without one.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="DrawOptions"> The options that determine what is drawn. </param>
+	/// <param name="OutLines"> Returned list of lines to draw. </param>
+	static void BuildDebugLines(const FLevelGenerationSettings& LevelGenerationSettings, const FGeneratedLevelData& GeneratedLevelData, const FLevelGenerationDebugDrawOptions& DrawOptions, TArray<FBatchedLine>& OutLines);
+
+	/// <summary>
+	/// Replaces the lines of the line batcher with the debug drawing of the generated level.
+	/// </summary>
+	/// <param name="LineBatcher"> The line batcher the debug drawing is submitted to. </param>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="DrawOptions"> The options that determine what is drawn. </param>
+	UFUNCTION(BlueprintCallable, Category = "Level Generation|Debug")
+	static void DrawDebugLines(ULineBatchComponent* LineBatcher, const FLevelGenerationSettings& LevelGenerationSettings, const FGeneratedLevelData& GeneratedLevelData, const FLevelGenerationDebugDrawOptions& DrawOptions);
+
+	/// <summary>
+	/// Adds a line for every edge to the persistent line batcher of the world, keeping the lines already drawn.
+	/// </summary>
+	/// <param name="WorldContextObject"> Object in the world the lines are drawn in. </param>
+	/// <param name="EdgeArray"> The edges to be drawn. </param>
+	/// <param name="TileSize"> The size of the level grid used in the procedural level generation. </param>
+	/// <param name="DrawOptions"> The options that determine how the lines are drawn. </param>
+	/// <param name="Colour"> The colour of the lines. </param>
+	static void DrawEdgeLines(UObject* WorldContextObject, const TArray<FEdgeInfo>& EdgeArray, int32 TileSize, const FLevelGenerationDebugDrawOptions& DrawOptions, const FLinearColor& Colour);
+
+	/** Removes every line from the line batcher. */
+	UFUNCTION(BlueprintCallable, Category = "Level Generation|Debug")
+	static void ClearDebugLines(ULineBatchComponent* LineBatcher);
+
+protected:
+
+	/** Adds a line for every edge in the array. */
+	static void AddEdgeLines(const TArray<FEdgeInfo>& EdgeArray, int32 TileSize, const FLevelGenerationDebugDrawOptions& DrawOptions, const FLinearColor& Colour, TArray<FBatchedLine>& OutLines);
+
+	/** Adds a cross marking the tile at the coordinate. */
+	static void AddTileCross(const FIntVector& Coordinate, int32 TileSize, const FLevelGenerationDebugDrawOptions& DrawOptions, const FLinearColor& Colour, TArray<FBatchedLine>& OutLines);
+
+	/** Adds an outline of the tile at the coordinate. */
+	static void AddTileOutline(const FIntVector& Coordinate, int32 TileSize, const FLevelGenerationDebugDrawOptions& DrawOptions, const FLinearColor& Colour, TArray<FBatchedLine>& OutLines);
+
+	/** Returns the world location of the coordinate in the level grid, raised by the height offset. */
+	static FVector GetDebugLocation(const FIntVector& Coordinate, int32 TileSize, const FLevelGenerationDebugDrawOptions& DrawOptions);
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Data/LevelGenerationData.h"
+#include "Data/LevelGenerationTask.h"
 #include "LevelGenerationLibrary.generated.h"
 
 
@@ -15,12 +16,14 @@ public:
 
 	FEdgeInfo PathData;
 
-	FTileData* OriginTile = nullptr;
+	FTileInstanceData* OriginTile = nullptr;
+	const FTileTemplate* OriginTemplate = nullptr;
 	FIntVector OriginAccessPoint = FIntVector::ZeroValue;
 	FIntVector OriginAccessPointLocation = FIntVector::ZeroValue;
 	EDirections OriginPathDirection = EDirections::None;
 	
-	FTileData* DestinationTile = nullptr;
+	FTileInstanceData* DestinationTile = nullptr;
+	const FTileTemplate* DestinationTemplate = nullptr;
 	FIntVector DestinationAccessPoint = FIntVector::ZeroValue;
 	FIntVector DestinationAccessPointLocation = FIntVector::ZeroValue;
 	EDirections DestinationPathDirection = EDirections::None;
@@ -33,6 +36,117 @@ public:
 
 };
 
+enum class EPathSearchResult : uint8
+{
+	InProgress,
+	PathFound,
+	NoPath
+};
+
+/** State of an A* Pathfinding search between two access points, kept between steps so the search can be run a few nodes at a time. */
+struct FAdvancedPathSearch
+{
+
+public:
+
+	FIntVector StartLocation = FIntVector::ZeroValue;
+	FIntVector EndLocation = FIntVector::ZeroValue;
+
+	// The set of nodes to be evaluated
+	TMap<FIntVector, FAdvancedPathNode> OPEN;
+	// The set of nodes already evaluated
+	TMap<FIntVector, FAdvancedPathNode> CLOSED;
+	// The set of nodes which cannot be traversed
+	TSet<FIntVector> InaccessibleNodes;
+
+	// The nodes of the path, filled in once the path is found
+	TMap<FIntVector, FAdvancedPathNode> PathData;
+
+	EPathSearchResult Result = EPathSearchResult::InProgress;
+
+};
+
+/** State of the corridor generation, kept between steps so the corridors can be built a few A* Pathfinding nodes at a time. */
+struct FCorridorGenerationState
+{
+
+public:
+
+	// Array containing all the paths that need to be built, shortest first
+	TArray<FPathGenerationData> PathGenerationDataArray;
+
+	// Index of the path being built
+	int32 PathIndex = 0;
+
+	// The path being built, its access points change every time the search fails
+	FPathGenerationData PathGenerationData;
+	TArray<FIntVector> ExcludedOriginAPs;
+	TArray<FIntVector> ExcludedDestinationAPs;
+	int32 MaxOriginStartingLocations = 0;
+	int32 MaxDestinationEndLocations = 0;
+
+	// A* Pathfinding nodes expanded for the path being built, over every access point tried
+	int32 PathExpansions = 0;
+
+	// The search of the path being built
+	FAdvancedPathSearch Search;
+
+	bool bPathStarted = false;
+	bool bSearchStarted = false;
+
+};
+
+enum class ELevelGenerationStep : uint8
+{
+	Prepare,
+	KeyRooms,
+	SpecialRooms,
+	BasicRooms,
+	RoomTetrahedralization,
+	RoomMinimumSpanningTree,
+	CorridorSetup,
+	Corridors,
+	CorridorTiles,
+	Done
+};
+
+/** State of the room placement, kept between steps so the rooms can be placed one at a time. */
+struct FRoomGenerationState
+{
+
+public:
+
+	// Index of the key or special room entry being placed
+	int32 EntryIndex = 0;
+
+	// Number of rooms placed for the current entry, or of basic rooms placed
+	int32 RoomIndex = 0;
+
+	// Number of rooms to place for the current entry, or of basic rooms to place. INDEX_NONE until it has been picked
+	int32 RoomsToPlace = INDEX_NONE;
+
+};
+
+/** State of a level generation that is run a step at a time, e.g. spread over several frames. */
+struct FLevelGenerationStepState
+{
+
+public:
+
+	ELevelGenerationStep Step = ELevelGenerationStep::Prepare;
+
+	FRoomGenerationState Rooms;
+
+	// The rooms and edges of the room graph, kept from the tetrahedralization step for the MST step
+	TArray<FIntVector> RoomCoordinates;
+	TArray<FEdgeInfo> RoomGraphEdges;
+
+	FCorridorGenerationState Corridors;
+
+	bool IsDone() const { return Step == ELevelGenerationStep::Done; }
+
+};
+
 
 UCLASS()
 class PROJECTSCIFI_API ULevelGenerationLibrary : public UBlueprintFunctionLibrary
@@ -50,6 +164,60 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Level Generation")
 	static void GenerateLevel(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UObject* WorldRef);
 
+	/// <summary>
+	/// Sets the seed of the level, loads the special path data and compiles the settings. Must be called on the game thread before RunLevelGeneration.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	static void PrepareLevelGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData);
+
+	/// <summary>
+	/// Generates the rooms, room graph and corridors of a level set up by PrepareLevelGeneration. Only the settings and the level data are used, so it can run off the game thread.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <returns> False if the generation was cancelled before it finished. </returns>
+	static bool RunLevelGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData);
+
+	/// <summary>
+	/// Generates the rooms, room graph and corridors of a level set up by PrepareLevelGeneration, then draws the MST in the world if bDrawMST is enabled.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="WorldRef"> Reference to the world. </param>
+	/// <returns> False if the generation was cancelled before it finished. </returns>
+	UE_DEPRECATED(5.3, "The generation no longer uses the world. Use the RunLevelGeneration overload without a WorldRef and draw the level with ULevelGenerationDebugLibrary.")
+	static bool RunLevelGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UObject* WorldRef);
+
+	/// <summary>
+	/// Procedurally generates a level on a worker thread from a copy of the settings. Must be called on the game thread.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates. </param>
+	/// <param name="OnComplete"> Called on the game thread once the generation has finished or been cancelled. </param>
+	/// <returns> The task generating the level, used to follow its progress, cancel it and take the generated level. </returns>
+	static TSharedRef<FLevelGenerationTask> GenerateLevelAsync(const FLevelGenerationSettings& LevelGenerationSettings, FOnLevelGenerationTaskComplete OnComplete);
+
+	/// <summary>
+	/// Runs the next step of a level generation. A step is the preparation, one room, the room tetrahedralization, the MST, or up to MaxPathExpansions nodes of the corridor pathfinding.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="StepState"> The state of the generation, kept between steps. </param>
+	/// <param name="MaxPathExpansions"> The maximum number of nodes the A* Pathfinding can evaluate in the step. </param>
+	/// <returns> True once the level has been generated. </returns>
+	static bool StepLevelGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, FLevelGenerationStepState& StepState, int32 MaxPathExpansions);
+
+	/// <summary>
+	/// Runs steps of a level generation until the time budget is spent, at least one step is always run. Stops as soon as the generation is cancelled.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="StepState"> The state of the generation, kept between steps. </param>
+	/// <param name="TimeBudgetMs"> The time in milliseconds the generation can use. </param>
+	/// <param name="MaxPathExpansions"> The maximum number of nodes the A* Pathfinding can evaluate in each step. </param>
+	/// <returns> True once the level has been generated, false while it is generating or if it has been cancelled. </returns>
+	static bool TickLevelGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, FLevelGenerationStepState& StepState, float TimeBudgetMs, int32 MaxPathExpansions);
+
 	/// <summary>
 	/// Rotates an IntVector about the origin point (0, 0, 0).
 	/// </summary>
@@ -77,6 +245,65 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Level Generation")
 	static EDirections RotateDirection(EDirections InDirection, FRotator InRotation);
 
+	/// <summary>
+	/// Updates the room graph and MST of the level after rooms have been added or removed, only the neighbourhood of the changed rooms is recomputed.
+	/// Not exposed to Blueprint, it is meant for C++ tools that edit the rooms of an already generated level.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="AddedRoomCoordinates"> The coordinates of the rooms that have been added to the level. </param>
+	/// <param name="RemovedRoomCoordinates"> The coordinates of the rooms that have been removed from the level. </param>
+	static void UpdateRoomGraph(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, const TArray<FIntVector>& AddedRoomCoordinates, const TArray<FIntVector>& RemovedRoomCoordinates);
+
+	/// <summary>
+	/// Creates tile data from the provided corridor tile data, picking its map from a stream seeded by the level seed and the coordinate so the pick does not depend on the order the corridors are added in.
+	/// </summary>
+	/// <param name="Coordinate"> The coordinate of the corridor. </param>
+	/// <param name="CorridorTileData"> The data we are going to convert into an FTileData. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <returns> FTileData made from the corridor tile data. </returns>
+	static FTileData GetCorridorTileDataAtCoordinate(const FIntVector& Coordinate, const FCorridorTileData& CorridorTileData, FGeneratedLevelData& GeneratedLevelData);
+
+	/// <summary>
+	/// Builds the Delaunay Tetrahedralization of every room in the level, the first half of BuildRoomGraph.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="OutRoomCoordinates"> The coordinates of every room in the level. </param>
+	/// <param name="OutGraphEdges"> Every edge of the tetrahedralization. </param>
+	static void BuildRoomTetrahedralization(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, TArray<FIntVector>& OutRoomCoordinates, TArray<FEdgeInfo>& OutGraphEdges);
+
+	/// <summary>
+	/// Attempts to place a room in the level grid.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="RoomList"> List of rooms to take a room from, then place in the grid. </param>
+	/// <param name="RoomType"> The type of room being placed, used for the placement statistics. </param>
+	static void PlaceRoomInGrid(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UDataTable* RoomList, ETileType RoomType);
+
+	/// <summary>
+	/// An altered version of the A* Pathfinding algorithm. Used to build a path between two access points in 3D space using special corridor structures, e.g. Stairways, elevators.
+	/// </summary>
+	/// <param name="StartLocation"> The starting point of the path. </param>
+	/// <param name="EndLocation"> The end goal of the path. </param>
+	/// <param name="PathData"> TMap containing all the data of the generated path. </param>
+	/// <param name="PathGenerationDataArray"> Array containing all the paths that need to be built. </param>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <returns> True if the path is successfully created. </returns>
+	static bool AdvancedAStarPathfinding(FIntVector StartLocation, FIntVector EndLocation, TMap<FIntVector, FAdvancedPathNode>& PathData, const TArray<FPathGenerationData>& PathGenerationDataArray, FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData);
+
+	/// <summary>
+	/// Creates tile data from the provided corridor tile data.
+	/// </summary>
+	/// <param name="CorridorTileData"> The data we are going to convert into an FTileData. </param>
+	/// <param name="CompiledSettings"> The compiled settings of the level generation. </param>
+	/// <param name="LevelStream"> The seed of the level, determines how randomisation is handled in the level generation. </param>
+	/// <param name="SelectionCache"> The random selection data of the data tables. </param>
+	/// <returns> FTileData made from the corridor tile data. </returns>
+	static FTileData GetTileDataFromCorridorTileData(const FCorridorTileData& CorridorTileData, const FCompiledLevelGenSettings& CompiledSettings, const FRandomStream& LevelStream, FRandomSelectionCache& SelectionCache);
+
 protected:
 
 	/// <summary>
@@ -100,45 +327,188 @@ protected:
 	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
 	static void GenerateBasicRooms(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData);
 
+	/// <summary>
+	/// Places the next key room of the level.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="RoomState"> The state of the room placement, kept between steps. </param>
+	/// <returns> True once every key room has been placed. </returns>
+	static bool StepKeyRooms(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, FRoomGenerationState& RoomState);
+
+	/// <summary>
+	/// Places the next special room of the level that passes its chance to generate.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="RoomState"> The state of the room placement, kept between steps. </param>
+	/// <returns> True once every special room has been placed. </returns>
+	static bool StepSpecialRooms(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, FRoomGenerationState& RoomState);
+
+	/// <summary>
+	/// Places the next basic room of the level, the number of basic rooms is picked on the first step.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="RoomState"> The state of the room placement, kept between steps. </param>
+	/// <returns> True once every basic room has been placed. </returns>
+	static bool StepBasicRooms(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, FRoomGenerationState& RoomState);
+
+	/// <summary>
+	/// Builds the room graph and MST from every room in the level.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	static void BuildRoomGraph(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData);
+
+	/// <summary>
+	/// Builds the MST of the rooms and randomly adds extra corridors to it, the second half of BuildRoomGraph.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="RoomCoordinates"> The coordinates of every room in the level. </param>
+	/// <param name="GraphEdges"> Every edge of the room tetrahedralization. </param>
+	static void BuildRoomMinimumSpanningTree(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, const TArray<FIntVector>& RoomCoordinates, const TArray<FEdgeInfo>& GraphEdges);
+
+	/// <summary>
+	/// Records the edges of the room graph which are not used by any corridor for the debug drawing.
+	/// </summary>
+	/// <param name="GraphEdges"> List of every edge in the room graph. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	static void RecordDiscardedEdges(const TArray<FEdgeInfo>& GraphEdges, FGeneratedLevelData& GeneratedLevelData);
+
 	/// <summary>
 	/// Generates the corridors for the level.
 	/// </summary>
 	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
 	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	static void GenerateCorridors3D(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData);
+
+	/// <summary>
+	/// Generates the corridors for the level, then draws the MST in the world if bDrawMST is enabled.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
 	/// <param name="WorldRef"> Reference to the world. </param>
+	UE_DEPRECATED(5.3, "The corridor generation no longer uses the world. Use the GenerateCorridors3D overload without a WorldRef and draw the level with ULevelGenerationDebugLibrary.")
 	static void GenerateCorridors3D(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UObject* WorldRef);
+
+	/// <summary>
+	/// Sorts the MST + extra paths and finds the access points each corridor starts and ends at.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="CorridorState"> Returned state of the corridor generation. </param>
+	/// <returns> False if no corridors are generated. </returns>
+	static bool BeginCorridorGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, FCorridorGenerationState& CorridorState);
+
+	/// <summary>
+	/// Builds corridors until every corridor is built or the A* Pathfinding has evaluated ExpansionBudget nodes.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="CorridorState"> The state of the corridor generation, kept between steps. </param>
+	/// <param name="ExpansionBudget"> The number of nodes the A* Pathfinding can still evaluate, reduced by the nodes evaluated. </param>
+	/// <returns> True once every corridor has been built. </returns>
+	static bool StepCorridorGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, FCorridorGenerationState& CorridorState, int32& ExpansionBudget);
+
+	/// <summary>
+	/// Creates the tiles of every corridor and adds them to the level.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	static void FinishCorridorGeneration(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData);
+
+	/// <summary>
+	/// Adds a path found by the A* Pathfinding to the level and marks the access points it uses.
+	/// </summary>
+	/// <param name="PathGenerationData"> The path that was built. </param>
+	/// <param name="PathData"> TMap containing all the data of the generated path. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	static void CommitCorridorPath(const FPathGenerationData& PathGenerationData, const TMap<FIntVector, FAdvancedPathNode>& PathData, FGeneratedLevelData& GeneratedLevelData);
+
+	/// <summary>
+	/// Adds the single corridor joining two rooms whose access points are next to each other.
+	/// </summary>
+	/// <param name="PathGenerationData"> The path that was built. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	static void CommitAdjacentCorridor(const FPathGenerationData& PathGenerationData, FGeneratedLevelData& GeneratedLevelData);
 	
 	/// <summary>
-	/// Attempts to place a room in the level grid.
+	/// Draws a room, rotation and coordinate to try placing in the level grid.
 	/// </summary>
 	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
 	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
-	/// <param name="RoomList"> List of rooms to take a room from, then place in the grid. </param>
-	static void PlaceRoomInGrid(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UDataTable* RoomList);
+	/// <param name="RoomList"> List of rooms to take a room from. </param>
+	/// <param name="Stream"> The stream the placement is drawn from. </param>
+	/// <returns> The drawn placement, its footprint is not set. </returns>
+	static FRoomPlacementCandidate DrawRoomPlacementCandidate(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UDataTable* RoomList, const FRandomStream& Stream);
+
+	/// <summary>
+	/// Tests one placement at a time until a valid one is found or too many have failed.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="RoomList"> List of rooms to take a room from. </param>
+	/// <param name="OutPlacement"> Returned valid placement. </param>
+	/// <param name="PlacementsTested"> Returned number of placements tested. </param>
+	/// <returns> True if a valid placement was found. </returns>
+	static bool FindRoomPlacement(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UDataTable* RoomList, FRoomPlacementCandidate& OutPlacement, int32& PlacementsTested);
+
+	/// <summary>
+	/// Draws batches of placements from a sub-stream of the level seed and tests each batch in parallel, taking the first valid placement in the order they were drawn.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="RoomList"> List of rooms to take a room from. </param>
+	/// <param name="OutPlacement"> Returned valid placement. </param>
+	/// <param name="PlacementsTested"> Returned number of placements tested, up to and including the valid placement. </param>
+	/// <returns> True if a valid placement was found. </returns>
+	static bool FindRoomPlacementInBatches(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UDataTable* RoomList, FRoomPlacementCandidate& OutPlacement, int32& PlacementsTested);
+
+	/// <summary>
+	/// Adds the room and its sections to the level data.
+	/// </summary>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="Placement"> The valid placement of the room. </param>
+	static void AddRoomToLevel(FGeneratedLevelData& GeneratedLevelData, const FRoomPlacementCandidate& Placement);
+
+	/// <summary>
+	/// Creates the compact record of a section of a tile that covers several coordinates.
+	/// </summary>
+	/// <param name="SectionType"> The section's type. </param>
+	/// <param name="ParentCoordinate"> The coordinate of the tile the section belongs to. </param>
+	/// <param name="LocalOffset"> The offset of the section in the parent's TileSize. </param>
+	/// <param name="ParentTileData"> The tile data of the tile the section belongs to. </param>
+	/// <returns> The section's record. </returns>
+	static FTileSectionData MakeTileSectionData(ETileType SectionType, const FIntVector& ParentCoordinate, const FIntVector& LocalOffset, const FTileData& ParentTileData);
 
 	/// <summary>
 	/// Randomly selects a room list from the provided data table.
 	/// </summary>
 	/// <param name="RoomListDataTable"> Data table containing the room lists. </param>
 	/// <param name="LevelStream"> The seed of the level, determines how randomisation is handled in the level generation. </param>
+	/// <param name="SelectionCache"> The random selection data of the data tables, each room list map is cached the first time it is used in the level generation. </param>
 	/// <returns> A random room list from the data table. </returns>
-	static UDataTable* GetRandomRoomListFromDataTable(TMap<UDataTable*, double>& RoomListDataTable, const FRandomStream& LevelStream);
+	static UDataTable* GetRandomRoomListFromDataTable(TMap<UDataTable*, double>& RoomListDataTable, const FRandomStream& LevelStream, FRandomSelectionCache& SelectionCache);
 
 	/// <summary>
 	/// Randomly selects a room from the room list.
 	/// </summary>
 	/// <param name="RoomList"> List of rooms to use in the level generation. </param>
 	/// <param name="LevelStream"> The seed of the level, determines how randomisation is handled in the level generation. </param>
+	/// <param name="SelectionCache"> The random selection data of the data tables. </param>
 	/// <returns> A random room from the list. </returns>
-	static FTileGenerationData* GetRandomRoomFromRoomList(UDataTable* RoomList, const FRandomStream& LevelStream);
+	static FTileGenerationData* GetRandomRoomFromRoomList(UDataTable* RoomList, const FRandomStream& LevelStream, FRandomSelectionCache& SelectionCache);
 
 	/// <summary>
 	/// Randomly selects a corridor section from the corridor list.
 	/// </summary>
 	/// <param name="CorridorList"> List of corridor sections to use in the level generation. </param>
 	/// <param name="LevelStream"> The seed of the level, determines how randomisation is handled in the level generation. </param>
+	/// <param name="SelectionCache"> The random selection data of the data tables. </param>
 	/// <returns> A random corridor section from the list. </returns>
-	static FCorridorLevelData* GetRandomCorridorFromCorridorList(UDataTable* CorridorList, const FRandomStream& LevelStream);
+	static FCorridorLevelData* GetRandomCorridorFromCorridorList(UDataTable* CorridorList, const FRandomStream& LevelStream, FRandomSelectionCache& SelectionCache);
 
 	/// <summary>
 	/// Randomly selects a rotation to be used by a room tile. The possible rotations are 0, 90, 180, 270.
@@ -152,22 +522,42 @@ protected:
 	/// </summary>
 	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
 	/// <param name="LevelStream"> The seed of the level, determines how randomisation is handled in the level generation. </param>
-	/// <param name="LevelTileData"> TMap containing the all the rooms and corridors currently generated in the level.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
 	/// <param name="bEmptyCoordinateFound"> Returns true if an empty space is found in the level grid. </param>
 	/// <returns> The location of an empty tile in the level grid. </returns>
-	static FIntVector GetRandomEmptyCoordinate(FLevelGenerationSettings& LevelGenerationSettings, const FRandomStream& LevelStream, TMap<FIntVector, FTileData>& LevelTileData, bool& bEmptyCoordinateFound);
+	static FIntVector GetRandomEmptyCoordinate(FLevelGenerationSettings& LevelGenerationSettings, const FRandomStream& LevelStream, FGeneratedLevelData& GeneratedLevelData, bool& bEmptyCoordinateFound);
 
 	/// <summary>
-	/// Checks if the room can be placed at the desired coordinate.
+	/// Checks if the room can be placed at the desired coordinate. Star shaped buffers are tested against the occupancy of the level grid a row at a time, box shaped buffers with box sums of the occupancy tree.
 	/// </summary>
 	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
 	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
-	/// <param name="TileAccessPoints"> The sections of the room which have access points that can lead to other areas of the level. </param>
+	/// <param name="RoomFootprint"> The compiled footprint of the room at its rotation. </param>
 	/// <param name="PlacementCoordinate">The coordinate that the room will be placed at. </param>
-	/// <param name="RoomRotation"> The rotation of the room in world space. </param>
-	/// <param name="TileSize"> The size of the room in the level grid space. </param>
 	/// <returns> True if the room can be placed at the desired coordinate.</returns>
-	static bool RoomPlacementIsValid(const FLevelGenerationSettings& LevelGenerationSettings, const FGeneratedLevelData& GeneratedLevelData, const TMap<FIntVector, FTileAccessData> TileAccessPoints, const FIntVector PlacementCoordinate, const FRotator RoomRotation, const TSet<FIntVector> TileSize);
+	static bool RoomPlacementIsValid(const FLevelGenerationSettings& LevelGenerationSettings, const FGeneratedLevelData& GeneratedLevelData, const FCompiledRoomFootprint& RoomFootprint, const FIntVector PlacementCoordinate);
+
+	/// <summary>
+	/// Finds the compiled footprint of the room at the given rotation, compiling it the first time it is needed in the level generation.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="TileGenerationData"> The room being placed. </param>
+	/// <param name="RoomRotation"> The rotation of the room in world space. </param>
+	/// <returns> The compiled footprint of the room. </returns>
+	static const FCompiledRoomFootprint& GetCompiledRoomFootprint(const FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, const FTileGenerationData* TileGenerationData, const FRotator& RoomRotation);
+
+	/// <summary>
+	/// Builds the bitmasks of the room's sections and the buffer surrounding them.
+	/// </summary>
+	/// <param name="TileData"> The tile data of the room. </param>
+	/// <param name="RotationIndex"> The number of 90 clockwise turns of the room. </param>
+	/// <param name="RoomBufferSize"> The size of the buffer surrounding the room. </param>
+	/// <returns> The compiled footprint of the room. </returns>
+	static FCompiledRoomFootprint CompileRoomFootprint(const FTileData& TileData, int32 RotationIndex, int32 RoomBufferSize);
+
+	/** Returns the number of 90 clockwise turns (0 - 3) that give the same result as the rotation in RotateIntVectorCoordinatefromOrigin. */
+	static int32 GetRotationIndex(const FRotator& TileRotation);
 
 	/// <summary>
 	/// Checks if the provided coordinate is inside or outside the level grid.
@@ -178,37 +568,25 @@ protected:
 	static bool IsCoordinateInGridSpace(const FIntVector& Coordinate, const FIntVector& GridSize);
 
 	/// <summary>
-	/// Checks if the buffer surrounding a room is empty.
-	/// </summary>
-	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
-	/// <param name="LevelTileData"> TMap containing the all the rooms and corridors currently generated in the level.</param>
-	/// <param name="RoomCoordinate"> The coordinate of the room we are checking the buffer of. </param>
-	/// <param name="RoomSectionCoordinate"> The coordinate of the current room section we are checking the buffer of. </param>
-	/// <param name="RoomRotation"> The rotation of the room in world space. </param>
-	/// <param name="TileSize"> The size of the room in the level grid space. </param>
-	/// <returns> True if there is nothing in the room's buffer space. </returns>
-	static bool IsRoomBufferEmpty(const FLevelGenerationSettings& LevelGenerationSettings, const TMap<FIntVector, FTileData>& LevelTileData, const FIntVector& RoomCoordinate, const FIntVector& RoomSectionCoordinate, const FRotator& RoomRotation, const TSet<FIntVector>& TileSize);
-
-	/// <summary>
-	/// An altered version of the A* Pathfinding algorithm. Used to build a path between two access points in 3D space using special corridor structures, e.g. Stairways, elevators.
+	/// Starts an A* Pathfinding search between two access points, the search is then run by StepAdvancedAStarPathfinding.
 	/// </summary>
+	/// <param name="Search"> Returned state of the search. </param>
 	/// <param name="StartLocation"> The starting point of the path. </param>
 	/// <param name="EndLocation"> The end goal of the path. </param>
-	/// <param name="PathData"> TMap containing all the data of the generated path. </param>
-	/// <param name="PathGenerationDataArray"> Array containing all the paths that need to be built. </param>
 	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
 	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
-	/// <returns> True if the path is successfully created. </returns>
-	static bool AdvancedAStarPathfinding(FIntVector StartLocation, FIntVector EndLocation, TMap<FIntVector, FAdvancedPathNode>& PathData, const TArray<FPathGenerationData>& PathGenerationDataArray, FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData);
+	static void BeginAdvancedAStarPathfinding(FAdvancedPathSearch& Search, FIntVector StartLocation, FIntVector EndLocation, FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData);
 
 	/// <summary>
-	/// Creates tile data from the provided corridor tile data.
+	/// Evaluates up to MaxExpansions nodes of an A* Pathfinding search, the result of the search is set once it has finished.
 	/// </summary>
-	/// <param name="CorridorTileData"> The data we are going to convert into an FTileData. </param>
-	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates. </param>
-	/// <param name="LevelStream"> The seed of the level, determines how randomisation is handled in the level generation. </param>
-	/// <returns> FTileData made from the corridor tile data. </returns>
-	static FTileData GetTileDataFromCorridorTileData(FCorridorTileData CorridorTileData, FLevelGenerationSettings& LevelGenerationSettings, const FRandomStream& LevelStream);
+	/// <param name="Search"> The state of the search. </param>
+	/// <param name="MaxExpansions"> The maximum number of nodes to evaluate. </param>
+	/// <param name="PathGenerationDataArray"> Array containing all the paths that need to be built. </param>
+	/// <param name="LevelGenerationSettings"> The settings that determine how the level generates.</param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <returns> The number of nodes evaluated. </returns>
+	static int32 StepAdvancedAStarPathfinding(FAdvancedPathSearch& Search, int32 MaxExpansions, const TArray<FPathGenerationData>& PathGenerationDataArray, FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData);
 
 	/// <summary>
 	/// Creates tile data from the provided special corridor tile data and adds it to the generated level data.
@@ -294,7 +672,7 @@ private:
 	/// <param name="InPreviousPath"> TMap containing all the previous evaluated path nodes needed to reach this node. </param>
 	/// <param name="StartLocation"> The starting point of the path. </param>
 	/// <param name="EndLocation"> The end goal of the path. </param>
-	static void UpdateAdvancedNode(FAdvancedPathNode& AdvancedPathNode, FLevelGenerationSettings LevelGenerationSettings, FGeneratedLevelData GeneratedLevelData, FIntVector InSpecialPathOriginVector, FIntVector InCurrentCoordinate, FIntVector InExitLocation, ESpecialPathType InSpecialPathType, FSpecialPathInfo InSpecialPathInfo, FRotator InSpecialPathRotation, TMap<FIntVector, FAdvancedPathNode*> InPreviousPath, FIntVector StartLocation, FIntVector EndLocation);
+	static void UpdateAdvancedNode(FAdvancedPathNode& AdvancedPathNode, const FLevelGenerationSettings& LevelGenerationSettings, const FGeneratedLevelData& GeneratedLevelData, FIntVector InSpecialPathOriginVector, FIntVector InCurrentCoordinate, FIntVector InExitLocation, ESpecialPathType InSpecialPathType, const FSpecialPathInfo& InSpecialPathInfo, FRotator InSpecialPathRotation, const TMap<FIntVector, FAdvancedPathNode*>& InPreviousPath, FIntVector StartLocation, FIntVector EndLocation);
 
 	/// <summary>
 	/// Takes the adjacent access points of the corridor tile data and adds them as used directions to the specified access point of the tile data.
@@ -302,7 +680,7 @@ private:
 	/// <param name="TileData"> The FTileData of the corridor section. </param>
 	/// <param name="AccessPointCoordinate"> The location of the access point that needs to be updated. </param>
 	/// <param name="CorridorTileData"> The FCorridorTileData of the corridor section. </param>
-	static void AddUsedAccessPointsToTileData(FTileData& TileData, FIntVector AccessPointCoordinate, FCorridorTileData CorridorTileData);
+	static void AddUsedAccessPointsToTileData(FTileData& TileData, FIntVector AccessPointCoordinate, const FCorridorTileData& CorridorTileData);
 
 	/// <summary>
 	/// Finds the parent node of the node at the target coordinate.
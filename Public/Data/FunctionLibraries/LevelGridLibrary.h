@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Data/LevelGenerationData.h"
+#include "LevelGridLibrary.generated.h"
+
+/**
+ * Blueprint access to the tiles of the generated level by coordinate, reading through the level's tile grid when it has been built.
+ */
+UCLASS()
+class PROJECTSCIFI_API ULevelGridLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+
+	/// <summary>
+	/// Finds the tile data at the coordinate, sections of larger tiles are expanded from the tile they belong to.
+	/// </summary>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="Coordinate"> The coordinate in the level grid. </param>
+	/// <param name="OutTileData"> Returned tile data. </param>
+	/// <returns> True if a tile or section is at the coordinate. </returns>
+	UFUNCTION(BlueprintPure, Category = "Level Generation|Grid")
+	static bool GetTileDataAtCoordinate(const FGeneratedLevelData& GeneratedLevelData, FIntVector Coordinate, FTileData& OutTileData);
+
+	/// <summary>
+	/// Finds the path data at the coordinate.
+	/// </summary>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="Coordinate"> The coordinate in the level grid. </param>
+	/// <param name="OutPathData"> Returned path data. </param>
+	/// <returns> True if a path is at the coordinate. </returns>
+	UFUNCTION(BlueprintPure, Category = "Level Generation|Grid")
+	static bool GetPathDataAtCoordinate(const FGeneratedLevelData& GeneratedLevelData, FIntVector Coordinate, FCorridorTileData& OutPathData);
+
+	/** Returns true if a tile or section is at the coordinate. */
+	UFUNCTION(BlueprintPure, Category = "Level Generation|Grid")
+	static bool IsCoordinateOccupied(const FGeneratedLevelData& GeneratedLevelData, FIntVector Coordinate);
+
+	/** Returns the coordinate of every tile and section in the level, in the tile grid's storage order once it has been built. */
+	UFUNCTION(BlueprintPure, Category = "Level Generation|Grid")
+	static TArray<FIntVector> GetOccupiedCoordinates(const FGeneratedLevelData& GeneratedLevelData);
+};
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Data/LevelGenerationData.h"
+#include "LevelLayoutCacheLibrary.generated.h"
+
+/**
+ * On-disk cache of generated levels, so a level generated from a predefined seed is only generated once.
+ * Each layout is stored in a compact versioned binary file keyed by the seed, the level generation settings and the contents of every data table the settings reference.
+ */
+UCLASS()
+class PROJECTSCIFI_API ULevelLayoutCacheLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+
+	/// <summary>
+	/// Loads the cached layout of the level if there is one, otherwise generates the level and caches it. The cache is only used if bUseLayoutCache and bUsePlayerSeed are enabled.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings for the level generation. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <param name="WorldRef"> The world the level is generated in. </param>
+	/// <returns> True if the level was loaded from the cache. </returns>
+	UFUNCTION(BlueprintCallable, Category = "Level Generation|Cache")
+	static bool GenerateOrLoadLevel(FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData, UObject* WorldRef);
+
+	/// <summary>
+	/// Replaces the generated level data with the cached layout for the settings.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings for the level generation. </param>
+	/// <param name="GeneratedLevelData"> Returned level data, only changed if the cache has a valid layout. </param>
+	/// <returns> True if a layout was loaded. </returns>
+	UFUNCTION(BlueprintCallable, Category = "Level Generation|Cache")
+	static bool LoadCachedLayout(const FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData);
+
+	/// <summary>
+	/// Writes the generated level data to the cache for the settings.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings the level was generated with. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the generated level's data. </param>
+	/// <returns> True if the file was written. </returns>
+	UFUNCTION(BlueprintCallable, Category = "Level Generation|Cache")
+	static bool SaveCachedLayout(const FLevelGenerationSettings& LevelGenerationSettings, const FGeneratedLevelData& GeneratedLevelData);
+
+	/** Returns the path of the cache file for the settings, which changes whenever the settings or a referenced data table change. */
+	UFUNCTION(BlueprintPure, Category = "Level Generation|Cache")
+	static FString GetCacheFilePath(const FLevelGenerationSettings& LevelGenerationSettings);
+
+	/** Returns the hash of every value in the settings. */
+	static uint32 GetSettingsHash(const FLevelGenerationSettings& LevelGenerationSettings);
+
+	/** Returns the hash of every row of the data tables and the special path data referenced by the settings. */
+	static uint32 GetContentHash(const FLevelGenerationSettings& LevelGenerationSettings);
+
+protected:
+
+	/** Reads a layout from the file contents, returns false if the file is not a valid layout for the keys. */
+	static bool ReadLayout(TArrayView<const uint8> FileData, const FLevelGenerationSettings& LevelGenerationSettings, uint32 SettingsHash, uint32 ContentHash, FGeneratedLevelData& GeneratedLevelData);
+};
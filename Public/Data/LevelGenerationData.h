@@ -5,12 +5,15 @@
 #include "CoreMinimal.h"
 #include "Engine/DataTable.h"
 #include "Data/FunctionLibraries/KruskalMSTLibrary.h"
+#include "Data/LevelTileStorage.h"
+#include <atomic>
 #include "LevelGenerationData.generated.h"
 
 class ULevelStreaming;
 class ULevelStreamingDynamic;
 class ULevelStreamingProcedural;
 class AInteractableActor_Elevator;
+struct FGeneratedLevelData;
 
 UENUM(BlueprintType, meta = (DisplayName = "Tile Type"))
 enum class ETileType : uint8
@@ -64,6 +67,55 @@ enum class EDirections : uint8
 	MAX				UMETA(Hidden)
 };
 
+/** Compact set of directions, bit N is set if the direction with value N is in the set. Iterates in direction order without allocating. */
+struct FDirectionMask
+{
+public:
+
+	// The number of directions that can be in a mask, EDirections::None is never added.
+	static constexpr int32 MaxDirections = (int32)EDirections::MAX - 1;
+
+	uint8 Bits = 0;
+
+	FDirectionMask() = default;
+
+	explicit FDirectionMask(uint8 InBits) : Bits(InBits) {}
+
+	explicit FDirectionMask(const TSet<EDirections>& Directions)
+	{
+		for (const EDirections Direction : Directions) { Add(Direction); }
+	}
+
+	static uint8 GetBit(EDirections Direction) { return uint8(1) << (uint8)Direction; }
+
+	void Add(EDirections Direction) { Bits |= GetBit(Direction); }
+	void Remove(EDirections Direction) { Bits &= ~GetBit(Direction); }
+	bool Contains(EDirections Direction) const { return (Bits & GetBit(Direction)) != 0; }
+	bool IsEmpty() const { return Bits == 0; }
+	int32 Num() const { return FMath::CountBits(Bits); }
+
+	/** Returns the directions in the mask as a set, for editor-facing data. */
+	TSet<EDirections> ToSet() const
+	{
+		TSet<EDirections> Directions;
+		for (const EDirections Direction : *this) { Directions.Add(Direction); }
+		return Directions;
+	}
+
+	/** Iterates the set bits from the lowest direction value up. */
+	struct FIterator
+	{
+		uint8 RemainingBits;
+
+		EDirections operator*() const { return (EDirections)FMath::CountTrailingZeros((uint32)RemainingBits); }
+		FIterator& operator++() { RemainingBits &= RemainingBits - 1; return *this; }
+		bool operator!=(const FIterator& Other) const { return RemainingBits != Other.RemainingBits; }
+	};
+
+	FIterator begin() const { return FIterator{ Bits }; }
+	FIterator end() const { return FIterator{ 0 }; }
+};
+
 UENUM(BlueprintType)
 enum class ESpecialPathType : uint8
 {
@@ -98,6 +150,46 @@ enum class EActorSlotType : uint8
 	MAX				UMETA(Hidden)
 };
 
+UENUM(BlueprintType, meta = (DisplayName = "Random Selection Method"))
+enum class ERandomSelectionMethod : uint8
+{
+	Legacy			UMETA(DisplayName = "Cumulative (Legacy)"),
+	AliasTable		UMETA(DisplayName = "Alias Table"),
+
+	MAX				UMETA(Hidden)
+};
+
+UENUM(BlueprintType, meta = (DisplayName = "Room Buffer Shape"))
+enum class ERoomBufferShape : uint8
+{
+	Star			UMETA(DisplayName = "Star (Legacy)"),
+	Box				UMETA(DisplayName = "Box"),
+
+	MAX				UMETA(Hidden)
+};
+
+UENUM(BlueprintType, meta = (DisplayName = "Room Placement Method"))
+enum class ERoomPlacementMethod : uint8
+{
+	Sequential		UMETA(DisplayName = "Sequential (Legacy)"),
+	CandidateBatch	UMETA(DisplayName = "Candidate Batch"),
+
+	MAX				UMETA(Hidden)
+};
+
+UENUM(BlueprintType, meta = (DisplayName = "Level Generation Stage"))
+enum class ELevelGenerationStage : uint8
+{
+	NotStarted		UMETA(DisplayName = "Not Started"),
+	Rooms			UMETA(DisplayName = "Rooms"),
+	RoomGraph		UMETA(DisplayName = "Room Graph"),
+	Corridors		UMETA(DisplayName = "Corridors"),
+	Finished		UMETA(DisplayName = "Finished"),
+	Cancelled		UMETA(DisplayName = "Cancelled"),
+
+	MAX				UMETA(Hidden)
+};
+
 
 /** Structure containing the A* Pathfinding information for a special path. */
 USTRUCT(BlueprintType, meta = (DisplayName = "Special Path Data"))
@@ -234,8 +326,31 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	TSet<EDirections> DirectionsInUse;
 
+	/** AccessibleDirections as a direction mask, rebuilt by UpdateDirectionMasks. */
+	FDirectionMask AccessibleMask;
+
+	/** DirectionsInUse as a direction mask, rebuilt by UpdateDirectionMasks and kept in sync by AddDirectionInUse. */
+	FDirectionMask InUseMask;
+
+	/** Rebuilds the direction masks from the editor-facing sets. */
+	void UpdateDirectionMasks()
+	{
+		AccessibleMask = FDirectionMask(AccessibleDirections);
+		InUseMask = FDirectionMask(DirectionsInUse);
+	}
+
+	/** Marks the direction as in use in both the set and the mask. */
+	void AddDirectionInUse(EDirections Direction)
+	{
+		DirectionsInUse.Add(Direction);
+		InUseMask.Add(Direction);
+	}
+
 };
 
+// Template id of a tile that has not been added to a template registry.
+static constexpr uint16 InvalidTileTemplateId = MAX_uint16;
+
 /** Structure containing information about a room used in the level generation. */
 USTRUCT(BlueprintType, meta = (DisplayName = "Tile Data"))
 struct FTileData
@@ -284,6 +399,132 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	UStaticMesh* MinimapMesh = nullptr;
 
+	/** Rebuilds the direction masks of every access point from the editor-facing sets. */
+	void UpdateDirectionMasks()
+	{
+		for (TPair<FIntVector, FTileAccessData>& CurrentAccessPoint : TileAccessPoints) { CurrentAccessPoint.Value.UpdateDirectionMasks(); }
+	}
+
+};
+
+/**
+ * The data shared by every tile placed from the same level data, stored once per generation in FTileTemplateRegistry.
+ * The assets it references are kept loaded by the data tables the tiles are read from.
+ */
+struct FTileTemplate
+{
+	TSoftObjectPtr<UWorld> TileMap;
+	TArray<TSoftObjectPtr<UWorld>> TileSubMaps;
+	TMap<EActorSlotType, TSoftObjectPtr<UWorld>> TileActorSlotMaps;
+	ETileType TileType = ETileType::Room_Basic;
+	TSet<FIntVector> TileSize;
+
+	// The access points with no directions in use, instances store their used directions in the order of this map.
+	TMap<FIntVector, FTileAccessData> TileAccessPoints;
+
+	UStaticMesh* MinimapMesh = nullptr;
+
+	/** Returns true if the shared data of the tile is the same as this template. */
+	bool Matches(const FTileData& TileData) const;
+
+	/** Returns the position of the access point in TileAccessPoints, or INDEX_NONE if the template does not have it. */
+	int32 GetAccessPointIndex(const FIntVector& AccessPoint) const;
+};
+
+/** The state of a single tile placed from a template, everything else is read from its FTileTemplate. */
+USTRUCT()
+struct FTileInstanceData
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	uint16 TemplateId = InvalidTileTemplateId;
+
+	UPROPERTY()
+	FRotator TileRotation = FRotator::ZeroRotator;
+
+	UPROPERTY()
+	FIntVector ParentRoomCoordinate = FIntVector::ZeroValue;
+
+	/** Reference to the level instance of this tile. */
+	UPROPERTY()
+	ULevelStreamingProcedural* LevelInstanceRef = nullptr;
+
+	// The directions in use of each access point, in the order of the template's access points.
+	TArray<FDirectionMask, TInlineAllocator<4>> UsedDirections;
+
+	/** Marks the direction of one of the template's access points as in use, access points the template does not have are ignored. */
+	void AddDirectionInUse(const FTileTemplate& Template, const FIntVector& AccessPoint, EDirections Direction)
+	{
+		const int32 AccessPointIndex = Template.GetAccessPointIndex(AccessPoint);
+		if (UsedDirections.IsValidIndex(AccessPointIndex)) { UsedDirections[AccessPointIndex].Add(Direction); }
+	}
+};
+
+/** Registry of the tile templates of a single generation, so each placed tile only needs a 16-bit id and its own state. */
+struct PROJECTSCIFI_API FTileTemplateRegistry
+{
+public:
+
+	/** Returns the id of the template with the same shared data as the tile, adding one if needed. Returns InvalidTileTemplateId once every id is in use. */
+	uint16 FindOrAddTemplate(const FTileData& TileData);
+
+	/** Returns the template with the id, or null if there is none. */
+	const FTileTemplate* GetTemplate(uint16 TemplateId) const { return Templates.IsValidIndex(TemplateId) ? &Templates[TemplateId] : nullptr; }
+
+	/** Returns the number of templates. */
+	int32 Num() const { return Templates.Num(); }
+
+	/** Builds the compact instance of a tile from the template FindOrAddTemplate returned for it. */
+	FTileInstanceData MakeInstance(const FTileData& TileData, uint16 TemplateId) const;
+
+	/// <summary>
+	/// Expands a tile instance back into full tile data.
+	/// </summary>
+	/// <param name="Instance"> The tile instance to expand. </param>
+	/// <param name="OutTileData"> Returned tile data, only the instance's own state is set if its template is not in this registry. </param>
+	/// <returns> True if the instance's template is in this registry. </returns>
+	bool ExpandInstance(const FTileInstanceData& Instance, FTileData& OutTileData) const;
+
+	/** Returns an estimate of the memory used by the templates, in bytes. */
+	SIZE_T GetAllocatedSize() const;
+
+protected:
+
+	/** Returns the hash used to find templates that may match the tile. */
+	static uint32 GetTemplateHash(const FTileData& TileData);
+
+	TArray<FTileTemplate> Templates;
+
+	// The ids of the templates with each hash.
+	TMultiMap<uint32, uint16> TemplateIds;
+};
+
+/** Structure containing a single section of a tile that covers several coordinates, the rest of its data is read from the tile at its parent coordinate. */
+USTRUCT(BlueprintType, meta = (DisplayName = "Tile Section Data"))
+struct FTileSectionData
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	/** The section's type, either Room_Section or Corridor_Section. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	ETileType TileType = ETileType::Room_Section;
+
+	/** The coordinate of the tile this section belongs to. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	FIntVector ParentCoordinate = FIntVector::ZeroValue;
+
+	/** The offset of this section in the parent's TileSize, before the parent's rotation is applied. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	FIntVector LocalOffset = FIntVector::ZeroValue;
+
+	/** Bit N is set if the section's access point is accessible from the direction with value N, zero if the section has no access point. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	uint8 AccessMask = 0;
+
 };
 
 /* Structure containing information about a corridor used in the level generation. */
@@ -321,6 +562,48 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	UStaticMesh* MinimapMesh = nullptr;
 
+	/** The directions in AdjacentAccessPoints as a direction mask. */
+	FDirectionMask AdjacentMask;
+
+	/** The tile type adjacent in each direction, indexed by direction value - 1. Only directions in AdjacentMask are valid. */
+	ETileType AdjacentTileTypes[FDirectionMask::MaxDirections] = { ETileType::Empty, ETileType::Empty, ETileType::Empty, ETileType::Empty, ETileType::Empty, ETileType::Empty };
+
+	/** Sets the tile type adjacent in the direction, in both the map and the fixed array. */
+	void SetAdjacentAccessPoint(EDirections Direction, ETileType AdjacentTileType)
+	{
+		AdjacentAccessPoints.Add(Direction, AdjacentTileType);
+
+		if (Direction == EDirections::None || Direction == EDirections::MAX) { return; }
+
+		AdjacentMask.Add(Direction);
+		AdjacentTileTypes[(uint8)Direction - 1] = AdjacentTileType;
+	}
+
+	/** Sets every adjacent access point of the other corridor on this one, replacing any in the same direction. */
+	void AppendAdjacentAccessPoints(const FCorridorTileData& Other)
+	{
+		for (const TPair<EDirections, ETileType>& CurrentAccessPoint : Other.AdjacentAccessPoints) { SetAdjacentAccessPoint(CurrentAccessPoint.Key, CurrentAccessPoint.Value); }
+	}
+
+	/** Returns the tile type adjacent in the direction, Empty if there is no access point in that direction. */
+	ETileType GetAdjacentTileType(EDirections Direction) const
+	{
+		return AdjacentMask.Contains(Direction) ? AdjacentTileTypes[(uint8)Direction - 1] : ETileType::Empty;
+	}
+
+	/** Rebuilds the direction mask and fixed array from the editor-facing map. */
+	void UpdateAdjacencyCache()
+	{
+		AdjacentMask = FDirectionMask();
+		for (const TPair<EDirections, ETileType>& CurrentAccessPoint : AdjacentAccessPoints)
+		{
+			if (CurrentAccessPoint.Key == EDirections::None || CurrentAccessPoint.Key == EDirections::MAX) { continue; }
+
+			AdjacentMask.Add(CurrentAccessPoint.Key);
+			AdjacentTileTypes[(uint8)CurrentAccessPoint.Key - 1] = CurrentAccessPoint.Value;
+		}
+	}
+
 };
 
 /** Structure containing information about a key room to be used in the level generation. */
@@ -440,6 +723,46 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "LevelUserSeed", MakeStructureDefaultValue = "0" , EditCondition = "bUsePlayerSeed", DisplayAfter = "bUsePlayerSeed", EditConditionHides))
 	int32 LevelUserSeed;
 
+	/** How rooms and corridors are randomly picked from their data tables. Legacy generates the same level as older versions for the same seed, Alias Table is faster but generates a different level. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "RandomSelectionMethod"))
+	ERandomSelectionMethod RandomSelectionMethod = ERandomSelectionMethod::Legacy;
+
+	/** How the tiles of the level are indexed by coordinate. Chunked Grid suits most levels, Sparse Morton Hash uses far less memory for very large grids with few tiles but picks room coordinates in a different order, generating a different level for the same seed. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "TileStorageType"))
+	ETileStorageType TileStorageType = ETileStorageType::ChunkedGrid;
+
+	/** If enabled, a level generated from a predefined seed is saved to disk and loaded on later runs instead of being generated again. The cached level is ignored whenever these settings or a referenced data table change. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "bUseLayoutCache", EditCondition = "bUsePlayerSeed"))
+	bool bUseLayoutCache = false;
+
+	/** If enabled, the rooms and corridors are generated on a worker thread and the level is populated once they are done, instead of blocking the game thread while the level generates. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "bGenerateLevelAsync"))
+	bool bGenerateLevelAsync = false;
+
+	/** If enabled, the level is generated on the game thread a few steps per frame, for platforms that cannot spare a worker thread. Ignored if bGenerateLevelAsync is enabled. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "bTimeSliceGeneration", EditCondition = "!bGenerateLevelAsync"))
+	bool bTimeSliceGeneration = false;
+
+	/** The time in milliseconds the time sliced generation can use each frame. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "GenerationFrameBudgetMs", ClampMin = "0.1", EditCondition = "bTimeSliceGeneration && !bGenerateLevelAsync"))
+	float GenerationFrameBudgetMs = 4.f;
+
+	/** The number of nodes the A* Pathfinding evaluates in each step of the time sliced generation. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "PathExpansionsPerStep", ClampMin = "1", EditCondition = "bTimeSliceGeneration && !bGenerateLevelAsync"))
+	int32 PathExpansionsPerStep = 16;
+
+	/** If enabled, the rooms start streaming in as soon as they are placed and each corridor as soon as it is added, while the rest of the level is still generating. Corridor maps are picked per coordinate so a corridor keeps the map it was streamed with, which generates different corridor maps than with this disabled. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "bPipelineLevelStreaming", EditCondition = "bGenerateLevelAsync"))
+	bool bPipelineLevelStreaming = false;
+
+	/** The number of levels after this one that are generated in the background while it is played, using the seeds that follow LevelUserSeed. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "PreGeneratedLevelCount", ClampMin = "0", EditCondition = "bUsePlayerSeed"))
+	int32 PreGeneratedLevelCount = 0;
+
+	/** The memory in megabytes the levels generated in the background can use, levels that do not fit are written to the layout cache if it is enabled. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "PreGenerationMemoryBudgetMB", ClampMin = "0", EditCondition = "bUsePlayerSeed && PreGeneratedLevelCount > 0"))
+	float PreGenerationMemoryBudgetMB = 64.f;
+
 	/** The standard size for a tile in the level grid. */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "TileSize", MakeStructureDefaultValue = "1000"))
 	int32 TileSize;
@@ -472,6 +795,10 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "ExtraCorridorChance", MakeStructureDefaultValue = "0.2f"), Category = "Corridors")
 	float ExtraCorridorChance = 0.2f;
 
+	/** The algorithm used to build the MST of the rooms, every algorithm produces the same corridors for the same seed. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "MinimumSpanningTreeAlgorithm"), Category = "Corridors")
+	EMinimumSpanningTreeAlgorithm MinimumSpanningTreeAlgorithm = EMinimumSpanningTreeAlgorithm::Kruskal;
+
 	/** Map of the node weights for each room/corridor type in the A* Pathfinding. */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "TileTypeWeight"), Category = "Corridors")
 	TMap<ETileType, float> TileTypeWeight;
@@ -483,6 +810,22 @@ public:
 	/** The size of the buffer surrounding rooms in the level grid, preventing other rooms from being generated inside that buffer. */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "RoomBufferSize", MakeStructureDefaultValue = "1"), Category = "Rooms")
 	int32 RoomBufferSize = 1;
+
+	/**
+	 * The shape of the buffer surrounding each section of a room.
+	 * Star only covers the coordinates in a straight line from the section along the 26 directions.
+	 * Box covers the whole cube around the section, so large buffers are tested with a few box sums instead of one test per coordinate.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "RoomBufferShape"), Category = "Rooms")
+	ERoomBufferShape RoomBufferShape = ERoomBufferShape::Star;
+
+	/** How rooms are placed in the level grid. Candidate Batch draws several placements at once from a sub-stream of the level seed and tests them in parallel. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "RoomPlacementMethod"), Category = "Rooms")
+	ERoomPlacementMethod RoomPlacementMethod = ERoomPlacementMethod::Sequential;
+
+	/** The number of placements drawn and tested together by the Candidate Batch room placement. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "RoomPlacementBatchSize", ClampMin = "1", EditCondition = "RoomPlacementMethod == ERoomPlacementMethod::CandidateBatch"), Category = "Rooms")
+	int32 RoomPlacementBatchSize = 16;
 	
 	/** The minimum amount of basic rooms to be generated in the level. */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "BasicRoomsMinimum", MakeStructureDefaultValue = "1"), Category = "Rooms")
@@ -516,11 +859,512 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Draw MST"), Category = "Debug")
 	bool bDrawMST = false;
 
+	/** If enabled, the discarded MST edges and the nodes explored by the A* Pathfinding are recorded so they can be displayed by the debug drawing. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Record Debug Data"), Category = "Debug")
+	bool bRecordDebugData = false;
+
 	/** If enabled, corridors will be generated in the level. */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "Generate Corridors"), Category = "Debug")
 	bool bGenerateCorridors= true;
 };
 
+/**
+ * Set of the empty coordinates in the level grid that a room can be placed at, a random empty coordinate can be picked in constant time.
+ * With the Sparse Morton Hash storage only the occupied coordinates are stored, sorted by grid index, and an empty coordinate is picked by counting the occupied coordinates before it.
+ */
+struct PROJECTSCIFI_API FFreeCellSet
+{
+public:
+
+	/// <summary>
+	/// Fills the set with every coordinate of the level grid that is not in the level tile data.
+	/// </summary>
+	/// <param name="InGridSize"> The size of the level grid. </param>
+	/// <param name="InStorageType"> The storage of the level's tiles, the set is sparse if it is the Sparse Morton Hash. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the rooms and corridors currently generated in the level. </param>
+	void Initialize(const FIntVector& InGridSize, ETileStorageType InStorageType, const FGeneratedLevelData& GeneratedLevelData);
+
+	/** Removes the coordinate from the set, the last coordinate in the set takes its place. */
+	void Occupy(const FIntVector& Coordinate);
+
+	/** Adds the coordinate back to the set if it is inside the level grid. */
+	void Release(const FIntVector& Coordinate);
+
+	/** Returns true if the set has been built for a level grid of this size and storage. */
+	bool IsInitializedFor(const FIntVector& InGridSize, ETileStorageType InStorageType) const { return bIsInitialized && GridSize == InGridSize && bIsSparse == (InStorageType == ETileStorageType::MortonHash); }
+
+	/** Returns the number of empty coordinates that can be picked. */
+	int32 Num() const;
+
+	/** Returns the empty coordinate at the index, in no particular order. The index must be less than Num. */
+	FIntVector GetFreeCell(int32 Index) const;
+
+protected:
+
+	/** Returns the index of the coordinate in the part of the level grid rooms can be placed in, or INDEX_NONE if rooms cannot be placed at the coordinate. */
+	int64 GetGridIndex(const FIntVector& Coordinate) const;
+
+	// The size of the level grid the set was built for.
+	FIntVector GridSize = FIntVector::ZeroValue;
+
+	// List of every empty coordinate, empty if the set is sparse.
+	TArray<FIntVector> FreeCells;
+
+	// The index of each grid coordinate in FreeCells, INDEX_NONE if the coordinate is occupied. Empty if the set is sparse.
+	TArray<int32> CellIndices;
+
+	// The grid index of every occupied coordinate in ascending order, only used if the set is sparse.
+	TArray<int64> OccupiedIndices;
+
+	bool bIsSparse = false;
+
+	bool bIsInitialized = false;
+};
+
+/** Picks a random index from a list of weights, using a single random draw per pick. */
+struct PROJECTSCIFI_API FWeightedRandomSelector
+{
+public:
+
+	/** Builds the cumulative weights and the alias table for the list of weights. */
+	void Initialize(const TArray<double>& InWeights);
+
+	/// <summary>
+	/// Randomly picks an index, the chance of each index being picked is its share of the total weight.
+	/// </summary>
+	/// <param name="LevelStream"> The seed of the level, determines how randomisation is handled in the level generation. </param>
+	/// <param name="SelectionMethod"> The method used to pick the index. </param>
+	/// <returns> The picked index, or INDEX_NONE if nothing can be picked. </returns>
+	int32 Pick(const FRandomStream& LevelStream, ERandomSelectionMethod SelectionMethod) const;
+
+protected:
+
+	// The weight of each index.
+	TArray<double> Weights;
+
+	// The start of each index's range of random results in the legacy method.
+	TArray<double> CumulativeStarts;
+
+	double TotalWeight = 0.0;
+
+	// The chance of each column of the alias table picking its own index.
+	TArray<double> AliasProbabilities;
+
+	// The index each column of the alias table picks otherwise.
+	TArray<int32> AliasIndices;
+};
+
+/** The rows of a data table and a selector to randomly pick one of them. */
+struct FDataTableSelection
+{
+	// The rows of the data table, in the order of GetRowNames.
+	TArray<uint8*> Rows;
+
+	FWeightedRandomSelector Selector;
+};
+
+/** The data tables of a room list map and a selector to randomly pick one of them. */
+struct FRoomListSelection
+{
+	// The room lists of the map, in the order of its keys.
+	TArray<UDataTable*> RoomLists;
+
+	FWeightedRandomSelector Selector;
+};
+
+/** Structure caching the random selection data of the data tables used in the level generation, built once per generation. */
+struct FRandomSelectionCache
+{
+	// The method used to pick rooms and corridors.
+	ERandomSelectionMethod SelectionMethod = ERandomSelectionMethod::Legacy;
+
+	// The rows and selector of each data table.
+	TMap<const UDataTable*, FDataTableSelection> DataTables;
+
+	// The room lists and selector of each room list map.
+	TMap<const TMap<UDataTable*, double>*, FRoomListSelection> RoomLists;
+
+	void Reset(ERandomSelectionMethod InSelectionMethod)
+	{
+		SelectionMethod = InSelectionMethod;
+		DataTables.Reset();
+		RoomLists.Reset();
+	}
+};
+
+/** Bitset of the occupied coordinates in the level grid, each row along the X axis is stored in 64-bit words. With the Sparse Morton Hash storage only the words holding an occupied coordinate are stored. */
+struct PROJECTSCIFI_API FOccupancyBitset
+{
+public:
+
+	/// <summary>
+	/// Builds the bitset from every coordinate in the level tile data.
+	/// </summary>
+	/// <param name="InGridSize"> The size of the level grid. </param>
+	/// <param name="InStorageType"> The storage of the level's tiles, the bitset is sparse if it is the Sparse Morton Hash. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the rooms and corridors currently generated in the level. </param>
+	void Initialize(const FIntVector& InGridSize, ETileStorageType InStorageType, const FGeneratedLevelData& GeneratedLevelData);
+
+	/** Marks the coordinate as occupied, coordinates outside the level grid are ignored. */
+	void SetOccupied(const FIntVector& Coordinate);
+
+	/** Returns true if the coordinate is occupied. */
+	bool IsOccupied(const FIntVector& Coordinate) const;
+
+	/** Returns true if the bitset has been built for a level grid of this size and storage. */
+	bool IsInitializedFor(const FIntVector& InGridSize, ETileStorageType InStorageType) const { return bIsInitialized && GridSize == InGridSize && bIsSparse == (InStorageType == ETileStorageType::MortonHash); }
+
+	/// <summary>
+	/// Returns 64 bits of a row of the level grid, bit N is set if the coordinate at StartX + N is occupied. Coordinates outside the level grid are empty.
+	/// </summary>
+	/// <param name="Y"> The Y coordinate of the row. </param>
+	/// <param name="Z"> The Z coordinate of the row. </param>
+	/// <param name="StartX"> The X coordinate of the first bit. </param>
+	/// <returns> The occupancy of the 64 coordinates. </returns>
+	uint64 GetRowBits(int32 Y, int32 Z, int32 StartX) const;
+
+	const FIntVector& GetGridSize() const { return GridSize; }
+
+protected:
+
+	/** Returns the word of a row of the level grid, the coordinates must be inside the level grid. */
+	uint64 GetWord(int32 WordIndex, int32 Y, int32 Z) const;
+
+	// The size of the level grid the bitset was built for.
+	FIntVector GridSize = FIntVector::ZeroValue;
+
+	// The number of words needed to store a row of the level grid.
+	int32 WordsPerRow = 0;
+
+	// The occupancy of every coordinate in the level grid, empty if the bitset is sparse.
+	TArray<uint64> Words;
+
+	// The words holding an occupied coordinate, keyed by the word's index in the row and the row's Y and Z. Only used if the bitset is sparse.
+	TMap<FIntVector, uint64> SparseWords;
+
+	bool bIsSparse = false;
+
+	bool bIsInitialized = false;
+};
+
+/**
+ * Fenwick tree of the occupancy of the level grid, the occupied coordinates inside any box can be counted in logarithmic time and the tree is kept up to date as tiles are added.
+ * With the Sparse Morton Hash storage only the non-zero partial sums are stored, a few per axis bit of the level grid for each occupied coordinate.
+ */
+struct PROJECTSCIFI_API FOccupancyFenwickTree
+{
+public:
+
+	/// <summary>
+	/// Builds the tree from every coordinate in the level tile data.
+	/// </summary>
+	/// <param name="InGridSize"> The size of the level grid. </param>
+	/// <param name="InStorageType"> The storage of the level's tiles, the tree is sparse if it is the Sparse Morton Hash. </param>
+	/// <param name="GeneratedLevelData"> Struct containing all the rooms and corridors currently generated in the level. </param>
+	void Initialize(const FIntVector& InGridSize, ETileStorageType InStorageType, const FGeneratedLevelData& GeneratedLevelData);
+
+	/** Marks the coordinate as occupied, coordinates outside the level grid or already occupied are ignored. */
+	void SetOccupied(const FIntVector& Coordinate);
+
+	/** Returns true if the tree has been built for a level grid of this size and storage. */
+	bool IsInitializedFor(const FIntVector& InGridSize, ETileStorageType InStorageType) const { return bIsInitialized && GridSize == InGridSize && bIsSparse == (InStorageType == ETileStorageType::MortonHash); }
+
+	/// <summary>
+	/// Counts the occupied coordinates inside the box, the parts of the box outside the level grid are empty.
+	/// </summary>
+	/// <param name="BoxMin"> The smallest coordinate of the box. </param>
+	/// <param name="BoxMax"> The largest coordinate of the box, inclusive. </param>
+	/// <returns> The number of occupied coordinates inside the box. </returns>
+	int32 CountOccupied(const FIntVector& BoxMin, const FIntVector& BoxMax) const;
+
+protected:
+
+	/** Returns the number of occupied coordinates from the origin up to and including the coordinate. */
+	int32 GetPrefixSum(int32 X, int32 Y, int32 Z) const;
+
+	int32 GetGridIndex(const FIntVector& Coordinate) const { return (Coordinate.Z * GridSize.Y + Coordinate.Y) * GridSize.X + Coordinate.X; }
+
+	// The size of the level grid the tree was built for.
+	FIntVector GridSize = FIntVector::ZeroValue;
+
+	// The partial sums of the tree, stored with the same layout as the level grid. Empty if the tree is sparse.
+	TArray<int32> Tree;
+
+	// The coordinates already added to the tree. Empty if the tree is sparse.
+	TBitArray<> OccupiedCells;
+
+	// The non-zero partial sums of the tree, keyed by the coordinate they are stored at. Only used if the tree is sparse.
+	TMap<FIntVector, int32> SparseTree;
+
+	// The coordinates already added to the tree, only used if the tree is sparse.
+	TSet<FIntVector> SparseOccupiedCells;
+
+	bool bIsSparse = false;
+
+	bool bIsInitialized = false;
+};
+
+/** The cells of a room and its buffer for a single rotation, stored as bitmask rows so a placement can be tested a word at a time. */
+struct PROJECTSCIFI_API FCompiledRoomFootprint
+{
+public:
+
+	/** Returns the index of the first word of a row of the bitmasks. */
+	int32 GetRowIndex(int32 Y, int32 Z) const { return (Z * Size.Y + Y) * WordsPerRow; }
+
+	// False if the room has no access points or sections and can never be placed.
+	bool bIsValid = false;
+
+	// The offset of the first bit of the bitmasks from the room's coordinate.
+	FIntVector Min = FIntVector::ZeroValue;
+
+	// The size of the box covered by the bitmasks.
+	FIntVector Size = FIntVector::ZeroValue;
+
+	// The smallest and largest offsets of the room's sections from the room's coordinate.
+	FIntVector FootprintMin = FIntVector::ZeroValue;
+	FIntVector FootprintMax = FIntVector::ZeroValue;
+
+	// The offsets of the room's sections from the room's coordinate.
+	TArray<FIntVector> SectionOffsets;
+
+	// True if the room's sections fill the box between FootprintMin and FootprintMax.
+	bool bFootprintIsBox = false;
+
+	// The number of words in each row of the bitmasks.
+	int32 WordsPerRow = 0;
+
+	// The cells of the room's sections.
+	TArray<uint64> FootprintRows;
+
+	// The cells of the buffer surrounding the room, not including the room's sections.
+	TArray<uint64> BufferRows;
+};
+
+/** A room, rotation and coordinate drawn while trying to place a room in the level grid. */
+struct FRoomPlacementCandidate
+{
+	// The room being placed, null if the room list had no room to give.
+	const FTileGenerationData* TileGenerationData = nullptr;
+
+	// The rotation of the room in world space.
+	FRotator RoomRotation = FRotator::ZeroRotator;
+
+	// The coordinate the room will be placed at.
+	FIntVector TileCoordinate = FIntVector::ZeroValue;
+
+	// False if there was no empty coordinate to place the room at.
+	bool bEmptyCoordinateFound = false;
+
+	// The compiled footprint of the room at its rotation.
+	const FCompiledRoomFootprint* RoomFootprint = nullptr;
+};
+
+/** Structure containing how successful the placement of a type of room was. */
+USTRUCT(BlueprintType)
+struct FRoomPlacementStats
+{
+	GENERATED_BODY()
+public:
+
+	/** The number of rooms of this type the level generation tried to place. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	int32 RoomsRequested = 0;
+
+	/** The number of rooms of this type placed in the level grid. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	int32 RoomsPlaced = 0;
+
+	/** The number of placements tested while placing rooms of this type. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	int32 PlacementsTested = 0;
+
+	/** Returns the fraction of the requested rooms that were placed. */
+	float GetSuccessRate() const { return RoomsRequested > 0 ? (float)RoomsPlaced / RoomsRequested : 0.f; }
+};
+
+/** Structure containing statistics recorded during level generation. */
+USTRUCT(BlueprintType)
+struct FLevelGenerationStats
+{
+	GENERATED_BODY()
+public:
+
+	/** The placement statistics of each type of room. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	TMap<ETileType, FRoomPlacementStats> RoomPlacements;
+
+	/** The time in seconds spent placing the rooms. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	double RoomsTime = 0.0;
+
+	/** The time in seconds spent building the room graph and its Minimum Spanning Tree. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	double RoomGraphTime = 0.0;
+
+	/** The time in seconds spent building the corridors. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	double CorridorsTime = 0.0;
+
+	/** The number of corridors the level generation tried to build, one for each edge of the MST + extra paths. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	int32 CorridorsRequested = 0;
+
+	/** The number of corridors built. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	int32 CorridorsBuilt = 0;
+
+	/** The number of nodes evaluated by the A* Pathfinding while building the corridors. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	int64 PathExpansions = 0;
+
+	/** The edges of the MST + extra paths no corridor could be built for. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	TArray<FEdgeInfo> FailedEdges;
+
+	void Reset()
+	{
+		RoomPlacements.Reset();
+		RoomsTime = 0.0;
+		RoomGraphTime = 0.0;
+		CorridorsTime = 0.0;
+		CorridorsRequested = 0;
+		CorridorsBuilt = 0;
+		PathExpansions = 0;
+		FailedEdges.Reset();
+	}
+};
+
+/** Structure containing the nodes explored by the A* Pathfinding while building a corridor. */
+struct FCorridorSearchDebugData
+{
+	// The starting point of the path.
+	FIntVector PathStart = FIntVector::ZeroValue;
+
+	// The end goal of the path.
+	FIntVector PathEnd = FIntVector::ZeroValue;
+
+	// True if the path was found.
+	bool bPathFound = false;
+
+	// List of the nodes that were evaluated by the search.
+	TArray<FIntVector> ExploredNodes;
+};
+
+/** Structure containing the intermediate data of the level generation, only recorded if bRecordDebugData is enabled. */
+struct FLevelGenerationDebugData
+{
+	// List of the edges of the room graph which are not corridors.
+	TArray<FEdgeInfo> DiscardedEdges;
+
+	// List of every A* Pathfinding search made while generating the corridors.
+	TArray<FCorridorSearchDebugData> CorridorSearches;
+
+	void Reset()
+	{
+		DiscardedEdges.Reset();
+		CorridorSearches.Reset();
+	}
+};
+
+/**
+ * Snapshot of the level generation settings compiled at the start of GenerateLevel, with every map the generation looks up in its hot loops flattened into arrays indexed by enum value.
+ * It is not changed again until the next generation.
+ */
+struct PROJECTSCIFI_API FCompiledLevelGenSettings
+{
+public:
+
+	/** Builds the snapshot from the settings, SpecialPathData must already be loaded. */
+	void Compile(const FLevelGenerationSettings& LevelGenerationSettings);
+
+	bool IsCompiled() const { return bIsCompiled; }
+
+	/** Returns the A* weight of a node of the tile type, 0 if the settings have no weight for it. */
+	float GetTileTypeWeight(ETileType TileType) const { return TileTypeWeights[(uint8)TileType]; }
+
+	/** Returns the data table of the corridor type, or null if there is none. */
+	UDataTable* GetCorridorLevelDataTable(ECorridorType CorridorType) const { return CorridorLevelDataTables[(uint8)CorridorType]; }
+
+	/** Returns the data table of the special path type, or null if there is none. */
+	UDataTable* GetSpecialPathLevelDataTable(ESpecialPathType SpecialPathType) const { return SpecialPathLevelDataTables[(uint8)SpecialPathType]; }
+
+	/** Returns the pathfinding information of the special path type, or null if it is not in the special path data. */
+	const FSpecialPathInfo* GetSpecialPathInfo(ESpecialPathType SpecialPathType) const { return SpecialPathInfos[(uint8)SpecialPathType]; }
+
+	/** Returns true if the special path type is allowed in the level. */
+	bool IsSpecialPathTypeAllowed(ESpecialPathType SpecialPathType) const { return (AllowedSpecialPathMask & (1u << (uint8)SpecialPathType)) != 0; }
+
+	/** Returns the allowed special path types in the order of the settings map, which decides the order they are tried in. */
+	TArrayView<const ESpecialPathType> GetAllowedSpecialPathTypes() const { return TArrayView<const ESpecialPathType>(AllowedSpecialPathTypes, AllowedSpecialPathTypeCount); }
+
+	/** Returns the special path data asset used by the level. */
+	const USpecialPathData* GetSpecialPathData() const { return SpecialPathData; }
+
+protected:
+
+	static_assert((int32)ESpecialPathType::MAX <= 32, "AllowedSpecialPathMask needs a bit for every special path type.");
+
+	float TileTypeWeights[(int32)ETileType::MAX + 1] = {};
+
+	UDataTable* CorridorLevelDataTables[(int32)ECorridorType::MAX + 1] = {};
+
+	UDataTable* SpecialPathLevelDataTables[(int32)ESpecialPathType::MAX + 1] = {};
+
+	// Points into SpecialPathData, which is kept loaded by the settings.
+	const FSpecialPathInfo* SpecialPathInfos[(int32)ESpecialPathType::MAX + 1] = {};
+
+	uint32 AllowedSpecialPathMask = 0;
+
+	ESpecialPathType AllowedSpecialPathTypes[(int32)ESpecialPathType::MAX] = {};
+
+	int32 AllowedSpecialPathTypeCount = 0;
+
+	const USpecialPathData* SpecialPathData = nullptr;
+
+	bool bIsCompiled = false;
+};
+
+/** Progress of a level generation, shared between the thread generating the level and the code waiting on it. */
+struct PROJECTSCIFI_API FLevelGenerationProgress
+{
+public:
+
+	/** Requests the generation to stop before its next stage or corridor. */
+	void Cancel() { bCancelRequested = true; }
+
+	/** Returns true if the generation has been asked to stop. */
+	bool IsCancelled() const { return bCancelRequested; }
+
+	/** Returns how much of the generation has finished, from 0 to 1. */
+	float GetProgress() const { return Progress; }
+
+	/** Returns the stage the generation is in. */
+	ELevelGenerationStage GetStage() const { return Stage; }
+
+	/** Moves the generation on to the stage, with the given progress. */
+	void SetStage(ELevelGenerationStage InStage, float InProgress) { Stage = InStage; Progress = InProgress; }
+
+	/** Updates the progress without changing the stage. */
+	void SetProgress(float InProgress) { Progress = InProgress; }
+
+public:
+
+	/** Called on the thread generating the level once every room is placed, before the corridors are built. Must be set before the generation starts. */
+	TFunction<void(FGeneratedLevelData&)> OnRoomsGenerated;
+
+	/** Called on the thread generating the level each time a corridor is added, with the coordinates of the paths it added or changed. Must be set before the generation starts. */
+	TFunction<void(FGeneratedLevelData&, const TArray<FIntVector>&)> OnCorridorCommitted;
+
+protected:
+
+	std::atomic<float> Progress{ 0.f };
+
+	std::atomic<ELevelGenerationStage> Stage{ ELevelGenerationStage::NotStarted };
+
+	std::atomic<bool> bCancelRequested{ false };
+};
+
 /** Structure containing all the information created during level generation. */
 USTRUCT(BlueprintType)
 struct FGeneratedLevelData
@@ -531,9 +1375,13 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "LevelStream", MakeStructureDefaultValue = "(InitialSeed=0,Seed=0)"))
 	FRandomStream LevelStream;
 
-	/** Map containing all the tiles in the level grid. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "LevelTileData", MakeStructureDefaultValue = "()"))
-	TMap<FIntVector, FTileData> LevelTileData;
+	/** Map containing the own state of every tile in the level grid, the data the tiles share is in TileTemplates. Blueprints read the full tile data with ULevelGridLibrary::GetTileDataAtCoordinate. */
+	UPROPERTY()
+	TMap<FIntVector, FTileInstanceData> LevelTileData;
+
+	/** Map containing the sections of every tile that covers several coordinates, the tile itself is in LevelTileData at the section's parent coordinate. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "LevelSectionData", MakeStructureDefaultValue = "()"))
+	TMap<FIntVector, FTileSectionData> LevelSectionData;
 
 	/** Map containing all the paths in the level grid, used in the A* Pathfinding. */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (DisplayName = "LevelPathData", MakeStructureDefaultValue = "()"))
@@ -541,6 +1389,113 @@ public:
 
 	/** List of all the edges in the Minimum Spanning Tree. */
 	TArray<FEdgeInfo> MinimumSpanningTree;
+
+	/** The Delaunay Tetrahedralization of the rooms in the level, kept so the room graph can be updated when rooms are added or removed. */
+	FTetrahedralizationData RoomTetrahedralization;
+
+	/** List of the edges in the Minimum Spanning Tree of the room graph, without the extra corridors. */
+	TArray<FEdgeInfo> RoomMinimumSpanningTree;
+
+	/** Statistics recorded during the level generation. */
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, meta = (DisplayName = "Stats"))
+	FLevelGenerationStats Stats;
+
+	/** Data recorded for the debug drawing of the level generation. */
+	FLevelGenerationDebugData DebugData;
+
+	/** Set of the empty coordinates in the level grid, kept up to date by AddTile. */
+	FFreeCellSet FreeCells;
+
+	/** Occupancy of the level grid used to test room placements, kept up to date by AddTile. */
+	FOccupancyBitset Occupancy;
+
+	/** Occupancy of the level grid used to test box shaped room buffers, kept up to date by AddTile. */
+	FOccupancyFenwickTree OccupancyTree;
+
+	/** Index of the tiles, sections and paths at each coordinate of the level grid, kept up to date by AddTile, AddSection and AddPath. */
+	FLevelTileIndex TileGrid;
+
+	/** The random selection data of each data table used in the level generation. */
+	FRandomSelectionCache RandomSelectionCache;
+
+	/** The footprint of each room and rotation used in the level generation, compiled once per generation. */
+	TMap<TPair<const FTileGenerationData*, int32>, FCompiledRoomFootprint> CompiledRoomFootprints;
+
+	/** The level generation settings compiled for the hot loops of the generation, built at the start of GenerateLevel. */
+	FCompiledLevelGenSettings CompiledSettings;
+
+	/** The shared data of every tile in the level, a new registry is made for each generation so level instances from an earlier one keep theirs. */
+	TSharedPtr<FTileTemplateRegistry> TileTemplates;
+
+	/** Progress of the generation when it runs off the game thread, null when the level is generated synchronously. */
+	TSharedPtr<FLevelGenerationProgress> Progress;
+
+	/** Registers the tile's template, adds its instance to LevelTileData and marks its coordinate as occupied. Every tile must be added through here to keep FreeCells correct. */
+	void AddTile(const FIntVector& Coordinate, const FTileData& TileData);
+
+	/** Adds the section to LevelSectionData and marks its coordinate as occupied. */
+	void AddSection(const FIntVector& Coordinate, const FTileSectionData& SectionData);
+
+	/** Adds the path to LevelPathData and rebuilds its adjacency cache. Every path must be added through here to keep TileGrid correct. */
+	void AddPath(const FIntVector& Coordinate, const FCorridorTileData& PathData);
+
+	/** Rebuilds TileGrid for the level grid from every tile, section and path currently in the level, using the chosen storage. */
+	void BuildTileGrid(const FIntVector& GridSize, ETileStorageType StorageType);
+
+	/** Returns the tile at the coordinate, or null if there is none. Uses TileGrid once it has been built. */
+	const FTileInstanceData* FindTile(const FIntVector& Coordinate) const;
+	FTileInstanceData* FindTile(const FIntVector& Coordinate) { return const_cast<FTileInstanceData*>(AsConst(*this).FindTile(Coordinate)); }
+
+	/** Returns the template holding the shared data of the tile, or null if it is not in TileTemplates. */
+	const FTileTemplate* GetTileTemplate(const FTileInstanceData& TileInstance) const { return TileTemplates.IsValid() ? TileTemplates->GetTemplate(TileInstance.TemplateId) : nullptr; }
+
+	/** Returns the section at the coordinate, or null if there is none. Uses TileGrid once it has been built. */
+	const FTileSectionData* FindSection(const FIntVector& Coordinate) const;
+
+	/** Returns the path at the coordinate, or null if there is none. Uses TileGrid once it has been built. */
+	const FCorridorTileData* FindPath(const FIntVector& Coordinate) const;
+	FCorridorTileData* FindPath(const FIntVector& Coordinate) { return const_cast<FCorridorTileData*>(AsConst(*this).FindPath(Coordinate)); }
+
+	/** Returns true if a tile or a section is at the coordinate. */
+	bool ContainsTile(const FIntVector& Coordinate) const { return FindTile(Coordinate) || FindSection(Coordinate); }
+
+	/** Returns true if a path is at the coordinate. */
+	bool ContainsPath(const FIntVector& Coordinate) const { return FindPath(Coordinate) != nullptr; }
+
+	/** Returns true if the generation of the level has been asked to stop. */
+	bool IsGenerationCancelled() const { return Progress.IsValid() && Progress->IsCancelled(); }
+
+	/** Reports the stage of the generation if it is being tracked. */
+	void SetGenerationStage(ELevelGenerationStage Stage, float InProgress) const { if (Progress.IsValid()) { Progress->SetStage(Stage, InProgress); } }
+
+	/** Reports the progress of the generation if it is being tracked. */
+	void SetGenerationProgress(float InProgress) const { if (Progress.IsValid()) { Progress->SetProgress(InProgress); } }
+
+	/** Reports that every room is placed if anything is waiting on the rooms. */
+	void NotifyRoomsGenerated() { if (Progress.IsValid() && Progress->OnRoomsGenerated) { Progress->OnRoomsGenerated(*this); } }
+
+	/** Returns true if anything is waiting on each corridor as it is added. */
+	bool IsCorridorCommitObserved() const { return Progress.IsValid() && Progress->OnCorridorCommitted; }
+
+	/** Reports the coordinates of the paths a corridor added or changed if anything is waiting on them. */
+	void NotifyCorridorCommitted(const TArray<FIntVector>& Coordinates) { if (IsCorridorCommitObserved()) { Progress->OnCorridorCommitted(*this, Coordinates); } }
+
+	/** Returns an estimate of the memory used by the tiles, sections, paths and room graph of the level, in bytes. Does not include the grid sized data released by ReleaseGenerationData. */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Frees FreeCells, Occupancy, OccupancyTree and TileGrid, which grow with the size of the level grid and are only needed while generating. Lookups use the maps until BuildTileGrid is called again. */
+	void ReleaseGenerationData();
+
+	/** Returns the number of coordinates covered by tiles and sections. */
+	int32 GetTileCount() const { return LevelTileData.Num() + LevelSectionData.Num(); }
+
+	/// <summary>
+	/// Builds the full tile data at the coordinate, sections are expanded from their parent tile.
+	/// </summary>
+	/// <param name="Coordinate"> The coordinate of the tile or section. </param>
+	/// <param name="OutTileData"> Returned tile data. </param>
+	/// <returns> True if a tile or section is at the coordinate. </returns>
+	bool GetTileData(const FIntVector& Coordinate, FTileData& OutTileData) const;
 };
 
 /** Structure containing information needed to set up the bottom of an elevator shaft. */
@@ -610,4 +1565,34 @@ public:
 
 	FTransform InteractableTransform{FRotator::ZeroRotator, FVector::ZeroVector, FVector(1.f, 1.f, 1.f)};
 
+};
+
+/** Structure containing the level instances of a tile streamed in while the level is still generating. */
+USTRUCT(BlueprintType)
+struct FPipelinedTileInstances
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	/** The map the tile was streamed with. */
+	UPROPERTY(BlueprintReadWrite)
+	TSoftObjectPtr<UWorld> TileMap;
+
+	/** The sublevels the tile was streamed with. */
+	UPROPERTY(BlueprintReadWrite)
+	TArray<TSoftObjectPtr<UWorld>> TileSubMaps;
+
+	/** The rotation the tile was streamed with. */
+	UPROPERTY(BlueprintReadWrite)
+	FRotator TileRotation = FRotator::ZeroRotator;
+
+	/** The instance of the tile's map, tiles whose map could not be instanced are not pipelined. */
+	UPROPERTY(BlueprintReadWrite)
+	ULevelStreamingProcedural* BaseLevelInstance = nullptr;
+
+	/** Every instance streamed for the tile, its map and its sublevels. */
+	UPROPERTY(BlueprintReadWrite)
+	TArray<ULevelStreamingProcedural*> LevelInstances;
+
 };
\ No newline at end of file
@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Misc/QueuedThreadPool.h"
+#include "UObject/GCObject.h"
+#include "Data/LevelGenerationData.h"
+
+class FLevelGenerationTask;
+
+/** Tiles of a level that is still being generated, keyed by coordinate, along with the templates their shared data is read from. */
+struct PROJECTSCIFI_API FLevelGenerationTiles
+{
+	TMap<FIntVector, FTileInstanceData> Tiles;
+
+	// The templates of the tiles, owned by the tiles so the worker thread never shares a registry with the game thread.
+	TSharedRef<FTileTemplateRegistry> TileTemplates = MakeShared<FTileTemplateRegistry>();
+
+	/** Adds the tile, registering its template in TileTemplates. */
+	void Add(const FIntVector& Coordinate, const FTileData& TileData);
+
+	/** Returns true if there are no tiles. */
+	bool IsEmpty() const { return Tiles.IsEmpty(); }
+};
+
+/** Called on the game thread once a level generation task has finished or been cancelled. */
+DECLARE_DELEGATE_OneParam(FOnLevelGenerationTaskComplete, TSharedRef<FLevelGenerationTask>);
+
+/** Called on the game thread with tiles of a level that is still being generated. */
+DECLARE_DELEGATE_TwoParams(FOnLevelGenerationTilesReady, TSharedRef<FLevelGenerationTask>, const FLevelGenerationTiles&);
+
+/**
+ * Generates a level on a worker thread.
+ * The seed, the special path data and the compiled settings are prepared on the game thread, then the rooms and corridors are generated on the thread pool from the task's own copy of the settings.
+ * Nothing outside the task touches its settings or level data until it is done, tiles handed out early are copies.
+ * The data tables the settings reference are kept from being garbage collected for as long as the task is alive, even if whoever started it is gone.
+ */
+class PROJECTSCIFI_API FLevelGenerationTask : public TSharedFromThis<FLevelGenerationTask>, public FGCObject
+{
+public:
+
+	FLevelGenerationTask(const FLevelGenerationSettings& InLevelGenerationSettings);
+
+	//~ Begin FGCObject Interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FLevelGenerationTask"); }
+	//~ End FGCObject Interface
+
+	/** Prepares the generation and starts it on the thread pool, OnComplete is called on the game thread when it is done. Must be called on the game thread. */
+	void Start(FOnLevelGenerationTaskComplete InOnComplete);
+
+	/// <summary>
+	/// Hands tiles to the game thread as soon as they are final enough to stream in. Must be called before Start.
+	/// </summary>
+	/// <param name="InOnRoomsReady"> Called once with every room, as soon as the rooms are placed. </param>
+	/// <param name="InOnCorridorsReady"> Called each time a corridor is added with the normal corridor tiles it added or changed, special corridors are only known once the task is done. </param>
+	void SetOnTilesReady(FOnLevelGenerationTilesReady InOnRoomsReady, FOnLevelGenerationTilesReady InOnCorridorsReady);
+
+	/** Sets the priority of the generation in the thread pool, lower priorities let other work run first. Must be called before Start. */
+	void SetWorkPriority(EQueuedWorkPriority InWorkPriority);
+
+	/** Runs the generation on the background thread pool, whose threads run at the lowest priority so the game's threads are scheduled ahead of it. Must be called before Start. */
+	void SetUseBackgroundThreadPool(bool bInUseBackgroundThreadPool);
+
+	/** Asks the generation to stop before its next room or within a few A* Pathfinding nodes, OnComplete is still called. */
+	void Cancel() { Progress->Cancel(); }
+
+	/** Returns how much of the generation has finished, from 0 to 1. */
+	float GetProgress() const { return Progress->GetProgress(); }
+
+	/** Returns the stage the generation is in. */
+	ELevelGenerationStage GetStage() const { return Progress->GetStage(); }
+
+	/** Returns true once the generation has finished or been cancelled and OnComplete has been called. */
+	bool IsDone() const { return bIsDone; }
+
+	/** Returns true if the whole level was generated. */
+	bool IsCompleted() const { return bIsDone && GetStage() == ELevelGenerationStage::Finished; }
+
+	/** Returns the future of the generation, set to true if the whole level was generated. */
+	const TFuture<bool>& GetFuture() const { return Future; }
+
+	/** Returns the settings the level is generated from. */
+	const FLevelGenerationSettings& GetLevelGenerationSettings() const { return LevelGenerationSettings; }
+
+	/** Moves the generated level out of the task. Only valid once the task is completed. */
+	FGeneratedLevelData TakeGeneratedLevelData();
+
+protected:
+
+	/** Called on the game thread when the worker thread is done. */
+	void Finish();
+
+	/** Gathers every data table and asset the settings reference into ReferencedObjects. Must be called on the game thread. */
+	void CollectReferencedObjects();
+
+	/** Called on the worker thread, copies the tiles over to the game thread and calls TilesReady with them there. */
+	void SendTilesToGameThread(const FOnLevelGenerationTilesReady& TilesReady, FLevelGenerationTiles&& Tiles);
+
+	// The task's own copy of the settings, never changed once the generation has started.
+	FLevelGenerationSettings LevelGenerationSettings;
+
+	// The level being generated.
+	FGeneratedLevelData GeneratedLevelData;
+
+	// The data tables and assets the settings reference, reported to the garbage collector while the task is alive.
+	TArray<TObjectPtr<UObject>> ReferencedObjects;
+
+	// Progress of the generation, shared with the level data while it is being generated.
+	TSharedRef<FLevelGenerationProgress> Progress;
+
+	// Priority of the generation in the thread pool.
+	EQueuedWorkPriority WorkPriority = EQueuedWorkPriority::Normal;
+
+	// True to run the generation on GBackgroundPriorityThreadPool instead of GThreadPool.
+	bool bUseBackgroundThreadPool = false;
+
+	// Future of the generation running on the thread pool.
+	TFuture<bool> Future;
+
+	// Called on the game thread when the task is done.
+	FOnLevelGenerationTaskComplete OnComplete;
+
+	// Called on the game thread once the rooms are placed.
+	FOnLevelGenerationTilesReady OnRoomsReady;
+
+	// Called on the game thread each time a corridor is added.
+	FOnLevelGenerationTilesReady OnCorridorsReady;
+
+	// True once the generation has finished or been cancelled.
+	bool bIsDone = false;
+};
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+enum class ETileType : uint8;
+
+/** The trace channel of the level generation, enabled with -trace=cpu,LevelGeneration or "Trace.Enable LevelGeneration" so its scopes and events show in Unreal Insights. */
+UE_TRACE_CHANNEL_EXTERN(LevelGenerationChannel, PROJECTSCIFI_API);
+
+#if CPUPROFILERTRACE_ENABLED
+// Times the enclosing scope on the level generation trace channel.
+#define LEVEL_GENERATION_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, LevelGenerationChannel)
+#else
+#define LEVEL_GENERATION_TRACE_SCOPE(Name)
+#endif
+
+/** Writes the custom level generation events to the trace, so a capture shows which seed, room or corridor a slow scope belongs to. */
+struct PROJECTSCIFI_API FLevelGenerationTrace
+{
+public:
+
+	/** Returns true if the level generation trace channel is enabled. */
+	static bool IsEnabled();
+
+	/** Records the start of a level generation, and adds a bookmark with its seed to the timeline. */
+	static void OutputGenerationStart(int32 Seed, const FIntVector& GridSize);
+
+	/** Records a room placement, with the number of placements tested before it was placed or given up on. */
+	static void OutputRoomPlacement(int32 Seed, ETileType RoomType, int32 PlacementsTested, bool bPlaced);
+
+	/** Records a corridor once it has been built or given up on, with the A* Pathfinding nodes expanded over every access point tried. */
+	static void OutputCorridorEdge(int32 Seed, int32 EdgeIndex, const FIntVector& Origin, const FIntVector& Destination, int32 PathExpansions, int32 AccessPointsTried, bool bPathFound);
+};
@@ -0,0 +1,219 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LevelTileStorage.generated.h"
+
+/** Handles of the tile, section and path at a coordinate of the level grid. */
+struct FLevelGridCell
+{
+	// The element index of the tile in LevelTileData, or of the section in LevelSectionData if the lowest bit is set. INDEX_NONE if the coordinate has neither.
+	int32 TileHandle = INDEX_NONE;
+
+	// The element index of the path in LevelPathData, INDEX_NONE if the coordinate has no path.
+	int32 PathHandle = INDEX_NONE;
+
+	bool IsEmpty() const { return TileHandle == INDEX_NONE && PathHandle == INDEX_NONE; }
+
+	static int32 MakeTileHandle(int32 ElementIndex) { return ElementIndex << 1; }
+	static int32 MakeSectionHandle(int32 ElementIndex) { return (ElementIndex << 1) | 1; }
+
+	bool HasTile() const { return TileHandle != INDEX_NONE && (TileHandle & 1) == 0; }
+	bool HasSection() const { return TileHandle != INDEX_NONE && (TileHandle & 1) != 0; }
+	int32 GetElementIndex() const { return TileHandle >> 1; }
+};
+
+/**
+ * Dense index of the level grid split into 8x8x8 chunks that are only allocated once a cell inside them is used.
+ * Cells are found with a couple of array lookups instead of a hash probe, and the cells of each chunk are stored in Morton order so neighbouring coordinates share cache lines.
+ * Coordinates outside the level grid are kept in a small overflow map.
+ */
+struct PROJECTSCIFI_API FChunkedTileGrid
+{
+public:
+
+	static constexpr int32 ChunkBits = 3;
+	static constexpr int32 ChunkSize = 1 << ChunkBits;
+	static constexpr int32 CellsPerChunk = ChunkSize * ChunkSize * ChunkSize;
+
+	/** Removes every cell and sizes the chunk table for the level grid. */
+	void Initialize(const FIntVector& InGridSize);
+
+	/** Returns true if the grid has been built for a level grid of this size. */
+	bool IsInitializedFor(const FIntVector& InGridSize) const { return bIsInitialized && GridSize == InGridSize; }
+
+	bool IsInitialized() const { return bIsInitialized; }
+
+	/** Returns the cell at the coordinate, or null if nothing has been stored there. */
+	const FLevelGridCell* FindCell(const FIntVector& Coordinate) const;
+
+	/** Returns the cell at the coordinate, allocating its chunk if needed. */
+	FLevelGridCell& FindOrAddCell(const FIntVector& Coordinate);
+
+	/** Calls the function with the coordinate and cell of every non-empty cell, chunk by chunk in Morton order, then the cells outside the level grid. */
+	template<typename FunctionType>
+	void ForEachCell(FunctionType Function) const
+	{
+		for (int32 ChunkIndex = 0; ChunkIndex < ChunkOrigins.Num(); ChunkIndex++)
+		{
+			const FLevelGridCell* ChunkCells = &Cells[ChunkIndex * CellsPerChunk];
+
+			for (int32 MortonIndex = 0; MortonIndex < CellsPerChunk; MortonIndex++)
+			{
+				if (ChunkCells[MortonIndex].IsEmpty()) { continue; }
+
+				Function(ChunkOrigins[ChunkIndex] + GetLocalCoordinate(MortonIndex), ChunkCells[MortonIndex]);
+			}
+		}
+
+		for (const TPair<FIntVector, FLevelGridCell>& CurrentCell : OverflowCells)
+		{
+			if (!CurrentCell.Value.IsEmpty()) { Function(CurrentCell.Key, CurrentCell.Value); }
+		}
+	}
+
+	/** Returns the number of chunks that have been allocated. */
+	int32 GetAllocatedChunkCount() const { return ChunkOrigins.Num(); }
+
+protected:
+
+	/** Returns the slot of the chunk containing the coordinate in ChunkSlots, or INDEX_NONE if the coordinate is outside the level grid. */
+	int32 GetChunkSlot(const FIntVector& Coordinate) const;
+
+	/** Returns the Morton index of the coordinate inside its chunk. */
+	static int32 GetLocalMortonIndex(const FIntVector& Coordinate);
+
+	/** Returns the coordinate inside a chunk of the Morton index. */
+	static FIntVector GetLocalCoordinate(int32 MortonIndex);
+
+	// The size of the level grid the chunk table was built for.
+	FIntVector GridSize = FIntVector::ZeroValue;
+
+	// The number of chunks along each axis of the level grid.
+	FIntVector ChunkCount = FIntVector::ZeroValue;
+
+	// The index of the chunk allocated for each slot of the chunk table, INDEX_NONE if the chunk has not been allocated.
+	TArray<int32> ChunkSlots;
+
+	// The grid coordinate of the first cell of each allocated chunk.
+	TArray<FIntVector> ChunkOrigins;
+
+	// The cells of every allocated chunk, CellsPerChunk cells per chunk.
+	TArray<FLevelGridCell> Cells;
+
+	// The cells of coordinates outside the level grid.
+	TMap<FIntVector, FLevelGridCell> OverflowCells;
+
+	bool bIsInitialized = false;
+};
+
+/**
+ * Sparse index of the level grid for large levels with few tiles, stored in an open-addressing hash table keyed by the 64-bit Morton code of each coordinate.
+ * The slot of a cell keeps the low bits of its Morton code, so neighbouring coordinates land in neighbouring slots.
+ */
+struct PROJECTSCIFI_API FMortonTileHash
+{
+public:
+
+	/** Removes every cell and reserves room for the expected number of cells. */
+	void Initialize(int32 ExpectedCells = 0);
+
+	/** Returns the cell at the coordinate, or null if nothing has been stored there. */
+	const FLevelGridCell* FindCell(const FIntVector& Coordinate) const;
+
+	/** Returns the cell at the coordinate, adding it if needed. */
+	FLevelGridCell& FindOrAddCell(const FIntVector& Coordinate);
+
+	/** Calls the function with the coordinate and cell of every non-empty cell, in slot order. */
+	template<typename FunctionType>
+	void ForEachCell(FunctionType Function) const
+	{
+		for (int32 Slot = 0; Slot < Keys.Num(); Slot++)
+		{
+			if (Keys[Slot] == EmptyKey || Values[Slot].IsEmpty()) { continue; }
+
+			Function(GetCoordinate(Keys[Slot]), Values[Slot]);
+		}
+	}
+
+	/** Returns the number of cells stored. */
+	int32 Num() const { return CellCount; }
+
+	/** Returns the Morton code of the coordinate, each axis must be within 2^20 of the origin. */
+	static uint64 GetMortonCode(const FIntVector& Coordinate);
+
+	/** Returns the coordinate of the Morton code. */
+	static FIntVector GetCoordinate(uint64 MortonCode);
+
+protected:
+
+	/** Returns the slot holding the Morton code, or the empty slot it would be added to. */
+	int32 FindSlot(uint64 MortonCode) const;
+
+	/** Doubles the number of slots and re-adds every cell. */
+	void Grow();
+
+	// Marks a slot that has no cell, no coordinate has this Morton code.
+	static constexpr uint64 EmptyKey = ~uint64(0);
+
+	// The Morton code of the cell in each slot.
+	TArray<uint64> Keys;
+
+	// The cell in each slot.
+	TArray<FLevelGridCell> Values;
+
+	int32 CellCount = 0;
+};
+
+UENUM(BlueprintType, meta = (DisplayName = "Tile Storage Type"))
+enum class ETileStorageType : uint8
+{
+	ChunkedGrid		UMETA(DisplayName = "Chunked Grid"),
+	MortonHash		UMETA(DisplayName = "Sparse Morton Hash"),
+
+	MAX				UMETA(Hidden)
+};
+
+/** Index of the tiles, sections and paths at each coordinate of the level grid, stored in the container chosen by the level generation settings. */
+struct PROJECTSCIFI_API FLevelTileIndex
+{
+public:
+
+	/** Removes every cell and sets up the chosen container for the level grid. */
+	void Initialize(const FIntVector& InGridSize, ETileStorageType InStorageType);
+
+	bool IsInitialized() const { return bIsInitialized; }
+
+	ETileStorageType GetStorageType() const { return StorageType; }
+
+	/** Returns the cell at the coordinate, or null if nothing has been stored there. */
+	const FLevelGridCell* FindCell(const FIntVector& Coordinate) const
+	{
+		return StorageType == ETileStorageType::MortonHash ? MortonHash.FindCell(Coordinate) : ChunkedGrid.FindCell(Coordinate);
+	}
+
+	/** Returns the cell at the coordinate, adding it if needed. */
+	FLevelGridCell& FindOrAddCell(const FIntVector& Coordinate)
+	{
+		return StorageType == ETileStorageType::MortonHash ? MortonHash.FindOrAddCell(Coordinate) : ChunkedGrid.FindOrAddCell(Coordinate);
+	}
+
+	/** Calls the function with the coordinate and cell of every non-empty cell. */
+	template<typename FunctionType>
+	void ForEachCell(FunctionType Function) const
+	{
+		if (StorageType == ETileStorageType::MortonHash) { MortonHash.ForEachCell(Function); }
+		else { ChunkedGrid.ForEachCell(Function); }
+	}
+
+protected:
+
+	ETileStorageType StorageType = ETileStorageType::ChunkedGrid;
+
+	FChunkedTileGrid ChunkedGrid;
+
+	FMortonTileHash MortonHash;
+
+	bool bIsInitialized = false;
+};
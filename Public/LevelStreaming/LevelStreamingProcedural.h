@@ -51,7 +51,15 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FOnElevatorTopLoadedDelegate OnElevatorTopLoaded;
 
-	FTileData LevelTileData;
+	/** The tile this level is an instance of, its shared data is read from TileTemplates. */
+	FTileInstanceData LevelTileInstance;
+
+	/** The template registry of the generation that placed this level. */
+	TSharedPtr<const FTileTemplateRegistry> TileTemplates;
+
+	/** Expands the tile this level is an instance of into full tile data. */
+	FTileData GetLevelTileData() const;
+
 	FElevatorBottomInfo ElevatorBottomInfo;
 	FElevatorTopInfo ElevatorTopInfo;
 
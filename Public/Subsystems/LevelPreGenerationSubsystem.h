@@ -0,0 +1,148 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Data/LevelGenerationTask.h"
+#include "UObject/UObjectGlobals.h"
+#include "LevelPreGenerationSubsystem.generated.h"
+
+/** A level generated in the background, waiting to be played. */
+struct FPreGeneratedLevel
+{
+
+public:
+
+	// The seed the level was generated from.
+	int32 Seed = 0;
+
+	// The hash of the settings the level was generated from, including the seed.
+	uint32 SettingsHash = 0;
+
+	// The generated level.
+	FGeneratedLevelData GeneratedLevelData;
+
+	// Estimate of the memory used by the generated level, in bytes.
+	SIZE_T AllocatedSize = 0;
+
+	// The maps of the tiles in the level, loaded in the background while the level waits.
+	TSet<FName> PackageNames;
+
+};
+
+/**
+ * Generates the levels that follow the one being played in the background, one at a time on the lowest priority threads, so the next level does not have to be generated when the player gets to it.
+ * Generated levels and the maps loaded for them are kept in memory up to the memory budget of their settings, levels that do not fit are written to the layout cache if it is enabled.
+ * The maps of the generated levels are loaded in the background as well, so streaming them in later is quicker.
+ */
+UCLASS()
+class PROJECTSCIFI_API ULevelPreGenerationSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/// <summary>
+	/// Queues the levels for the seeds to be generated in the background. Seeds that are already generated, queued or in the layout cache are skipped.
+	/// Levels generated or queued for other settings or for seeds that are no longer requested are removed, so they do not take up the memory budget.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings the levels are generated from, the seed is replaced with each of the seeds. </param>
+	/// <param name="Seeds"> The seeds of the levels to generate, in the order they are generated. </param>
+	UFUNCTION(BlueprintCallable, Category = "Level Generation|Pre-Generation")
+	void PreGenerateLevels(const FLevelGenerationSettings& LevelGenerationSettings, const TArray<int32>& Seeds);
+
+	/** Queues the levels for the seeds following LevelUserSeed, PreGeneratedLevelCount of them. */
+	UFUNCTION(BlueprintCallable, Category = "Level Generation|Pre-Generation")
+	void PreGenerateNextLevels(const FLevelGenerationSettings& LevelGenerationSettings);
+
+	/// <summary>
+	/// Moves the level generated in the background for the settings out of the subsystem.
+	/// </summary>
+	/// <param name="LevelGenerationSettings"> The settings of the level, only levels generated from the same settings and seed are returned. </param>
+	/// <param name="GeneratedLevelData"> Returned level data, only changed if a level was found. </param>
+	/// <returns> True if the level had been generated. </returns>
+	bool TakePreGeneratedLevel(const FLevelGenerationSettings& LevelGenerationSettings, FGeneratedLevelData& GeneratedLevelData);
+
+	/** Returns true if the level for the seed has been generated and is waiting to be played. */
+	UFUNCTION(BlueprintPure, Category = "Level Generation|Pre-Generation")
+	bool IsLevelPreGenerated(int32 Seed) const;
+
+	/** Returns true while a level is being generated in the background. */
+	UFUNCTION(BlueprintPure, Category = "Level Generation|Pre-Generation")
+	bool IsPreGenerating() const { return PreGenerationTask.IsValid(); }
+
+	/** Cancels the level being generated and every queued level, the levels already generated are kept. */
+	UFUNCTION(BlueprintCallable, Category = "Level Generation|Pre-Generation")
+	void CancelPreGeneration();
+
+	/** Removes every level generated in the background and releases the maps loaded for them. */
+	UFUNCTION(BlueprintCallable, Category = "Level Generation|Pre-Generation")
+	void ClearPreGeneratedLevels();
+
+protected:
+
+	/** Starts generating the next queued level if nothing is being generated. */
+	void StartNextPreGeneration();
+
+	/** Called on the game thread when a level has been generated in the background. */
+	void OnPreGenerationComplete(TSharedRef<FLevelGenerationTask> CompletedTask);
+
+	/** Starts loading the maps of every tile in the level in the background, recording them in the level. */
+	void PrewarmLevelPackages(FPreGeneratedLevel& PreGeneratedLevel);
+
+	/** Called when a map of a generated level has been loaded in the background. */
+	void OnPackagePrewarmed(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+
+	/** Removes the generated level at the index and releases the maps no other generated level uses. */
+	void RemovePreGeneratedLevel(int32 LevelIndex);
+
+	/** Releases the maps, loaded or loading, that are not used by any of the generated levels. */
+	void ReleaseUnusedPackages();
+
+	/** Returns the memory used by the generated levels and the maps loaded for them, in bytes. */
+	SIZE_T GetUsedMemory() const { return PreGeneratedMemory + PrewarmedMemory; }
+
+	/** Returns an estimate of the memory used by the objects in the package, in bytes. */
+	static SIZE_T GetPackageSize(UPackage* Package);
+
+	/** Returns the settings with the seed set as the predefined seed. */
+	static FLevelGenerationSettings MakeSeededSettings(const FLevelGenerationSettings& LevelGenerationSettings, int32 Seed);
+
+	/** Returns the memory budget of the settings in bytes. */
+	static SIZE_T GetMemoryBudget(const FLevelGenerationSettings& LevelGenerationSettings);
+
+protected:
+
+	// The settings of the queued levels, without their seeds. A property so the data tables they reference are not garbage collected.
+	UPROPERTY()
+	FLevelGenerationSettings PreGenerationSettings;
+
+	// The seeds of the levels waiting to be generated, in order.
+	TArray<int32> PendingSeeds;
+
+	// The task generating a level in the background, only valid while it is running.
+	TSharedPtr<FLevelGenerationTask> PreGenerationTask;
+
+	// The levels generated in the background waiting to be played.
+	TArray<FPreGeneratedLevel> PreGeneratedLevels;
+
+	// Estimate of the memory used by PreGeneratedLevels, in bytes.
+	SIZE_T PreGeneratedMemory = 0;
+
+	// The maps of the generated levels that are still loading in the background.
+	TSet<FName> PendingPrewarmPackages;
+
+	// The maps of the generated levels loaded in the background, kept loaded until no generated level uses them.
+	UPROPERTY()
+	TArray<UPackage*> PrewarmedPackages;
+
+	// Estimate of the memory used by each of PrewarmedPackages, in bytes.
+	TMap<FName, SIZE_T> PrewarmedPackageSizes;
+
+	// Estimate of the memory used by PrewarmedPackages, in bytes.
+	SIZE_T PrewarmedMemory = 0;
+
+};